@@ -0,0 +1,225 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+// Project
+#include "pid.h"
+
+/**
+ * リレー帰還によるPIDゲインの自動調整
+ * @details
+ * 目標値との誤差の符号で操作量を bias ± amplitude に切り替えると、ループは限界周期で自励振動する。
+ * 振動の振幅 a と周期 Pu から、記述関数で限界ゲイン Ku = 4 d / (π sqrt(a^2 - ε^2)) を求め、
+ * 調整則でゲインに換算する (εはリレーのヒステリシス幅)。
+ * 参考:
+ * K. J. Åström, T. Hägglund, "Automatic tuning of simple regulators with specifications on phase and amplitude
+ * margins", Automatica, 1984
+ */
+namespace autotune {
+// 調整則
+enum class Rule : uint8_t {
+  // Ziegler-Nichols (応答が速く、行き過ぎが大きい)
+  ZieglerNicholsPi,
+  ZieglerNicholsPid,
+  // Tyreus-Luyben (行き過ぎが小さく、外乱に強い)
+  TyreusLuybenPi,
+  TyreusLuybenPid,
+};
+
+// 実験の設定
+struct Config {
+  // 目標値
+  float setpoint;
+  // 操作量の中心 (目標値を保つ程度の値、振動が対称になるよう実験中に補正する)
+  float bias;
+  // リレーの振幅
+  float amplitude;
+  // リレーのヒステリシス幅 (雑音で切り替わらない程度)
+  float hysteresis;
+  // 読み捨てる周期の数 (目標値に近づき、振幅が落ち着くまで)
+  uint32_t settle_cycles;
+  // 平均する周期の数
+  uint32_t measure_cycles;
+  // 打ち切る時間 [s]
+  float timeout;
+};
+
+// 実験の結果
+struct Result {
+  // 限界ゲイン
+  float ultimate_gain;
+  // 限界周期 [s]
+  float ultimate_period;
+  // 振動の振幅
+  float amplitude;
+  // 振動が測れたかどうか
+  bool valid;
+};
+
+/**
+ * @brief リレー帰還の実験 (制御周期ごとにupdate()を呼ぶ)
+ */
+class RelayTuner {
+ public:
+  explicit RelayTuner() : config_(), result_(), bias_(0.0f), high_(true), finished_(true) {
+    start(config_);
+    finished_ = true;
+  }
+  ~RelayTuner() = default;
+
+  void start(const Config &config) {
+    config_ = config;
+    result_ = {};
+    bias_ = config.bias;
+    high_ = true;
+    finished_ = false;
+    time_ = 0.0f;
+    switched_ = 0.0f;
+    rising_ = -1.0f;
+    high_time_ = 0.0f;
+    cycles_ = 0;
+    max_ = -INFINITY;
+    min_ = INFINITY;
+    sum_period_ = 0.0f;
+    sum_amplitude_ = 0.0f;
+  }
+
+  /**
+   * @param measurement 計測値
+   * @param dt 制御周期 [s]
+   * @return 操作量
+   */
+  float update(float measurement, float dt) {
+    if (finished_) return bias_;
+    time_ += dt;
+    if (time_ > config_.timeout) {
+      finished_ = true;
+      return bias_;
+    }
+    max_ = std::max(max_, measurement);
+    min_ = std::min(min_, measurement);
+
+    auto error = config_.setpoint - measurement;
+    if (high_ && error < -config_.hysteresis) {
+      // 上側の区間が終わった
+      high_ = false;
+      high_time_ = time_ - switched_;
+      switched_ = time_;
+    } else if (!high_ && error > config_.hysteresis) {
+      high_ = true;
+      switched_ = time_;
+      cycle();
+    }
+    return high_ ? bias_ + config_.amplitude : bias_ - config_.amplitude;
+  }
+
+  [[nodiscard]] bool finished() const { return finished_; }
+  [[nodiscard]] const Result &result() const { return result_; }
+  [[nodiscard]] const Config &config() const { return config_; }
+  // 補正後の操作量の中心
+  [[nodiscard]] float bias() const { return bias_; }
+
+  /**
+   * @brief 限界ゲイン・限界周期からゲインを求める
+   * @details
+   * | 調整則             | kp        | Ti        | Td       |
+   * | ZN PI              | 0.45 Ku   | Pu / 1.2  |          |
+   * | ZN PID             | 0.6 Ku    | Pu / 2    | Pu / 8   |
+   * | TL PI              | Ku / 3.2  | 2.2 Pu    |          |
+   * | TL PID             | Ku / 2.2  | 2.2 Pu    | Pu / 6.3 |
+   * ki = kp / Ti, kd = kp Td
+   */
+  [[nodiscard]] static constexpr PidGain<float> gain(const Result &result, Rule rule) {
+    auto ku = result.ultimate_gain;
+    auto pu = result.ultimate_period;
+    float kp = 0.0f, ti = 1.0f, td = 0.0f;
+    switch (rule) {
+      case Rule::ZieglerNicholsPi:
+        kp = 0.45f * ku;
+        ti = pu / 1.2f;
+        break;
+      case Rule::ZieglerNicholsPid:
+        kp = 0.6f * ku;
+        ti = pu / 2.0f;
+        td = pu / 8.0f;
+        break;
+      case Rule::TyreusLuybenPi:
+        kp = ku / 3.2f;
+        ti = 2.2f * pu;
+        break;
+      case Rule::TyreusLuybenPid:
+        kp = ku / 2.2f;
+        ti = 2.2f * pu;
+        td = pu / 6.3f;
+        break;
+    }
+    return {kp, kp / ti, kp * td};
+  }
+
+ private:
+  //! 設定
+  Config config_;
+  //! 結果
+  Result result_;
+  //! 操作量の中心
+  float bias_;
+  //! リレーが上側かどうか
+  bool high_;
+  //! 終わったかどうか
+  bool finished_;
+  //! 経過時間 [s]
+  float time_;
+  //! 最後に切り替えた時刻 [s]
+  float switched_;
+  //! 前回上側に切り替えた時刻 [s] (まだなければ負)
+  float rising_;
+  //! 直前の上側の区間の長さ [s]
+  float high_time_;
+  //! 数えた周期の数
+  uint32_t cycles_;
+  //! 周期内の最大・最小値
+  float max_, min_;
+  //! 測った周期・振幅の合計
+  float sum_period_, sum_amplitude_;
+
+  // 上側に切り替えた (1周期が終わった)
+  void cycle() {
+    if (rising_ < 0.0f) {
+      // 最初の切り替えは目標値に近づいただけなので数えない
+      rising_ = time_;
+      max_ = -INFINITY;
+      min_ = INFINITY;
+      return;
+    }
+    auto period = time_ - rising_;
+    auto amplitude = (max_ - min_) / 2.0f;
+    rising_ = time_;
+    max_ = -INFINITY;
+    min_ = INFINITY;
+    cycles_++;
+
+    if (cycles_ <= config_.settle_cycles) {
+      // 上下の区間の長さが等しくなるよう中心を動かす (上側が長ければ中心が低すぎる)
+      if (period > 0.0f) bias_ += config_.amplitude * (2.0f * high_time_ - period) / period / 2.0f;
+      return;
+    }
+    sum_period_ += period;
+    sum_amplitude_ += amplitude;
+    if (cycles_ < config_.settle_cycles + config_.measure_cycles) return;
+
+    auto count = static_cast<float>(config_.measure_cycles);
+    auto a = sum_amplitude_ / count;
+    auto h = config_.hysteresis;
+    finished_ = true;
+    if (a <= h) return;
+    result_.amplitude = a;
+    result_.ultimate_period = sum_period_ / count;
+    result_.ultimate_gain = 4.0f * config_.amplitude / (std::numbers::pi_v<float> * std::sqrt(a * a - h * h));
+    result_.valid = true;
+  }
+};
+}  // namespace autotune
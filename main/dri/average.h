@@ -1,5 +1,9 @@
 #pragma once
 
+// C++
+#include <concepts>
+
+// Project
 #include "ringbuffer.h"
 
 namespace data {
@@ -45,4 +49,119 @@ class MovingAverage {
     return sums_ / static_cast<U>(N);
   }
 };
-}  // namespace data
\ No newline at end of file
+
+/**
+ * @brief 逐次的に平均と分散を計算する (Welfordのアルゴリズム)
+ * @details 2乗和を保持しないため、floatでも桁落ちしにくい。
+ */
+template <std::floating_point T>
+class Welford {
+ private:
+  // サンプル数
+  std::size_t count_;
+  // 平均
+  T mean_;
+  // 平均との差の2乗和
+  T m2_;
+
+ public:
+  explicit Welford() { reset(); }
+  ~Welford() = default;
+
+  void reset() {
+    count_ = 0;
+    mean_ = static_cast<T>(0);
+    m2_ = static_cast<T>(0);
+  }
+
+  void update(T sample) {
+    count_++;
+    const T delta = sample - mean_;
+    mean_ += delta / static_cast<T>(count_);
+    m2_ += delta * (sample - mean_);
+  }
+
+  [[nodiscard]] std::size_t count() const { return count_; }
+  [[nodiscard]] T mean() const { return mean_; }
+  // 不偏分散
+  [[nodiscard]] T variance() const { return count_ > 1 ? m2_ / static_cast<T>(count_ - 1) : static_cast<T>(0); }
+};
+
+/**
+ * @brief 逐次的に直線近似 y = a x + b を求める (Welfordのアルゴリズムを共分散に広げたもの)
+ * @details 平均回りの2乗和・積和を保持するため、xの範囲が平均に比べて狭くてもfloatで桁落ちしにくい。
+ */
+template <std::floating_point T>
+class LinearRegression {
+ private:
+  // サンプル数
+  std::size_t count_;
+  // 平均
+  T mean_x_, mean_y_;
+  // xの平均との差の2乗和
+  T m2_x_;
+  // 平均との差の積和
+  T c_xy_;
+
+ public:
+  explicit LinearRegression() { reset(); }
+  ~LinearRegression() = default;
+
+  void reset() {
+    count_ = 0;
+    mean_x_ = static_cast<T>(0);
+    mean_y_ = static_cast<T>(0);
+    m2_x_ = static_cast<T>(0);
+    c_xy_ = static_cast<T>(0);
+  }
+
+  void update(T x, T y) {
+    count_++;
+    const T delta_x = x - mean_x_;
+    mean_x_ += delta_x / static_cast<T>(count_);
+    mean_y_ += (y - mean_y_) / static_cast<T>(count_);
+    m2_x_ += delta_x * (x - mean_x_);
+    c_xy_ += delta_x * (y - mean_y_);
+  }
+
+  [[nodiscard]] std::size_t count() const { return count_; }
+  [[nodiscard]] T mean_x() const { return mean_x_; }
+  [[nodiscard]] T mean_y() const { return mean_y_; }
+  // 傾き (xが変化しない場合は0)
+  [[nodiscard]] T slope() const { return m2_x_ > static_cast<T>(0) ? c_xy_ / m2_x_ : static_cast<T>(0); }
+  // x = 0での値
+  [[nodiscard]] T intercept() const { return mean_y_ - slope() * mean_x_; }
+};
+
+/**
+ * @brief 補償付きで積算する (Kahanの加算)
+ * @details 積算値に比べて小さい値を足し続けても、丸めで落ちた分を次の加算で補う。
+ */
+template <std::floating_point T>
+class KahanSum {
+ private:
+  // 積算値
+  T sum_;
+  // 丸めで落ちた値
+  T compensation_;
+
+ public:
+  explicit KahanSum() { reset(); }
+  ~KahanSum() = default;
+
+  void reset(T value = static_cast<T>(0)) {
+    sum_ = value;
+    compensation_ = static_cast<T>(0);
+  }
+
+  T update(T value) {
+    const T y = value - compensation_;
+    const T t = sum_ + y;
+    compensation_ = (t - sum_) - y;
+    sum_ = t;
+    return sum_;
+  }
+
+  [[nodiscard]] T value() const { return sum_; }
+};
+}  // namespace data
@@ -0,0 +1,138 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace data {
+/**
+ * @brief COBS (Consistent Overhead Byte Stuffing) で符号化した後の最大長
+ * @details 区切りの0x00は含まない
+ */
+constexpr std::size_t cobs_max_encoded_size(std::size_t size) { return size + size / 254 + 1; }
+
+/**
+ * @brief COBSで符号化する (0x00を含まないバイト列にする)
+ * @param src 符号化するデータ
+ * @param size データの長さ
+ * @param dst 出力先 (cobs_max_encoded_size(size)以上)
+ * @return 符号化後の長さ (区切りの0x00は含まない)
+ */
+inline std::size_t cobs_encode(const uint8_t *src, std::size_t size, uint8_t *dst) {
+  std::size_t code_index = 0;
+  std::size_t index = 1;
+  uint8_t code = 1;
+  for (std::size_t i = 0; i < size; i++) {
+    if (src[i] != 0) {
+      dst[index++] = src[i];
+      code++;
+    }
+    if (src[i] == 0 || code == 0xFF) {
+      dst[code_index] = code;
+      code = 1;
+      code_index = index;
+      // 最後が254バイトのブロックで終わる場合は次の符号を置かない
+      if (src[i] == 0 || i + 1 < size) {
+        index++;
+      }
+    }
+  }
+  dst[code_index] = code;
+  return index;
+}
+
+/**
+ * @brief COBSを復号する
+ * @param src 符号化されたデータ (区切りの0x00は含まない)
+ * @param size データの長さ
+ * @param dst 出力先 (size以上)
+ * @return 復号後の長さ (不正なデータの場合は0)
+ */
+inline std::size_t cobs_decode(const uint8_t *src, std::size_t size, uint8_t *dst) {
+  std::size_t index = 0;
+  std::size_t length = 0;
+  while (index < size) {
+    auto code = src[index++];
+    if (code == 0 || index + code - 1 > size) return 0;
+    for (uint8_t i = 1; i < code; i++) {
+      dst[length++] = src[index++];
+    }
+    if (code != 0xFF && index < size) {
+      dst[length++] = 0;
+    }
+  }
+  return length;
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE
+ */
+constexpr uint16_t crc16(const uint8_t *data, std::size_t size, uint16_t crc = 0xFFFF) {
+  for (std::size_t i = 0; i < size; i++) {
+    crc ^= static_cast<uint16_t>(data[i] << 8);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) != 0 ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief 0x00区切りのCOBSフレームをバイト単位で受け取って復号する
+ * @tparam N 復号後の最大長
+ */
+template <std::size_t N>
+class CobsReader {
+ public:
+  explicit CobsReader() : size_(0), overflow_(false), errors_(0) {}
+  ~CobsReader() = default;
+
+  void reset() {
+    size_ = 0;
+    overflow_ = false;
+  }
+
+  /**
+   * @brief 1バイト受け取る
+   * @return フレームを復号できた場合はその長さ、それ以外は0
+   */
+  std::size_t update(uint8_t byte) {
+    if (byte != 0) {
+      if (size_ < encoded_.size()) {
+        encoded_[size_++] = byte;
+      } else {
+        overflow_ = true;
+      }
+      return 0;
+    }
+    // 区切り
+    std::size_t length = 0;
+    if (!overflow_ && size_ > 0) {
+      length = cobs_decode(encoded_.data(), size_, decoded_.data());
+    }
+    if (length == 0 && (overflow_ || size_ > 0)) {
+      errors_++;
+    }
+    reset();
+    return length;
+  }
+
+  // 復号したフレーム
+  [[nodiscard]] const uint8_t *data() const { return decoded_.data(); }
+  // 復号できなかったフレームの数
+  [[nodiscard]] uint32_t errors() const { return errors_; }
+
+ private:
+  //! 受け取り中のデータ
+  std::array<uint8_t, cobs_max_encoded_size(N)> encoded_;
+  //! 復号したデータ
+  std::array<uint8_t, cobs_max_encoded_size(N)> decoded_;
+  //! 受け取り中のデータの長さ
+  std::size_t size_;
+  //! 受け取り中のデータが長すぎる
+  bool overflow_;
+  //! 復号できなかったフレームの数
+  uint32_t errors_;
+};
+}  // namespace data
@@ -1,7 +1,9 @@
 #pragma once
 
 // ESP-IDF
+#include <driver/uart.h>
 #include <esp_console.h>
+#include <sdkconfig.h>
 
 class Console {
  private:
@@ -22,4 +24,13 @@ class Console {
   void reg(esp_console_cmd_t *cmd) {  // NOLINT
     ESP_ERROR_CHECK(esp_console_cmd_register(cmd));
   }
+
+  // コンソールのUARTのボーレートを変更
+  static void set_baud_rate(uint32_t baud_rate) {
+    ESP_ERROR_CHECK(uart_set_baudrate(static_cast<uart_port_t>(CONFIG_ESP_CONSOLE_UART_NUM), baud_rate));
+  }
+  // コンソールのUARTにバイナリを書き込む (送信バッファに入るまで待つ、送り終わるのは待たない)
+  static int write(const void *data, size_t size) {
+    return uart_write_bytes(static_cast<uart_port_t>(CONFIG_ESP_CONSOLE_UART_NUM), data, size);
+  }
 };
@@ -0,0 +1,93 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+
+// ESP-IDF
+#include <driver/gptimer.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+/**
+ * @brief ハードウェアタイマーで制御タスクを周期的に起こす
+ * @details
+ * FreeRTOSのティック (1 kHz) に縛られずに制御周期を決めるため、
+ * タイマー割り込みで起床時刻を記録してから待っているタスクに通知する。
+ */
+class ControlTimer {
+ public:
+  // 起床情報
+  struct Tick {
+    // 割り込みが発生した時刻 [us]
+    uint32_t release;
+    // 取りこぼした周期の数
+    uint32_t missed;
+  };
+
+ private:
+  static constexpr uint32_t TIMER_RESOLUTION_HZ = 1'000'000;  // [Hz]
+
+  gptimer_handle_t timer_;
+  TaskHandle_t task_;
+
+  // 最後に割り込みが発生した時刻
+  std::atomic<uint32_t> release_;
+
+  static bool IRAM_ATTR alarm_callback(gptimer_handle_t, const gptimer_alarm_event_data_t *, void *user_ctx) {
+    auto this_ptr = reinterpret_cast<ControlTimer *>(user_ctx);
+    this_ptr->release_.store(static_cast<uint32_t>(esp_timer_get_time()), std::memory_order_relaxed);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(this_ptr->task_, &xHigherPriorityTaskWoken);  // NOLINT
+    return xHigherPriorityTaskWoken == pdTRUE;
+  }
+
+ public:
+  /**
+   * @param frequency 周波数 [Hz]
+   * @param task 通知先のタスク
+   */
+  explicit ControlTimer(uint32_t frequency, TaskHandle_t task) : timer_(), task_(task), release_(0) {
+    // 制御タイマー
+    gptimer_config_t timer_config = {};
+    timer_config.clk_src = GPTIMER_CLK_SRC_DEFAULT;
+    timer_config.direction = GPTIMER_COUNT_UP;
+    timer_config.resolution_hz = TIMER_RESOLUTION_HZ;
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &timer_));
+
+    // 制御タイマー コールバックを登録
+    gptimer_event_callbacks_t callback_config = {};
+    callback_config.on_alarm = alarm_callback;
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(timer_, &callback_config, this));
+
+    // 制御タイマー コールバックが発火する条件を設定
+    gptimer_alarm_config_t alarm = {};
+    alarm.reload_count = 0;
+    alarm.alarm_count = TIMER_RESOLUTION_HZ / frequency;
+    alarm.flags.auto_reload_on_alarm = true;
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(timer_, &alarm));
+  }
+  ~ControlTimer() { ESP_ERROR_CHECK(gptimer_del_timer(timer_)); }
+
+  bool start() {
+    esp_err_t enable_err = gptimer_enable(timer_);
+    esp_err_t start_err = gptimer_start(timer_);
+    return enable_err == ESP_OK && start_err == ESP_OK;
+  }
+
+  bool stop() {
+    esp_err_t stop_err = gptimer_stop(timer_);
+    esp_err_t disable_err = gptimer_disable(timer_);
+    return stop_err == ESP_OK && disable_err == ESP_OK;
+  }
+
+  /**
+   * @brief 次の周期まで待つ (通知先のタスクから呼ぶ)
+   * @details 前回の処理中に複数回通知されていた場合は、その分を取りこぼしとして返す
+   */
+  Tick wait() {
+    auto notified = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return {release_.load(std::memory_order_relaxed), notified > 1 ? static_cast<uint32_t>(notified - 1) : 0};
+  }
+};
@@ -9,11 +9,13 @@
 #include "buzzer.h"
 #include "console.h"
 #include "encoder.h"
+#include "encoder_sampler.h"
 #include "fs.h"
 #include "gpio.h"
 #include "imu.h"
 #include "indicator.h"
 #include "motor.h"
+#include "nvs.h"
 #include "photo.h"
 #include "pins.h"
 #include "spi.h"
@@ -25,10 +27,12 @@ struct Driver {
   std::unique_ptr<Buzzer> buzzer;
   std::unique_ptr<Encoder> encoder_right;
   std::unique_ptr<Encoder> encoder_left;
+  std::unique_ptr<EncoderSampler> encoder_sampler;
   std::unique_ptr<Imu> imu;
   std::unique_ptr<Indicator> indicator;
   std::unique_ptr<Motor> motor_right;
   std::unique_ptr<Motor> motor_left;
+  std::unique_ptr<Nvs> nvs;
   std::unique_ptr<Photo> photo;
 
   /**
@@ -38,6 +42,8 @@ struct Driver {
    */
   void init_pro() {
     // clang-format off
+  nvs = std::make_unique<Nvs>();
+
   battery = std::make_unique<Battery>(
       ADC_UNIT_BATTERY,
       ADC_CHANNEL_BATTERY);
@@ -47,10 +53,12 @@ struct Driver {
       GPIO_NUM_IMU_SPI_MISO,
       GPIO_NUM_IMU_SPI_MOSI,
       GPIO_NUM_IMU_SPI_SCLK,
-      16);
+      Imu::BUFFER_SIZE);
   imu = std::make_unique<Imu>(
       *spi_imu_,
-      GPIO_NUM_IMU_SPI_CS);
+      GPIO_NUM_IMU_SPI_CS,
+      true,
+      *nvs);
 
   spi_encoder_ = std::make_unique<Spi>(
       SPI2_HOST,
@@ -64,6 +72,10 @@ struct Driver {
   encoder_left = std::make_unique<Encoder>(
       *spi_encoder_,
       GPIO_NUM_ENCODER_SPI_CS_LEFT);
+  encoder_sampler = std::make_unique<EncoderSampler>(
+      *encoder_right,
+      *encoder_left);
+  encoder_sampler->start();
 
   motor_right = std::make_unique<Motor>(
       1,
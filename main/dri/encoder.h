@@ -77,6 +77,13 @@ class Encoder {
 
     return ret;
   }
+  bool update_polling() {
+    bool ret = spi_.polling_transmit(index_);
+    uint16_t res = rx_buffer_[0] << 8 | rx_buffer_[1];
+    if (verify_angle(res)) raw_ = (res >> 2) & 0x3FF;
+
+    return ret;
+  }
 
   [[nodiscard]] uint16_t raw() const { return raw_; }
 
@@ -0,0 +1,68 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+/**
+ * @brief エンコーダーの絶対角度を積算して、周回をまたいだカウントにする
+ * @details
+ * 前回からの変化量が分解能の半分を超えた場合は周回したとみなす。
+ * 1回のサンプリング間に半周以上回ると区別できないため、十分速い周期で呼ぶ必要がある。
+ */
+class EncoderCounter {
+ public:
+  /**
+   * @param resolution エンコーダーの分解能
+   */
+  explicit EncoderCounter(uint16_t resolution)
+      : resolution_(resolution), resolution_half_(resolution / 2), initialized_(false), previous_(0), total_(0) {}
+  ~EncoderCounter() = default;
+
+  /**
+   * @brief リセット (次回の観測値を原点とする)
+   */
+  void reset() {
+    initialized_ = false;
+    total_ = 0;
+  }
+
+  /**
+   * @brief 観測値を積算する
+   * @param raw 最新の観測角度
+   * @return 積算したカウント
+   */
+  int32_t update(uint16_t raw) {
+    if (!initialized_) [[unlikely]] {
+      previous_ = raw;
+      initialized_ = true;
+      return total_;
+    }
+    int32_t delta = raw - previous_;
+    if (delta > resolution_half_) {
+      delta -= resolution_;
+    } else if (delta < -resolution_half_) {
+      delta += resolution_;
+    }
+    total_ += delta;
+    previous_ = raw;
+    return total_;
+  }
+
+  [[nodiscard]] int32_t total() const { return total_; }
+
+ private:
+  //! エンコーダーの分解能
+  const int32_t resolution_;
+
+  //! エンコーダーの分解能の半分
+  const int32_t resolution_half_;
+
+  //! 初回の観測値を受け取ったか
+  bool initialized_;
+
+  //! 一つ前の観測角度
+  uint16_t previous_;
+
+  //! 積算したカウント
+  int32_t total_;
+};
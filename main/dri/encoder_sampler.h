@@ -0,0 +1,160 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+
+// ESP-IDF
+#include <driver/gptimer.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Project
+#include "encoder.h"
+#include "encoder_counter.h"
+#include "seqlock.h"
+
+/**
+ * @brief 制御周期とは独立に、ハードウェアタイマーで左右のエンコーダーを読み出す
+ * @details
+ * タイマー割り込みからサンプリングタスクに通知し、タスク内で左右を続けてポーリング転送で読む。
+ * 割り込みは登録したコアに割り当てられるため、タイマーはCore 1のサンプリングタスクの中で作る。
+ * 読み出した角度は周回をまたいだカウントに積算し、SeqLockで公開する。
+ * 制御周期側はcounts()で最新の積算値を取り出し、前回との差分を読み出した時刻の間隔で割って速度を求める。
+ */
+class EncoderSampler {
+ public:
+  // サンプリング周波数 [Hz]
+  static constexpr uint32_t SAMPLING_FREQUENCY = 4'000;
+
+  // 積算値
+  struct Counts {
+    // 右の積算カウント
+    int32_t right;
+    // 左の積算カウント
+    int32_t left;
+    // 最後に読み出した時刻 [us]
+    uint32_t timestamp;
+    // 読み出した回数
+    uint32_t samples;
+  };
+
+ private:
+  static constexpr uint32_t TIMER_RESOLUTION_HZ = 1'000'000;  // [Hz]
+  static constexpr uint32_t TIMER_COUNTS = TIMER_RESOLUTION_HZ / SAMPLING_FREQUENCY;
+  // 制御タスク(Core 0)を乱さないようCore 1で最優先に動かす
+  static constexpr UBaseType_t TASK_PRIORITY = configMAX_PRIORITIES - 1;
+  static constexpr BaseType_t TASK_CORE_ID = 1;
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+
+  Encoder &right_;
+  Encoder &left_;
+  EncoderCounter counter_right_;
+  EncoderCounter counter_left_;
+
+  gptimer_handle_t timer_;
+  TaskHandle_t task_;
+  // タイマーを作り終えたことを通知するタスク (コンストラクタを呼んだタスク)
+  TaskHandle_t creator_;
+
+  // 公開中の積算値
+  data::SeqLock<Counts> counts_;
+  // 読み出した回数
+  uint32_t samples_;
+  // 読み出しに失敗した回数
+  std::atomic<uint32_t> errors_;
+
+  static bool IRAM_ATTR alarm_callback(gptimer_handle_t, const gptimer_alarm_event_data_t *, void *user_ctx) {
+    auto this_ptr = reinterpret_cast<EncoderSampler *>(user_ctx);
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(this_ptr->task_, &xHigherPriorityTaskWoken);  // NOLINT
+    return xHigherPriorityTaskWoken == pdTRUE;
+  }
+
+  [[noreturn]] static void task(void *arg) {
+    auto this_ptr = reinterpret_cast<EncoderSampler *>(arg);
+    // 割り込みをこのコア (Core 1) に割り当てる
+    this_ptr->setup_timer();
+    xTaskNotifyGive(this_ptr->creator_);
+    while (true) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      this_ptr->sample();
+    }
+  }
+
+  void setup_timer() {
+    // サンプリングタイマー
+    gptimer_config_t timer_config = {};
+    timer_config.clk_src = GPTIMER_CLK_SRC_DEFAULT;
+    timer_config.direction = GPTIMER_COUNT_UP;
+    timer_config.resolution_hz = TIMER_RESOLUTION_HZ;
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &timer_));
+
+    // サンプリングタイマー コールバックを登録 (呼んだコアで割り込みを確保する)
+    gptimer_event_callbacks_t callback_config = {};
+    callback_config.on_alarm = alarm_callback;
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(timer_, &callback_config, this));
+
+    // サンプリングタイマー コールバックが発火する条件を設定
+    gptimer_alarm_config_t alarm = {};
+    alarm.reload_count = 0;
+    alarm.alarm_count = TIMER_COUNTS;
+    alarm.flags.auto_reload_on_alarm = true;
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(timer_, &alarm));
+
+    // 割り込みの有効化も確保したコアで行う
+    ESP_ERROR_CHECK(gptimer_enable(timer_));
+  }
+
+  void sample() {
+    // 左右を続けて読み出す
+    bool right_ok = right_.update_polling();
+    bool left_ok = left_.update_polling();
+    auto timestamp = static_cast<uint32_t>(esp_timer_get_time());
+    if (!right_ok || !left_ok) [[unlikely]] {
+      errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto right = counter_right_.update(right_.raw());
+    auto left = counter_left_.update(left_.raw());
+
+    // 公開
+    samples_++;
+    counts_.store({right, left, timestamp, samples_});
+  }
+
+ public:
+  explicit EncoderSampler(Encoder &right, Encoder &left)
+      : right_(right),
+        left_(left),
+        counter_right_(Encoder::resolution()),
+        counter_left_(Encoder::resolution()),
+        timer_(),
+        task_(),
+        creator_(xTaskGetCurrentTaskHandle()),
+        counts_(),
+        samples_(0),
+        errors_(0) {
+    // サンプリングタスク (タイマーを作り終えるまで待つ)
+    xTaskCreatePinnedToCore(task, "encoderTask", TASK_STACK_SIZE, this, TASK_PRIORITY, &task_, TASK_CORE_ID);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+  ~EncoderSampler() {
+    vTaskDelete(task_);
+    gptimer_stop(timer_);
+    ESP_ERROR_CHECK(gptimer_disable(timer_));
+    ESP_ERROR_CHECK(gptimer_del_timer(timer_));
+  }
+
+  // 割り込みは作った時に有効にしてあるので、カウンタだけを動かす・止める (どのコアからでも呼べる)
+  bool start() { return gptimer_start(timer_) == ESP_OK; }
+  bool stop() { return gptimer_stop(timer_) == ESP_OK; }
+
+  /**
+   * @brief 最新の積算値を取り出す
+   * @details 書き込み中に読んだ場合は読み直す (書き込み側は待たない)
+   */
+  [[nodiscard]] Counts counts() const { return counts_.load(); }
+
+  [[nodiscard]] uint32_t errors() const { return errors_.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <concepts>
+
+// Project
+#include "average.h"
+#include "ringbuffer.h"
+
+namespace data {
+/**
+ * @brief 中央値フィルタ
+ * @details 直近N個のサンプルの中央値を返す。スパイク状のノイズを除去する。
+ */
+template <Numeric T, std::size_t N>
+class MedianFilter {
+  static_assert(N % 2 == 1, "N must be odd.");
+
+ private:
+  // サンプルを保持する配列
+  std::array<T, N> samples_;
+  // 次に書き込む添字
+  std::size_t index_;
+  // 初回かどうか
+  bool empty_;
+
+ public:
+  explicit MedianFilter() : samples_(), index_(0), empty_(true) {}
+  ~MedianFilter() = default;
+
+  void reset() {
+    index_ = 0;
+    empty_ = true;
+  }
+
+  T update(T sample) {
+    if (empty_) [[unlikely]] {
+      // 初回は与えられた値でバッファを満たす
+      samples_.fill(sample);
+      empty_ = false;
+    }
+    samples_[index_] = sample;
+    index_ = (index_ + 1) % N;
+
+    // 要素数が少ないため挿入ソートで十分
+    auto sorted = samples_;
+    for (std::size_t i = 1; i < N; i++) {
+      for (std::size_t j = i; j > 0 && sorted[j] < sorted[j - 1]; j--) {
+        std::swap(sorted[j], sorted[j - 1]);
+      }
+    }
+    return sorted[N / 2];
+  }
+};
+
+/**
+ * @brief シュミットトリガ
+ * @details 上側しきい値を超えたらtrue、下側しきい値を下回ったらfalseにする。
+ */
+template <Numeric T>
+class SchmittTrigger {
+ private:
+  // 下側しきい値
+  T low_;
+  // 上側しきい値
+  T high_;
+  // 現在の状態
+  bool state_;
+
+ public:
+  explicit SchmittTrigger(T low, T high) : low_(low), high_(high), state_(false) {}
+  ~SchmittTrigger() = default;
+
+  void reset(bool state = false) { state_ = state; }
+
+  bool update(T sample) {
+    if (state_) {
+      if (sample < low_) state_ = false;
+    } else {
+      if (sample > high_) state_ = true;
+    }
+    return state_;
+  }
+
+  [[nodiscard]] bool state() const { return state_; }
+};
+
+/**
+ * @brief しきい値判定器
+ * @details
+ * 中央値フィルタ -> シュミットトリガの順に通して判定する。
+ * 直近H回の単純比較の結果が判定と一致した割合を確信度とする。
+ */
+template <Numeric T, std::size_t N, std::size_t H>
+class ThresholdDetector {
+ private:
+  // 中央値フィルタ
+  MedianFilter<T, N> median_;
+  // ヒステリシス
+  SchmittTrigger<T> trigger_;
+  // 単純比較の結果の履歴
+  RingBuffer<bool, H> history_;
+  // 単純比較のしきい値
+  T threshold_;
+  // 履歴のうちtrueの個数
+  std::size_t count_;
+  // フィルタ後の値
+  T value_;
+
+ public:
+  /**
+   * @param threshold しきい値
+   * @param hysteresis ヒステリシス幅 (しきい値±hysteresisで切り替わる)
+   */
+  explicit ThresholdDetector(T threshold, T hysteresis)
+      : trigger_(threshold - hysteresis, threshold + hysteresis), threshold_(threshold), count_(0), value_() {}
+  ~ThresholdDetector() = default;
+
+  void reset() {
+    median_.reset();
+    trigger_.reset();
+    history_.reset();
+    count_ = 0;
+  }
+
+  bool update(T sample) {
+    // 単純比較の履歴を更新
+    bool above = sample > threshold_;
+    if (history_.size() == history_.max_size()) {
+      if (history_.front()) count_--;
+      history_.popFront();
+    }
+    history_.pushBack(above);
+    if (above) count_++;
+
+    value_ = median_.update(sample);
+    return trigger_.update(value_);
+  }
+
+  [[nodiscard]] bool state() const { return trigger_.state(); }
+  [[nodiscard]] T value() const { return value_; }
+
+  // 判定の確信度 [0, 1]
+  [[nodiscard]] float confidence() const {
+    if (history_.size() == 0) return 0.0f;
+    auto agree = trigger_.state() ? count_ : history_.size() - count_;
+    return static_cast<float>(agree) / static_cast<float>(history_.size());
+  }
+};
+}  // namespace data
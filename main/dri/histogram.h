@@ -0,0 +1,104 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Project
+#include "average.h"
+
+namespace data {
+/**
+ * @brief 等幅のビンで値の分布を記録する
+ * @details
+ * [lower, lower + width * N) をN個のビンに分け、範囲外は両端のビンに数える。
+ * 最小・最大・平均は範囲外の値も含めて正確に保持する。
+ */
+template <Numeric T, std::size_t N>
+class Histogram {
+ private:
+  // 最初のビンの下限
+  T lower_;
+  // ビンの幅
+  T width_;
+  // 各ビンの度数
+  std::array<uint32_t, N> bins_;
+  // 範囲外の度数
+  uint32_t underflow_, overflow_;
+  // 全体の度数
+  uint32_t count_;
+  // 最小・最大
+  T min_, max_;
+  // 合計 (平均の計算用、floatでは長時間の積算で小さい値が丸めで落ちるので整数は64ビットで持つ)
+  std::conditional_t<std::is_integral_v<T>, int64_t, double> sum_;
+
+ public:
+  /**
+   * @param lower 最初のビンの下限
+   * @param width ビンの幅
+   */
+  explicit Histogram(T lower, T width) : lower_(lower), width_(width) { reset(); }
+  ~Histogram() = default;
+
+  void reset() {
+    bins_.fill(0);
+    underflow_ = 0;
+    overflow_ = 0;
+    count_ = 0;
+    min_ = std::numeric_limits<T>::max();
+    max_ = std::numeric_limits<T>::lowest();
+    sum_ = 0;
+  }
+
+  void update(T sample) {
+    if (sample < lower_) {
+      underflow_++;
+      bins_.front()++;
+    } else {
+      auto index = static_cast<std::size_t>((sample - lower_) / width_);
+      if (index >= N) {
+        overflow_++;
+        index = N - 1;
+      }
+      bins_[index]++;
+    }
+    count_++;
+    min_ = std::min(min_, sample);
+    max_ = std::max(max_, sample);
+    sum_ += static_cast<decltype(sum_)>(sample);
+  }
+
+  /**
+   * @brief 分位点を返す
+   * @param ratio 0.0 ~ 1.0
+   * @return 分位点を含むビンの上限
+   */
+  [[nodiscard]] T percentile(float ratio) const {
+    if (count_ == 0) return lower_;
+    auto target = static_cast<uint32_t>(ratio * static_cast<float>(count_));
+    uint32_t sum = 0;
+    for (std::size_t i = 0; i < N; i++) {
+      sum += bins_[i];
+      if (sum > target) return std::min(max_, static_cast<T>(lower_ + width_ * static_cast<T>(i + 1)));
+    }
+    return max_;
+  }
+
+  // ビンの下限
+  [[nodiscard]] T lower(std::size_t index) const { return static_cast<T>(lower_ + width_ * static_cast<T>(index)); }
+  // ビンの度数
+  [[nodiscard]] uint32_t operator[](std::size_t index) const { return bins_[index]; }
+  [[nodiscard]] constexpr std::size_t size() const { return N; }
+  [[nodiscard]] uint32_t count() const { return count_; }
+  [[nodiscard]] uint32_t underflow() const { return underflow_; }
+  [[nodiscard]] uint32_t overflow() const { return overflow_; }
+  [[nodiscard]] T min() const { return count_ == 0 ? T() : min_; }
+  [[nodiscard]] T max() const { return count_ == 0 ? T() : max_; }
+  [[nodiscard]] float mean() const {
+    return count_ == 0 ? 0.0f : static_cast<float>(static_cast<double>(sum_) / static_cast<double>(count_));
+  }
+};
+}  // namespace data
@@ -1,23 +1,38 @@
 #pragma once
 
 // C++
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <span>
 #include <vector>
 
 // ESP-IDF
 #include <driver/gpio.h>
 #include <driver/spi_master.h>
 #include <esp_intr_alloc.h>
+#include <esp_rom_crc.h>
 #include <rom/ets_sys.h>
 
 // Project
+#include "average.h"
+#include "imu_fifo.h"
+#include "nvs.h"
 #include "spi.h"
 
 class Imu {
  public:
   static constexpr float ANGULAR_RATE_SENSITIVITY = 70.0f;          // [mdps/LSB]
   static constexpr float LINEAR_ACCELERATION_SENSITIVITY = 0.061f;  // [mg/LSB]
+  static constexpr float TEMPERATURE_SENSITIVITY = 256.0f;          // [LSB/degC]
+  static constexpr float TEMPERATURE_OFFSET = 25.0f;                // [degC]
+
+  // 1回のFIFO読み出しで取得する最大ワード数 (TIMESTAMP/GYRO/ACCELで1サンプル)
+  static constexpr size_t FIFO_MAX_WORDS = ImuFifo::MAX_SAMPLES * 3;
+  // 送受信バッファサイズ
+  static constexpr size_t BUFFER_SIZE = FIFO_MAX_WORDS * ImuFifo::WORD_SIZE;
 
   template <typename T>
   struct Axis {
@@ -26,17 +41,65 @@ class Imu {
     T z;
   };
 
+  // キャリブレーション結果 (NVSに保存する)
+  struct Calibration {
+    // 形式のバージョン
+    uint32_t version;
+    // 加速度計のユーザーオフセット [2^-10 g/LSB]
+    Axis<int8_t> accel_offset;
+    // 基準温度での角速度のバイアス [mdps]
+    Axis<float> gyro_bias;
+    // 角速度のバイアスの温度係数 [mdps/degC]
+    Axis<float> gyro_slope;
+    // 基準温度 [degC]
+    float temperature;
+    // version ~ temperatureのCRC32
+    uint32_t checksum;
+  };
+  static constexpr uint32_t CALIBRATION_VERSION = 1;
+
  private:
   Spi &spi_;
   int index_;
   uint8_t *rx_buffer_, *tx_buffer_;
   Axis<int16_t> raw_gyro_, raw_accel_;
   Axis<float> gyro_, accel_;
-
-  // 送受信バッファサイズ
-  static constexpr size_t BUFFER_SIZE = 12;
+  // 温度 [degC]
+  float temperature_;
+
+  // キャリブレーション結果の保存先
+  Nvs &nvs_;
+  static constexpr auto CALIBRATION_KEY = "imu_calib";
+  // 現在のキャリブレーション結果
+  Calibration calibration_;
+
+  // FIFOを使用するか
+  bool use_fifo_;
+  // FIFOの解析
+  ImuFifo fifo_;
+  // FIFOが溢れたか
+  bool fifo_overrun_;
 
   // レジスタ
+  static constexpr uint8_t REG_FIFO_CTRL3 = 0x09;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_GY_3 = 7;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_GY_2 = 6;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_GY_1 = 5;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_GY_0 = 4;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_XL_3 = 3;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_XL_2 = 2;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_XL_1 = 1;
+  static constexpr uint8_t BIT_FIFO_CTRL3_BDR_XL_0 = 0;
+
+  static constexpr uint8_t REG_FIFO_CTRL4 = 0x0A;
+  static constexpr uint8_t BIT_FIFO_CTRL4_DEC_TS_BATCH_1 = 7;
+  static constexpr uint8_t BIT_FIFO_CTRL4_DEC_TS_BATCH_0 = 6;
+  static constexpr uint8_t BIT_FIFO_CTRL4_ODR_T_BATCH_1 = 5;
+  static constexpr uint8_t BIT_FIFO_CTRL4_ODR_T_BATCH_0 = 4;
+  static constexpr uint8_t BIT_FIFO_CTRL4_FIFO_MODE_2 = 2;
+  static constexpr uint8_t BIT_FIFO_CTRL4_FIFO_MODE_1 = 1;
+  static constexpr uint8_t BIT_FIFO_CTRL4_FIFO_MODE_0 = 0;
+
   static constexpr uint8_t REG_WHO_AM_I = 0x0F;
   static constexpr uint8_t DAT_WHO_AM_I = 0x6B;
 
@@ -84,13 +147,25 @@ class Imu {
   static constexpr uint8_t REG_CTRL9_XL = 0x18;
   static constexpr uint8_t BIT_CTRL9_XL_I3C_DISABLE = 1;
 
-  static constexpr uint8_t REG_OUTX_L_G = 0x22;
+  static constexpr uint8_t REG_CTRL10_C = 0x19;
+  static constexpr uint8_t BIT_CTRL10_C_TIMESTAMP_EN = 5;
+
+  static constexpr uint8_t REG_FIFO_STATUS1 = 0x3A;
+  static constexpr uint8_t BIT_FIFO_STATUS2_FIFO_OVR_IA = 6;
+
+  static constexpr uint8_t REG_OUT_TEMP_L = 0x20;
+
+  static constexpr uint8_t REG_TIMESTAMP2 = 0x42;
+  static constexpr uint8_t DAT_TIMESTAMP2_RESET = 0xAA;
+
+  static constexpr uint8_t REG_FIFO_DATA_OUT_TAG = 0x78;
 
   static constexpr uint8_t REG_X_OFS_USR = 0x73;
   static constexpr uint8_t REG_Y_OFS_USR = 0x74;
   static constexpr uint8_t REG_Z_OFS_USR = 0x75;
 
   /**
+   * NVSにキャリブレーション結果が無い場合の既定値
    * Accel X: -0.016088 x + -1.692139
    * Accel Y: -0.030933 x + -45.486130
    * Accel Z: -0.130897 x + 1004.997559
@@ -128,8 +203,170 @@ class Imu {
     return ret;
   }
 
+  void set_raw(const int16_t *gyro, const int16_t *accel) {
+    raw_gyro_.x = gyro[0];
+    raw_gyro_.y = gyro[1];
+    raw_gyro_.z = gyro[2];
+    raw_accel_.x = accel[0];
+    raw_accel_.y = accel[1];
+    raw_accel_.z = accel[2];
+
+    gyro_ = to_angular_rate(gyro);
+    accel_.x = static_cast<float>(raw_accel_.x) * LINEAR_ACCELERATION_SENSITIVITY;
+    accel_.y = static_cast<float>(raw_accel_.y) * LINEAR_ACCELERATION_SENSITIVITY;
+    accel_.z = static_cast<float>(raw_accel_.z) * LINEAR_ACCELERATION_SENSITIVITY;
+  }
+
+  void set_temperature(int16_t raw) {
+    temperature_ = static_cast<float>(raw) / TEMPERATURE_SENSITIVITY + TEMPERATURE_OFFSET;
+  }
+
+  // 出力レジスタから最新値を1つ読み出す
+  bool update_register() {
+    auto trans = spi_.transaction(index_);
+    trans->flags = 0;
+    trans->tx_buffer = tx_buffer_;
+    trans->rx_buffer = rx_buffer_;
+    trans->addr = REG_OUT_TEMP_L | 0x80;
+    trans->length = 14 * 8;  // OUT_TEMP_L(20h) ~ OUTZ_H_A(2Dh)
+    trans->rxlength = trans->length;
+    bool ret = spi_.transmit(index_);
+    if (ret) {
+      auto res = reinterpret_cast<int16_t *>(rx_buffer_);
+      set_temperature(res[0]);
+      set_raw(&res[1], &res[4]);
+    }
+    return ret;
+  }
+
+  // FIFOに溜まったサンプルをまとめて読み出す
+  bool update_fifo() {
+    // 未読ワード数を取得 (FIFO_STATUS1, FIFO_STATUS2)
+    auto trans = spi_.transaction(index_);
+    trans->flags = SPI_TRANS_USE_TXDATA | SPI_TRANS_USE_RXDATA;
+    trans->tx_buffer = nullptr;
+    trans->rx_buffer = nullptr;
+    trans->addr = REG_FIFO_STATUS1 | 0x80;
+    trans->length = 16;
+    trans->rxlength = 0;
+    if (!spi_.transmit(index_)) {
+      return false;
+    }
+    std::bitset<8> status2 = trans->rx_data[1];
+    fifo_overrun_ = status2[BIT_FIFO_STATUS2_FIFO_OVR_IA];
+    size_t words = trans->rx_data[0] | ((trans->rx_data[1] & 0x03) << 8);
+    words = std::min(words, FIFO_MAX_WORDS);
+    if (words == 0) {
+      fifo_.parse(rx_buffer_, 0);
+      return true;
+    }
+
+    // FIFO_DATA_OUT_TAG(78h) ~ FIFO_DATA_OUT_Z_H(7Eh)を連続で読み出す (7Eh -> 78hに自動で戻る)
+    trans->flags = 0;
+    trans->tx_buffer = tx_buffer_;
+    trans->rx_buffer = rx_buffer_;
+    trans->addr = REG_FIFO_DATA_OUT_TAG | 0x80;
+    trans->length = words * ImuFifo::WORD_SIZE * 8;
+    trans->rxlength = trans->length;
+    bool ret = spi_.transmit(index_);
+    if (ret) {
+      fifo_.parse(rx_buffer_, words * ImuFifo::WORD_SIZE);
+      set_temperature(fifo_.temperature());
+      // 最新のサンプルを現在値とする
+      auto samples = fifo_.samples();
+      if (!samples.empty()) {
+        set_raw(samples.back().gyro, samples.back().accel);
+      }
+    }
+    return ret;
+  }
+
+  // FIFOをタイムスタンプ付きの連続モードで有効化
+  void enable_fifo() {
+    std::bitset<8> reg;
+    // タイムスタンプを有効化
+    reg = read_byte(REG_CTRL10_C);
+    reg[BIT_CTRL10_C_TIMESTAMP_EN] = true;
+    write_byte(REG_CTRL10_C, static_cast<uint8_t>(reg.to_ulong()));
+    write_byte(REG_TIMESTAMP2, DAT_TIMESTAMP2_RESET);
+
+    // 角速度計・加速度計のバッチレートを1.667kHzに設定
+    reg = read_byte(REG_FIFO_CTRL3);
+    reg[BIT_FIFO_CTRL3_BDR_GY_3] = true;
+    reg[BIT_FIFO_CTRL3_BDR_GY_2] = false;
+    reg[BIT_FIFO_CTRL3_BDR_GY_1] = false;
+    reg[BIT_FIFO_CTRL3_BDR_GY_0] = false;
+    reg[BIT_FIFO_CTRL3_BDR_XL_3] = true;
+    reg[BIT_FIFO_CTRL3_BDR_XL_2] = false;
+    reg[BIT_FIFO_CTRL3_BDR_XL_1] = false;
+    reg[BIT_FIFO_CTRL3_BDR_XL_0] = false;
+    // FIFO_CTRL3を反映
+    write_byte(REG_FIFO_CTRL3, static_cast<uint8_t>(reg.to_ulong()));
+
+    reg = read_byte(REG_FIFO_CTRL4);
+    // タイムスタンプをバッチ毎に格納
+    reg[BIT_FIFO_CTRL4_DEC_TS_BATCH_1] = false;
+    reg[BIT_FIFO_CTRL4_DEC_TS_BATCH_0] = true;
+    // 温度を52Hzで格納
+    reg[BIT_FIFO_CTRL4_ODR_T_BATCH_1] = true;
+    reg[BIT_FIFO_CTRL4_ODR_T_BATCH_0] = true;
+    // 連続モード (FIFOが満杯の場合は古いデータを上書き)
+    reg[BIT_FIFO_CTRL4_FIFO_MODE_2] = true;
+    reg[BIT_FIFO_CTRL4_FIFO_MODE_1] = true;
+    reg[BIT_FIFO_CTRL4_FIFO_MODE_0] = false;
+    // FIFO_CTRL4を反映
+    write_byte(REG_FIFO_CTRL4, static_cast<uint8_t>(reg.to_ulong()));
+  }
+
+  static uint32_t checksum(const Calibration &calibration) {
+    return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(&calibration), offsetof(Calibration, checksum));
+  }
+
+  // NVSからキャリブレーション結果を読み込む
+  bool load_calibration() {
+    Calibration calibration{};
+    if (!nvs_.read(CALIBRATION_KEY, calibration)) {
+      return false;
+    }
+    if (calibration.version != CALIBRATION_VERSION || calibration.checksum != checksum(calibration)) {
+      return false;
+    }
+    calibration_ = calibration;
+    return true;
+  }
+
+  // 加速度計のユーザーオフセットを反映
+  void write_accel_offset(const Axis<int8_t> &offset) {
+    write_byte(REG_X_OFS_USR, static_cast<uint8_t>(offset.x));
+    write_byte(REG_Y_OFS_USR, static_cast<uint8_t>(offset.y));
+    write_byte(REG_Z_OFS_USR, static_cast<uint8_t>(offset.z));
+  }
+
  public:
-  explicit Imu(Spi &spi, gpio_num_t spics_io_num) : spi_(spi), raw_gyro_(), raw_accel_(), gyro_(), accel_() {
+  /**
+   * @param spi 接続されたSPIバス
+   * @param spics_io_num CSピン
+   * @param use_fifo FIFOからタイムスタンプ付きでまとめて読み出す
+   * @param nvs キャリブレーション結果の保存先
+   */
+  explicit Imu(Spi &spi, gpio_num_t spics_io_num, bool use_fifo, Nvs &nvs)
+      : spi_(spi),
+        raw_gyro_(),
+        raw_accel_(),
+        gyro_(),
+        accel_(),
+        temperature_(TEMPERATURE_OFFSET),
+        nvs_(nvs),
+        calibration_(),
+        use_fifo_(use_fifo),
+        fifo_overrun_(false) {
+    // 保存されたキャリブレーション結果を読み込む (無い場合は既定値)
+    if (!load_calibration()) {
+      calibration_.version = CALIBRATION_VERSION;
+      calibration_.accel_offset = {DAT_X_OFS_USR, DAT_Y_OFS_USR, DAT_Z_OFS_USR};
+      calibration_.temperature = TEMPERATURE_OFFSET;
+    }
+
     // 転送用バッファを確保
     tx_buffer_ = reinterpret_cast<uint8_t *>(heap_caps_calloc(BUFFER_SIZE, sizeof(uint8_t), MALLOC_CAP_DMA));
     rx_buffer_ = reinterpret_cast<uint8_t *>(heap_caps_calloc(BUFFER_SIZE, sizeof(uint8_t), MALLOC_CAP_DMA));
@@ -190,9 +427,7 @@ class Imu {
     reg[BIT_CTRL7_G_USR_OFF_ON_OUT] = true;
     // CTRL7_Gを反映
     write_byte(REG_CTRL7_G, static_cast<uint8_t>(reg.to_ulong()));
-    write_byte(REG_X_OFS_USR, static_cast<uint8_t>(DAT_X_OFS_USR));
-    write_byte(REG_Y_OFS_USR, static_cast<uint8_t>(DAT_Y_OFS_USR));
-    write_byte(REG_Z_OFS_USR, static_cast<uint8_t>(DAT_Z_OFS_USR));
+    write_accel_offset(calibration_.accel_offset);
 
     // 角速度計の設定
     reg = read_byte(REG_CTRL2_G);
@@ -219,124 +454,127 @@ class Imu {
     reg[BIT_CTRL6_C_FTYPE_0] = false;
     // CTRL6_Cを反映
     write_byte(REG_CTRL6_C, static_cast<uint8_t>(reg.to_ulong()));
+
+    // FIFOの設定
+    if (use_fifo_) {
+      enable_fifo();
+    }
   }
   ~Imu() {
     free(tx_buffer_);
     free(rx_buffer_);
   }
 
-  bool update() {
-    auto trans = spi_.transaction(index_);
-    trans->flags = 0;
-    trans->tx_buffer = tx_buffer_;
-    trans->rx_buffer = rx_buffer_;
-    trans->addr = REG_OUTX_L_G | 0x80;
-    trans->length = 12 * 8;  // OUTX_L_G(22h) ~ OUTZ_H_A(2Dh)
-    trans->rxlength = trans->length;
-    bool ret = spi_.transmit(index_);
-    if (ret) {
-      auto res = reinterpret_cast<int16_t *>(rx_buffer_);
-      raw_gyro_.x = res[0];
-      raw_gyro_.y = res[1];
-      raw_gyro_.z = res[2];
-      raw_accel_.x = res[3];
-      raw_accel_.y = res[4];
-      raw_accel_.z = res[5];
-
-      gyro_.x = static_cast<float>(raw_gyro_.x) * ANGULAR_RATE_SENSITIVITY;
-      gyro_.y = static_cast<float>(raw_gyro_.y) * ANGULAR_RATE_SENSITIVITY;
-      gyro_.z = static_cast<float>(raw_gyro_.z) * ANGULAR_RATE_SENSITIVITY;
-      accel_.x = static_cast<float>(raw_accel_.x) * LINEAR_ACCELERATION_SENSITIVITY;
-      accel_.y = static_cast<float>(raw_accel_.y) * LINEAR_ACCELERATION_SENSITIVITY;
-      accel_.z = static_cast<float>(raw_accel_.z) * LINEAR_ACCELERATION_SENSITIVITY;
-    }
-    return ret;
-  }
+  bool update() { return use_fifo_ ? update_fifo() : update_register(); }
 
   const Axis<int16_t> &raw_angular_rate() { return raw_gyro_; }
   const Axis<int16_t> &raw_linear_acceleration() { return raw_accel_; }
   const Axis<float> &angular_rate() { return gyro_; }
   const Axis<float> &linear_acceleration() { return accel_; }
 
-  void offset(int n) {
+  // FIFOを使用するか
+  [[nodiscard]] bool use_fifo() const { return use_fifo_; }
+  // 前回のupdate()でFIFOから読み出したサンプル (FIFO未使用時は空)
+  [[nodiscard]] std::span<const ImuFifo::Sample> samples() const { return fifo_.samples(); }
+  // 前回のupdate()でFIFOが溢れていたか
+  [[nodiscard]] bool fifo_overrun() const { return fifo_overrun_; }
+  // 温度 [degC]
+  [[nodiscard]] float temperature() const { return temperature_; }
+  // キャリブレーション結果
+  [[nodiscard]] const Calibration &calibration_result() const { return calibration_; }
+
+  // 生の角速度をバイアス・温度補正して[mdps]に変換する
+  [[nodiscard]] Axis<float> to_angular_rate(const int16_t *gyro) const {
+    auto delta = temperature_ - calibration_.temperature;
+    return {
+        static_cast<float>(gyro[0]) * ANGULAR_RATE_SENSITIVITY -
+            (calibration_.gyro_bias.x + calibration_.gyro_slope.x * delta),
+        static_cast<float>(gyro[1]) * ANGULAR_RATE_SENSITIVITY -
+            (calibration_.gyro_bias.y + calibration_.gyro_slope.y * delta),
+        static_cast<float>(gyro[2]) * ANGULAR_RATE_SENSITIVITY -
+            (calibration_.gyro_bias.z + calibration_.gyro_slope.z * delta),
+    };
+  }
+
+  /**
+   * @brief 静止状態でオフセットを計測し、NVSに保存する
+   * @param n サンプル数
+   * @details
+   * 加速度は時間に対する直線近似の切片からユーザーオフセットを求めてチップに書き込む。
+   * 角速度は温度に対する直線近似からバイアスと温度係数を求める。
+   * 計測中に温度がほとんど変化しない場合は温度係数を0とし、平均をバイアスとする。
+   */
+  bool offset(int n) {
     const float output_data_rate = 1660;                                // [Hz]
     const float user_offset_weight = 1000.0f * std::pow(2.0f, -10.0f);  // [mg/LSB]
+    const float min_temperature_range = 0.5f;                           // [degC]
     const float delay = 1.0f / output_data_rate;
-    float sum_x = 0.0f, sum_x_2 = 0.0f;
+    float min_t = temperature_, max_t = temperature_;
     Axis<float> accel_coeff{}, accel_inter{}, gyro_coeff{}, gyro_inter{};
-    Axis<float> sum_accel_xy{}, sum_accel_y{}, sum_gyro_xy{}, sum_gyro_y{};
+    // 加速度は時間、角速度は温度に対する直線近似 (平均回りで積算して桁落ちを避ける)
+    Axis<data::LinearRegression<float>> accel_fit, gyro_fit;
     Axis<int8_t> accel_offset{};
 
     // 現在の設定をクリア
-    write_byte(REG_X_OFS_USR, 0);
-    write_byte(REG_Y_OFS_USR, 0);
-    write_byte(REG_Z_OFS_USR, 0);
+    write_accel_offset({0, 0, 0});
 
     for (int i = 0; i < n; i++) {
       ets_delay_us(static_cast<uint32_t>(delay * 1000'000.0f));
       update();
       const float x = delay * static_cast<float>(i);
+      const float t = temperature_;
       auto &accel = raw_linear_acceleration();
-      auto accel_x = static_cast<float>(accel.x) * LINEAR_ACCELERATION_SENSITIVITY;
-      auto accel_y = static_cast<float>(accel.y) * LINEAR_ACCELERATION_SENSITIVITY;
-      auto accel_z = static_cast<float>(accel.z) * LINEAR_ACCELERATION_SENSITIVITY;
+      accel_fit.x.update(x, static_cast<float>(accel.x) * LINEAR_ACCELERATION_SENSITIVITY);
+      accel_fit.y.update(x, static_cast<float>(accel.y) * LINEAR_ACCELERATION_SENSITIVITY);
+      accel_fit.z.update(x, static_cast<float>(accel.z) * LINEAR_ACCELERATION_SENSITIVITY);
 
       auto &gyro = raw_angular_rate();
-      auto gyro_x = static_cast<float>(gyro.x) * ANGULAR_RATE_SENSITIVITY;
-      auto gyro_y = static_cast<float>(gyro.y) * ANGULAR_RATE_SENSITIVITY;
-      auto gyro_z = static_cast<float>(gyro.z) * ANGULAR_RATE_SENSITIVITY;
-
-      sum_accel_y.x += accel_x;
-      sum_accel_y.y += accel_y;
-      sum_accel_y.z += accel_z;
-      sum_accel_xy.x += x * static_cast<float>(accel_x);
-      sum_accel_xy.y += x * static_cast<float>(accel_y);
-      sum_accel_xy.z += x * static_cast<float>(accel_z);
-      sum_gyro_y.x += static_cast<float>(gyro_x);
-      sum_gyro_y.y += static_cast<float>(gyro_y);
-      sum_gyro_y.z += static_cast<float>(gyro_z);
-      sum_gyro_xy.x += x * static_cast<float>(gyro_x);
-      sum_gyro_xy.y += x * static_cast<float>(gyro_y);
-      sum_gyro_xy.z += x * static_cast<float>(gyro_z);
-      sum_x += x;
-      sum_x_2 += std::pow(x, 2.0f);
+      gyro_fit.x.update(t, static_cast<float>(gyro.x) * ANGULAR_RATE_SENSITIVITY);
+      gyro_fit.y.update(t, static_cast<float>(gyro.y) * ANGULAR_RATE_SENSITIVITY);
+      gyro_fit.z.update(t, static_cast<float>(gyro.z) * ANGULAR_RATE_SENSITIVITY);
+      min_t = std::min(min_t, t);
+      max_t = std::max(max_t, t);
     }
-    auto coeff_a = [&](float sum_xy, float sum_y) {
-      return (static_cast<float>(n) * sum_xy - sum_x * sum_y) /
-             (static_cast<float>(n) * sum_x_2 - std::pow(sum_x, 2.0f));
-    };
-    auto inter_b = [&](float sum_xy, float sum_y) {
-      return (sum_x_2 * sum_y - sum_xy * sum_x) / (static_cast<float>(n) * sum_x_2 - std::pow(sum_x, 2.0f));
-    };
-    accel_coeff.x = coeff_a(sum_accel_xy.x, sum_accel_y.x);
-    accel_coeff.y = coeff_a(sum_accel_xy.y, sum_accel_y.y);
-    accel_coeff.z = coeff_a(sum_accel_xy.z, sum_accel_y.z);
-    accel_inter.x = inter_b(sum_accel_xy.x, sum_accel_y.x);
-    accel_inter.y = inter_b(sum_accel_xy.y, sum_accel_y.y);
-    accel_inter.z = inter_b(sum_accel_xy.z, sum_accel_y.z);
+    accel_coeff = {accel_fit.x.slope(), accel_fit.y.slope(), accel_fit.z.slope()};
+    accel_inter = {accel_fit.x.intercept(), accel_fit.y.intercept(), accel_fit.z.intercept()};
     accel_offset.x = static_cast<int8_t>(accel_inter.x / user_offset_weight);
     accel_offset.y = static_cast<int8_t>(accel_inter.y / user_offset_weight);
     accel_offset.z = static_cast<int8_t>((accel_inter.z - 1000.0f) / user_offset_weight);
-    write_byte(REG_X_OFS_USR, static_cast<uint8_t>(accel_offset.x));
-    write_byte(REG_Y_OFS_USR, static_cast<uint8_t>(accel_offset.y));
-    write_byte(REG_Z_OFS_USR, static_cast<uint8_t>(accel_offset.z));
+    write_accel_offset(accel_offset);
 
-    gyro_coeff.x = coeff_a(sum_gyro_xy.x, sum_gyro_y.x);
-    gyro_coeff.y = coeff_a(sum_gyro_xy.y, sum_gyro_y.y);
-    gyro_coeff.z = coeff_a(sum_gyro_xy.z, sum_gyro_y.z);
-    gyro_inter.x = inter_b(sum_gyro_xy.x, sum_gyro_y.x);
-    gyro_inter.y = inter_b(sum_gyro_xy.y, sum_gyro_y.y);
-    gyro_inter.z = inter_b(sum_gyro_xy.z, sum_gyro_y.z);
+    // 角速度は基準温度(平均温度)回りで直線近似する
+    const float mean_t = gyro_fit.z.mean_x();
+    const bool fit_temperature = max_t - min_t >= min_temperature_range;
+    auto slope = [&](const data::LinearRegression<float> &fit) { return fit_temperature ? fit.slope() : 0.0f; };
+    gyro_coeff = {slope(gyro_fit.x), slope(gyro_fit.y), slope(gyro_fit.z)};
+    gyro_inter = {gyro_fit.x.mean_y(), gyro_fit.y.mean_y(), gyro_fit.z.mean_y()};
 
     printf("Accel X: %f x + %f\n", static_cast<double>(accel_coeff.x), static_cast<double>(accel_inter.x));
     printf("Accel Y: %f x + %f\n", static_cast<double>(accel_coeff.y), static_cast<double>(accel_inter.y));
     printf("Accel Z: %f x + %f\n", static_cast<double>(accel_coeff.z), static_cast<double>(accel_inter.z));
     printf("%d, %d, %d\n", accel_offset.x, accel_offset.y, accel_offset.z);
 
-    printf("Gyro X: %f x + %f\n", static_cast<double>(gyro_coeff.x), static_cast<double>(gyro_inter.x));
-    printf("Gyro Y: %f x + %f\n", static_cast<double>(gyro_coeff.y), static_cast<double>(gyro_inter.y));
-    printf("Gyro Z: %f x + %f\n", static_cast<double>(gyro_coeff.z), static_cast<double>(gyro_inter.z));
+    printf("Temp: %f (%f ~ %f)\n", static_cast<double>(mean_t), static_cast<double>(min_t),
+           static_cast<double>(max_t));
+    printf("Gyro X: %f (t - %f) + %f\n", static_cast<double>(gyro_coeff.x), static_cast<double>(mean_t),
+           static_cast<double>(gyro_inter.x));
+    printf("Gyro Y: %f (t - %f) + %f\n", static_cast<double>(gyro_coeff.y), static_cast<double>(mean_t),
+           static_cast<double>(gyro_inter.y));
+    printf("Gyro Z: %f (t - %f) + %f\n", static_cast<double>(gyro_coeff.z), static_cast<double>(mean_t),
+           static_cast<double>(gyro_inter.z));
+
+    // 結果を反映してNVSに保存
+    Calibration calibration;
+    std::memset(&calibration, 0, sizeof(calibration));
+    calibration.version = CALIBRATION_VERSION;
+    calibration.accel_offset = accel_offset;
+    calibration.gyro_bias = gyro_inter;
+    calibration.gyro_slope = gyro_coeff;
+    calibration.temperature = mean_t;
+    calibration.checksum = checksum(calibration);
+    calibration_ = calibration;
+    return nvs_.write(CALIBRATION_KEY, calibration_);
   }
 
-  void calibration() { offset(10000); }
+  bool calibration() { return offset(10000); }
 };
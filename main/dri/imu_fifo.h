@@ -0,0 +1,143 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief LSM6DSRのFIFO出力を解析する
+ * @details
+ * FIFOは7byte単位 (TAG + DATA 6byte) で読み出される。
+ * タイムスタンプをバッチ毎に格納する設定で、
+ * TIMESTAMP -> GYRO -> ACCEL (GYRO/ACCELの順は不定) の順に並ぶ。
+ * 温度はバッチとは別の低いレートで挟まる。
+ * SPIに依存しないため、ホスト上でバイト列を与えてテストできる。
+ */
+class ImuFifo {
+ public:
+  // 1ワードのバイト数
+  static constexpr std::size_t WORD_SIZE = 7;
+  // 1回の読み出しで解析する最大サンプル数
+  static constexpr std::size_t MAX_SAMPLES = 16;
+  // タイムスタンプの分解能 [us/LSB]
+  static constexpr int64_t TIMESTAMP_RESOLUTION_US = 25;
+
+  // TAG_SENSOR
+  static constexpr uint8_t TAG_GYRO = 0x01;
+  static constexpr uint8_t TAG_ACCEL = 0x02;
+  static constexpr uint8_t TAG_TEMPERATURE = 0x03;
+  static constexpr uint8_t TAG_TIMESTAMP = 0x04;
+  static constexpr uint8_t TAG_CFG_CHANGE = 0x05;
+
+  // タイムスタンプ付きのサンプル
+  struct Sample {
+    // 計測時刻 [us]
+    int64_t timestamp;
+    int16_t gyro[3];
+    int16_t accel[3];
+  };
+
+ private:
+  // 解析済みのサンプル
+  std::array<Sample, MAX_SAMPLES> samples_;
+  std::size_t size_;
+
+  // 組み立て中のサンプル
+  Sample pending_;
+  bool has_timestamp_, has_gyro_, has_accel_;
+
+  // 最後に読み出した温度
+  int16_t temperature_;
+
+  // 読み出し時に溢れたサンプル数
+  uint32_t dropped_;
+
+  static int16_t to_int16(const uint8_t *p) { return static_cast<int16_t>(p[0] | (p[1] << 8)); }
+  static uint32_t to_uint32(const uint8_t *p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 |
+           static_cast<uint32_t>(p[3]) << 24;
+  }
+
+  // 組み立て中のサンプルを確定する
+  void commit() {
+    if (has_timestamp_ && has_gyro_ && has_accel_) {
+      if (size_ < MAX_SAMPLES) {
+        samples_[size_++] = pending_;
+      } else {
+        dropped_++;
+      }
+    }
+    has_gyro_ = false;
+    has_accel_ = false;
+  }
+
+ public:
+  explicit ImuFifo()
+      : samples_(),
+        size_(0),
+        pending_(),
+        has_timestamp_(false),
+        has_gyro_(false),
+        has_accel_(false),
+        temperature_(0),
+        dropped_(0) {}
+  ~ImuFifo() = default;
+
+  void reset() {
+    size_ = 0;
+    has_timestamp_ = false;
+    has_gyro_ = false;
+    has_accel_ = false;
+    dropped_ = 0;
+  }
+
+  /**
+   * @brief FIFOから読み出したバイト列を解析する
+   * @param data FIFO_DATA_OUT_TAG(78h)から連続で読み出したバイト列
+   * @param length バイト数 (WORD_SIZEの倍数)
+   * @return 確定したサンプル数
+   * @details 前回の解析結果は破棄される。読み出しをまたいだサンプルは次回に確定する。
+   */
+  std::size_t parse(const uint8_t *data, std::size_t length) {
+    size_ = 0;
+    for (std::size_t i = 0; i + WORD_SIZE <= length; i += WORD_SIZE) {
+      const uint8_t *word = data + i;
+      const uint8_t tag = word[0] >> 3;
+      const uint8_t *payload = word + 1;
+      switch (tag) {
+        case TAG_TIMESTAMP:
+          // 新しいバッチの開始
+          commit();
+          pending_.timestamp = static_cast<int64_t>(to_uint32(payload)) * TIMESTAMP_RESOLUTION_US;
+          has_timestamp_ = true;
+          break;
+        case TAG_GYRO:
+          for (int axis = 0; axis < 3; axis++) pending_.gyro[axis] = to_int16(payload + axis * 2);
+          has_gyro_ = true;
+          break;
+        case TAG_ACCEL:
+          for (int axis = 0; axis < 3; axis++) pending_.accel[axis] = to_int16(payload + axis * 2);
+          has_accel_ = true;
+          break;
+        case TAG_TEMPERATURE:
+          temperature_ = to_int16(payload);
+          break;
+        default:
+          // 設定変更などは読み捨て
+          break;
+      }
+      // 揃ったら次のタイムスタンプを待たずに確定する
+      if (has_gyro_ && has_accel_) commit();
+    }
+    return size_;
+  }
+
+  // 確定したサンプル
+  [[nodiscard]] std::span<const Sample> samples() const { return {samples_.data(), size_}; }
+  // 最後に読み出した温度 (OUT_TEMPと同じ形式)
+  [[nodiscard]] int16_t temperature() const { return temperature_; }
+  // バッファに入りきらず捨てたサンプル数
+  [[nodiscard]] uint32_t dropped() const { return dropped_; }
+};
@@ -1,6 +1,7 @@
 #pragma once
 
 // C++
+#include <algorithm>
 #include <cmath>
 
 // ESP-IDF
@@ -113,7 +114,8 @@ class Motor {
     auto duty = static_cast<float>(motor_voltage) / static_cast<float>(battery_voltage);
     mcpwm_generator_set_force_level(generator_.a, duty < 0.0f ? 0 : -1, true);
     mcpwm_generator_set_force_level(generator_.b, duty < 0.0f ? -1 : 0, true);
-    auto duty_ticks = static_cast<uint32_t>(MCPWM_TIMER_PERIOD_TICKS * std::abs(duty));
+    // バッテリー電圧を超える指令はデューティ比100%で頭打ち
+    auto duty_ticks = static_cast<uint32_t>(MCPWM_TIMER_PERIOD_TICKS * std::min(std::abs(duty), 1.0f));
     mcpwm_comparator_set_compare_value(comparator_.a, duty_ticks);
     mcpwm_comparator_set_compare_value(comparator_.b, duty_ticks);
   }
@@ -0,0 +1,41 @@
+#pragma once
+
+// ESP-IDF
+#include <nvs.h>
+#include <nvs_flash.h>
+
+class Nvs {
+ private:
+  static constexpr auto NAMESPACE = "mm-bluelight";
+
+  nvs_handle_t handle_;
+
+ public:
+  explicit Nvs() : handle_() {
+    // 初期化 (領域が壊れている、またはバージョンが異なる場合は消去する)
+    esp_err_t init_err = nvs_flash_init();
+    if (init_err == ESP_ERR_NVS_NO_FREE_PAGES || init_err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+      ESP_ERROR_CHECK(nvs_flash_erase());
+      init_err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(init_err);
+    ESP_ERROR_CHECK(nvs_open(NAMESPACE, NVS_READWRITE, &handle_));
+  }
+  ~Nvs() { nvs_close(handle_); }
+
+  // 読み込み (キーが存在しない、またはサイズが異なる場合はfalse)
+  template <typename T>
+  bool read(const char *key, T &value) {
+    size_t length = sizeof(T);
+    esp_err_t get_err = nvs_get_blob(handle_, key, &value, &length);
+    return get_err == ESP_OK && length == sizeof(T);
+  }
+
+  // 書き込み
+  template <typename T>
+  bool write(const char *key, const T &value) {
+    esp_err_t set_err = nvs_set_blob(handle_, key, &value, sizeof(T));
+    esp_err_t commit_err = nvs_commit(handle_);
+    return set_err == ESP_OK && commit_err == ESP_OK;
+  }
+};
@@ -34,9 +34,9 @@ class RingBuffer {
   }
 
   // 最大要素数を返す
-  constexpr std::size_t max_size() { return N; }
+  constexpr std::size_t max_size() const { return N; }
   // 現在の要素数を返す
-  std::size_t size() { return size_; }
+  std::size_t size() const { return size_; }
 
   // 添字アクセス (読み)
   const T &operator[](std::size_t index) const { return buffer_[(head_ + index) & mask_]; }
@@ -0,0 +1,84 @@
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace data {
+/**
+ * @brief シーケンス番号で一貫性を保証する、書き込み1つ・読み出し複数の共有値
+ * @details
+ * 書き込み側は待たずに (wait-free) 最新値を公開し、読み出し側は書き込み中に読んだ場合だけ読み直す。
+ * 値は32bitのatomicに分けて保持するため、コア間で同時にアクセスしてもデータ競合にならない。
+ * 書き込みは1つのタスクからのみ行うこと。
+ */
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+class SeqLock {
+ private:
+  // 値を保持するワード数
+  static constexpr std::size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+  // シーケンス番号 (奇数の間は書き込み中)
+  std::atomic<uint32_t> sequence_;
+  // 公開中の値
+  std::array<std::atomic<uint32_t>, WORDS> words_;
+
+ public:
+  explicit SeqLock() : sequence_(0), words_() { store(T{}); }
+  explicit SeqLock(const T &value) : sequence_(0), words_() { store(value); }
+  ~SeqLock() = default;
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  /**
+   * @brief 値を公開する (書き込み側)
+   */
+  void store(const T &value) {
+    std::array<uint32_t, WORDS> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < WORDS; i++) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief 一度だけ読み出しを試みる (読み出し側)
+   * @return 書き込みと重ならずに読めた場合はtrue
+   */
+  bool try_load(T &value) const {
+    std::array<uint32_t, WORDS> words{};
+    auto before = sequence_.load(std::memory_order_acquire);
+    if ((before & 1) != 0) return false;
+    for (std::size_t i = 0; i < WORDS; i++) {
+      words[i] = words_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) return false;
+    std::memcpy(&value, words.data(), sizeof(T));
+    return true;
+  }
+
+  /**
+   * @brief 一貫した値を読み出す (読み出し側)
+   * @details 書き込み中に読んだ場合は読み直す
+   */
+  [[nodiscard]] T load() const {
+    T value;
+    while (!try_load(value)) {
+    }
+    return value;
+  }
+
+  // 公開した回数 (コンストラクタでの初期化を含む)
+  [[nodiscard]] uint32_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+};
+}  // namespace data
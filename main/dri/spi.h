@@ -70,5 +70,11 @@ class Spi {
     esp_err_t transmit_err = spi_device_transmit(device->handle, device->transaction);
     return transmit_err == ESP_OK;
   }
+  // 割り込みを使わずに転送する (短い転送を高い頻度で行う場合に使う)
+  bool polling_transmit(int index) {
+    auto device = devices_[index];
+    esp_err_t transmit_err = spi_device_polling_transmit(device->handle, device->transaction);
+    return transmit_err == ESP_OK;
+  }
   spi_transaction_t *transaction(int index) { return devices_[index]->transaction; }
 };
@@ -0,0 +1,121 @@
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace data {
+/**
+ * @brief 送信1つ・受信1つのタスク間で使う待ちなし (wait-free) のキュー
+ * @details
+ * カーネルのクリティカルセクションを使わず、送信側はtail、受信側はheadだけを書き換える。
+ * 互いの添字は別のキャッシュラインに置き、相手の添字は空/満杯に見えた時だけ読み直す。
+ * rtos::Queueと同じ名前のメソッドを持つが、待ち時間は指定できず、すぐに結果を返す。
+ * 長さ1で最新値だけを渡したい場合 (rtos::Queue::overwrite) はSeqLockを使う。
+ */
+template <typename T, std::size_t N>
+class SpscQueue {
+ private:
+  static_assert(N && (N & (N - 1)) == 0, "N must be a power of 2.");
+  // キャッシュラインの大きさ
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+  // 添字を最大要素数で切り捨てるマスク
+  static constexpr std::size_t MASK = N - 1;
+
+  // 受信側: 先頭を指す添字 (折り返さずに増え続ける)
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_;
+  // 受信側: 最後に読んだtail
+  std::size_t tail_cache_;
+  // 送信側: 末尾を指す添字 (折り返さずに増え続ける)
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_;
+  // 送信側: 最後に読んだhead
+  std::size_t head_cache_;
+  // 要素を保持する配列
+  alignas(CACHE_LINE_SIZE) std::array<T, N> buffer_;
+
+ public:
+  explicit SpscQueue() : head_(0), tail_cache_(0), tail_(0), head_cache_(0), buffer_() {}
+  ~SpscQueue() = default;
+  SpscQueue(const SpscQueue &) = delete;
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  // 溜まっている要素を捨てる (受信側から呼ぶ)
+  void reset() {
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+    head_.store(tail_cache_, std::memory_order_release);
+  }
+
+  // 送信 (満杯の場合はfalse)
+  bool send(const T *item) {
+    auto tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_cache_ == N) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (tail - head_cache_ == N) {
+        return false;
+      }
+    }
+    buffer_[tail & MASK] = *item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 受信 (空の場合はfalse)
+  bool receive(T *const item) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (!readable(head)) {
+      return false;
+    }
+    *item = buffer_[head & MASK];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // 先頭アイテムを取得 (空の場合はfalse)
+  bool peek(T *item) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (!readable(head)) {
+      return false;
+    }
+    *item = buffer_[head & MASK];
+    return true;
+  }
+
+  // 先頭からindex番目のアイテムを取得 (受信側から呼ぶ、なければfalse)
+  bool peek(std::size_t index, T *item) {
+    auto head = head_.load(std::memory_order_relaxed);
+    if (tail_cache_ - head <= index) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (tail_cache_ - head <= index) {
+        return false;
+      }
+    }
+    *item = buffer_[(head + index) & MASK];
+    return true;
+  }
+
+  // 待ちアイテム数を取得 (headを先に読めばtailを追い越さない)
+  std::size_t waiting() const {
+    auto head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  // 空きアイテム数を取得
+  std::size_t available() const { return N - waiting(); }
+
+  // 最大要素数を返す
+  static constexpr std::size_t max_size() { return N; }
+
+ private:
+  // 受信側から見て読める要素があるか
+  bool readable(std::size_t head) {
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+}  // namespace data
@@ -0,0 +1,92 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <numbers>
+
+/**
+ * @brief 制御周期内で使う固定コストの三角関数
+ * @details
+ * 象限で[-π/4, π/4]に縮約し、テイラー級数の多項式で近似する。
+ * 分岐は象限の選択のみで、libmのように引数によって処理時間が変わらない。
+ * |x| <= 1000 [rad] での絶対誤差は 5e-7 以下 (test/odometryで確認)。
+ */
+namespace fastmath {
+struct SinCos {
+  float sin;
+  float cos;
+};
+
+namespace detail {
+// π/2を3つに分けた値 (上位ほど仮数部が短く、象限との積が丸められない)
+constexpr float PI_2_HI = 1.5703125f;
+constexpr float PI_2_MID = 4.837512969970703125e-4f;
+constexpr float PI_2_LO = 7.54978995489188216e-8f;
+
+// [-π/4, π/4]でのsin (打ち切り誤差 (π/4)^9/9! < 4e-7)
+constexpr float sin_poly(float x) {
+  const float x2 = x * x;
+  return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f))));
+}
+
+// [-π/4, π/4]でのcos (打ち切り誤差 (π/4)^10/10! < 3e-8)
+constexpr float cos_poly(float x) {
+  const float x2 = x * x;
+  return 1.0f + x2 * (-1.0f / 2.0f + x2 * (1.0f / 24.0f + x2 * (-1.0f / 720.0f + x2 * (1.0f / 40320.0f))));
+}
+}  // namespace detail
+
+/**
+ * @brief sinとcosを同時に計算する
+ * @param x 角度 [rad]
+ */
+constexpr SinCos sincos(float x) {
+  // 最も近いπ/2の倍数を求めて縮約
+  const float q = x * (2.0f / std::numbers::pi_v<float>);
+  const auto quadrant = static_cast<int32_t>(q >= 0.0f ? q + 0.5f : q - 0.5f);
+  const auto n = static_cast<float>(quadrant);
+  const float r = ((x - n * detail::PI_2_HI) - n * detail::PI_2_MID) - n * detail::PI_2_LO;
+  const float s = detail::sin_poly(r);
+  const float c = detail::cos_poly(r);
+  switch (quadrant & 3) {
+    default:
+    case 0:
+      return {s, c};
+    case 1:
+      return {c, -s};
+    case 2:
+      return {-s, -c};
+    case 3:
+      return {-c, s};
+  }
+}
+
+constexpr float sin(float x) { return sincos(x).sin; }
+constexpr float cos(float x) { return sincos(x).cos; }
+
+/**
+ * @brief 微小角のsin(x)/xを計算する
+ * @param x 角度 [rad] (|x| <= 0.1 で打ち切り誤差 2e-9 以下)
+ */
+constexpr float sinc_small(float x) {
+  const float x2 = x * x;
+  return 1.0f - x2 * (1.0f / 6.0f - x2 * (1.0f / 120.0f));
+}
+
+/**
+ * @brief 微小角のsinとcosを計算する
+ * @param x 角度 [rad] (|x| <= 0.1 で打ち切り誤差 2e-9 以下)
+ */
+constexpr SinCos sincos_small(float x) {
+  const float x2 = x * x;
+  return {x * sinc_small(x), 1.0f - x2 * (1.0f / 2.0f - x2 * (1.0f / 24.0f))};
+}
+
+/**
+ * @brief 角度aのsin/cosを角度bだけ回転する (加法定理)
+ * @return a + b のsin/cos
+ */
+constexpr SinCos rotate(const SinCos &a, const SinCos &b) {
+  return {a.sin * b.cos + a.cos * b.sin, a.cos * b.cos - a.sin * b.sin};
+}
+}  // namespace fastmath
@@ -0,0 +1,82 @@
+#pragma once
+
+// C++
+#include <numbers>
+
+// Project
+#include "parameters.h"
+
+/**
+ * @brief 目標の速度・加速度から各モーターの電圧を求める (フィードフォワード)
+ * @details
+ * Odometryのオブザーバと同じく、モーターを1次遅れ dv/dt = (V / K - v) / T とみなし、
+ * その逆モデル V = K (v + T dv/dt) に動き出す向きの摩擦電圧を足す。
+ * Kは逆起電圧定数・ギア比・タイヤ径から決まり、Tは並進と旋回で別の時定数を使う。
+ * PIDはモデルとの差だけを補正すればよい。
+ */
+class Feedforward {
+ public:
+  // 設定
+  struct Config {
+    // 並進の機械的時定数 [s]
+    float time_constant;
+    // 旋回の機械的時定数 [s]
+    float angular_time_constant;
+    // 摩擦電圧 [V]
+    float friction;
+    // トレッド [m]
+    float tread;
+  };
+
+  // 左右のモーター電圧 [V]
+  struct Voltage {
+    float right;
+    float left;
+  };
+
+  // タイヤの速度あたりの逆起電圧 [V/(m/s)]
+  static constexpr float VELOCITY_CONSTANT =
+      MOTOR_KE * GEAR_RATIO * 60.0f / (std::numbers::pi_v<float> * TIRE_DIAMETER / 1000.0f) / 1000.0f;
+
+  explicit Feedforward()
+      : config_({
+            .time_constant = MOTOR_TIME_CONSTANT,
+            .angular_time_constant = MOTOR_ANGULAR_TIME_CONSTANT,
+            .friction = MOTOR_FRICTION_VOLTAGE,
+            .tread = TREAD_WIDTH / 1000.0f,
+        }) {}
+  explicit Feedforward(const Config &config) : config_(config) {}
+  ~Feedforward() = default;
+
+  /**
+   * @param velocity 速度 [m/s]
+   * @param acceleration 加速度 [m/s^2]
+   * @param angular_velocity 角速度 [rad/s] (左回りが正)
+   * @param angular_acceleration 角加速度 [rad/s^2]
+   * @return 左右のモーター電圧 [V]
+   */
+  [[nodiscard]] Voltage update(float velocity, float acceleration, float angular_velocity,
+                               float angular_acceleration) const {
+    auto half = config_.tread / 2.0f;
+    // 並進と旋回で慣性が違うので、時定数を分けて加速分を足す
+    auto linear = velocity + config_.time_constant * acceleration;
+    auto angular = (angular_velocity + config_.angular_time_constant * angular_acceleration) * half;
+    return {
+        VELOCITY_CONSTANT * (linear + angular) + friction(velocity + angular_velocity * half),
+        VELOCITY_CONSTANT * (linear - angular) + friction(velocity - angular_velocity * half),
+    };
+  }
+
+  [[nodiscard]] const Config &config() const { return config_; }
+
+ private:
+  //! 設定
+  Config config_;
+
+  // 回る向きの摩擦電圧
+  [[nodiscard]] float friction(float wheel_velocity) const {
+    if (wheel_velocity > 0.0f) return config_.friction;
+    if (wheel_velocity < 0.0f) return -config_.friction;
+    return 0.0f;
+  }
+};
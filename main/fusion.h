@@ -0,0 +1,136 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+
+/**
+ * @brief 相補フィルタ
+ * @details
+ * 微分値(加速度など)の積分で予測し、計測値(速度など)で補正する。
+ * 時定数より速い変化は微分値の積分を、遅い変化は計測値を信頼する。
+ */
+template <std::floating_point T>
+class ComplementaryFilter {
+ private:
+  // 推定値
+  T value_;
+  // 初回かどうか
+  bool empty_;
+
+ public:
+  explicit ComplementaryFilter() : value_(), empty_(true) {}
+  ~ComplementaryFilter() = default;
+
+  void reset() { empty_ = true; }
+
+  /**
+   * @param measurement 計測値
+   * @param derivative 微分値
+   * @param time_constant 時定数 [s]
+   * @param dt 更新周期 [s]
+   * @return 推定値
+   */
+  T update(T measurement, T derivative, T time_constant, T dt) {
+    if (empty_) [[unlikely]] {
+      value_ = measurement;
+      empty_ = false;
+      return value_;
+    }
+    const T alpha = time_constant / (time_constant + dt);
+    value_ = alpha * (value_ + derivative * dt) + (static_cast<T>(1) - alpha) * measurement;
+    return value_;
+  }
+
+  [[nodiscard]] T value() const { return value_; }
+};
+
+/**
+ * @brief エンコーダーとIMUを融合して車体速度を推定し、スリップを検出する
+ * @details
+ * 並進: エンコーダー速度と加速度計を相補フィルタで融合する。
+ * スリップの検出: エンコーダー速度と推定速度の差、
+ * およびエンコーダーの左右差から求めた角速度とジャイロの差をそれぞれ平滑化し、
+ * しきい値で正規化した大きい方をスリップ指標とする。
+ * スリップ中はエンコーダーを信頼しないよう時定数を伸ばす。
+ */
+template <std::floating_point T>
+class VelocityFusion {
+ public:
+  struct Config {
+    // トレッド幅 [mm]
+    T tread_width;
+    // 相補フィルタの時定数 [s]
+    T time_constant;
+    // スリップ中の相補フィルタの時定数 [s]
+    T slip_time_constant;
+    // スリップ指標の平滑化時定数 [s]
+    T slip_filter_time_constant;
+    // スリップとみなす並進速度差 [mm/s]
+    T slip_velocity;
+    // スリップとみなす角速度差 [rad/s]
+    T slip_angular_velocity;
+  };
+
+ private:
+  Config config_;
+  // 並進速度
+  ComplementaryFilter<T> velocity_;
+  // 並進速度の残差 (平滑化)
+  T velocity_residual_;
+  // 角速度の残差 (平滑化)
+  T angular_velocity_residual_;
+  // スリップ指標
+  T slip_;
+
+  // 1次遅れで平滑化する
+  T smooth(T current, T sample, T dt) const {
+    const T alpha = dt / (config_.slip_filter_time_constant + dt);
+    return current + alpha * (sample - current);
+  }
+
+ public:
+  explicit VelocityFusion(const Config &config) : config_(config) { reset(); }
+  ~VelocityFusion() = default;
+
+  void reset() {
+    velocity_.reset();
+    velocity_residual_ = static_cast<T>(0);
+    angular_velocity_residual_ = static_cast<T>(0);
+    slip_ = static_cast<T>(0);
+  }
+
+  /**
+   * @param velocity_right 右車輪速度 [mm/s]
+   * @param velocity_left 左車輪速度 [mm/s]
+   * @param acceleration 前後方向の加速度 [mm/s^2]
+   * @param angular_velocity ジャイロの角速度 [rad/s]
+   * @param dt 更新周期 [s]
+   * @return 推定した車体速度 [mm/s]
+   */
+  T update(T velocity_right, T velocity_left, T acceleration, T angular_velocity, T dt) {
+    const T encoder_velocity = (velocity_right + velocity_left) / static_cast<T>(2);
+    const T encoder_angular_velocity = (velocity_right - velocity_left) / config_.tread_width;
+
+    // スリップ中は加速度の積分を優先する
+    const bool slipping = slip_ > static_cast<T>(1);
+    const T time_constant = slipping ? config_.slip_time_constant : config_.time_constant;
+    const T predicted = velocity_.value() + acceleration * dt;
+    velocity_.update(encoder_velocity, acceleration, time_constant, dt);
+
+    // 残差を平滑化してスリップ指標を計算
+    velocity_residual_ = smooth(velocity_residual_, encoder_velocity - predicted, dt);
+    angular_velocity_residual_ =
+        smooth(angular_velocity_residual_, encoder_angular_velocity - angular_velocity, dt);
+    slip_ = std::max(std::fabs(velocity_residual_) / config_.slip_velocity,
+                     std::fabs(angular_velocity_residual_) / config_.slip_angular_velocity);
+    return velocity_.value();
+  }
+
+  // 推定した車体速度 [mm/s]
+  [[nodiscard]] T velocity() const { return velocity_.value(); }
+  // スリップ指標 (1を超えるとスリップ)
+  [[nodiscard]] T slip() const { return slip_; }
+  [[nodiscard]] bool slipping() const { return slip_ > static_cast<T>(1); }
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+// C++
+#include <cmath>
+#include <cstdint>
+
+// Project
+#include "dri/average.h"
+#include "dri/ringbuffer.h"
+
+/**
+ * @brief 静止中の角速度からジャイロのバイアスを推定する
+ * @details
+ * 左右車輪が止まっていて、加速度のばらつきが小さい間を静止とみなす。
+ * 静止が一定時間続いたら、その間のz軸角速度の平均をWelfordのアルゴリズムで求め、
+ * それまでの推定値と重み付きで合成する。
+ * 走行中は推定値を保持するため、停止する度にドリフトへ追従する。
+ */
+class GyroBias {
+ public:
+  // 静止とみなす車輪速度 [mm/s]
+  static constexpr float STILL_VELOCITY = 2.0f;
+  // 静止とみなす加速度の分散 [mg^2]
+  static constexpr float STILL_ACCELERATION_VARIANCE = 25.0f;
+  // 静止とみなす角速度 [rad/s] (推定値からの差)
+  static constexpr float STILL_ANGULAR_VELOCITY = 0.2f;
+  // 加速度の分散を計算する窓幅
+  static constexpr std::size_t VARIANCE_WINDOW = 64;
+  // 静止してから推定を始めるまでの回数
+  static constexpr uint32_t SETTLE_COUNTS = 100;
+  // 推定値を更新するのに必要なサンプル数
+  static constexpr std::size_t MIN_SAMPLES = 200;
+  // それまでの推定値の重み (サンプル数換算)
+  static constexpr float PRIOR_WEIGHT = 1000.0f;
+
+  explicit GyroBias() { reset(); }
+  ~GyroBias() = default;
+
+  /**
+   * @brief 推定値を初期化する
+   * @param bias 初期バイアス [rad/s]
+   */
+  void reset(float bias = 0.0f) {
+    bias_ = bias;
+    prior_ = bias;
+    prior_weight_ = 0.0f;
+    still_counts_ = 0;
+    window_.reset();
+    accel_.reset();
+  }
+
+  /**
+   * @brief 推定値を更新する
+   * @param angular_velocity 補正前の角速度 [rad/s]
+   * @param velocity_right 右車輪速度 [mm/s]
+   * @param velocity_left 左車輪速度 [mm/s]
+   * @param acceleration 加速度の大きさ [mg]
+   * @return 静止中かどうか
+   */
+  bool update(float angular_velocity, float velocity_right, float velocity_left, float acceleration) {
+    // 加速度の分散 (1Gの2乗に対して差が小さいため、窓内で2パスで計算する)
+    if (accel_.size() == accel_.max_size()) accel_.popFront();
+    accel_.pushBack(acceleration);
+    float mean = 0.0f, variance = 0.0f;
+    for (std::size_t i = 0; i < accel_.size(); i++) mean += accel_[i];
+    mean /= static_cast<float>(accel_.size());
+    for (std::size_t i = 0; i < accel_.size(); i++) variance += (accel_[i] - mean) * (accel_[i] - mean);
+    variance /= static_cast<float>(accel_.size());
+
+    bool still = std::fabs(velocity_right) < STILL_VELOCITY && std::fabs(velocity_left) < STILL_VELOCITY &&
+                 variance < STILL_ACCELERATION_VARIANCE &&
+                 std::fabs(angular_velocity - bias_) < STILL_ANGULAR_VELOCITY;
+    if (!still) {
+      // 動き出したら、それまでの推定値を次の事前値とする
+      if (window_.count() >= MIN_SAMPLES) {
+        prior_ = bias_;
+        prior_weight_ = PRIOR_WEIGHT;
+      }
+      still_counts_ = 0;
+      window_.reset();
+      return false;
+    }
+
+    // 静止直後は車体の揺れが残るため読み捨てる
+    if (still_counts_ < SETTLE_COUNTS) {
+      still_counts_++;
+      return true;
+    }
+    window_.update(angular_velocity);
+    if (window_.count() >= MIN_SAMPLES) {
+      auto n = static_cast<float>(window_.count());
+      bias_ = (prior_weight_ * prior_ + n * window_.mean()) / (prior_weight_ + n);
+    }
+    return true;
+  }
+
+  // バイアス推定値 [rad/s]
+  [[nodiscard]] float bias() const { return bias_; }
+  // 今回の静止区間での角速度の分散 [(rad/s)^2]
+  [[nodiscard]] float variance() const { return window_.variance(); }
+  // 推定値が一度でも更新されたか
+  [[nodiscard]] bool valid() const { return prior_weight_ > 0.0f || window_.count() >= MIN_SAMPLES; }
+
+ private:
+  //! バイアス推定値 [rad/s]
+  float bias_;
+  //! 前回の静止区間までの推定値 [rad/s]
+  float prior_;
+  //! 前回までの推定値の重み
+  float prior_weight_;
+  //! 静止が続いている回数
+  uint32_t still_counts_;
+  //! 今回の静止区間の角速度
+  data::Welford<float> window_;
+  //! 分散を計算する加速度の窓
+  data::RingBuffer<float, VARIANCE_WINDOW> accel_;
+};
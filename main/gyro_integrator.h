@@ -0,0 +1,46 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <span>
+
+// Project
+#include "dri/imu_fifo.h"
+
+/**
+ * @brief IMUのFIFOのサンプルを計測時刻の間隔で積分して角度の変化を求める
+ * @details
+ * 各サンプルは前のサンプルからの間隔で積分するため、制御周期にサンプルが届かなかった場合は0を返す。
+ * その間の角度は次に届いたサンプルでまとめて積分されるので、制御周期で補うと二重に数えてしまう。
+ */
+class GyroIntegrator {
+ public:
+  explicit GyroIntegrator() { reset(); }
+  ~GyroIntegrator() = default;
+
+  // 前のサンプルを忘れる (次のサンプルからの間隔で積分し直す)
+  void reset() { timestamp_ = -1; }
+
+  /**
+   * @brief 届いたサンプルを積分する
+   * @param samples 前回から届いたサンプル (計測時刻の順)
+   * @param rate サンプルから角速度 [rad/s] を求める関数
+   * @return 角度の変化 [rad]
+   */
+  template <typename F>
+  float update(std::span<const ImuFifo::Sample> samples, F rate) {
+    auto delta_angle = 0.0f;
+    for (const auto &sample : samples) {
+      if (timestamp_ >= 0) {
+        auto interval = static_cast<float>(sample.timestamp - timestamp_) / 1000'000.0f;
+        delta_angle += rate(sample) * interval;
+      }
+      timestamp_ = sample.timestamp;
+    }
+    return delta_angle;
+  }
+
+ private:
+  //! 最後に積分したサンプルの計測時刻 [us]
+  int64_t timestamp_;
+};
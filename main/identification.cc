@@ -0,0 +1,145 @@
+#include "identification.h"
+
+// C++
+#include <algorithm>
+#include <cstdio>
+#include <new>
+
+// Project
+#include "parameters.h"
+
+// 制御周期 [s]
+static constexpr float CONTROL_PERIOD = 1.0f / static_cast<float>(CONTROL_FREQUENCY);
+
+// コンストラクタ
+Identification::Identification(Driver *dri, Sensor *sensor)
+    : driver_(dri),
+      sensor_(sensor),
+      log_(nullptr),
+      mode_(Mode::Excitation),
+      axis_(sysid::Axis::Translation),
+      configs_(nullptr),
+      count_(0),
+      index_(0),
+      rest_(0),
+      running_(false) {}
+// デストラクタ
+Identification::~Identification() { delete log_; }
+
+// 入力信号の列を始める
+bool Identification::start(const sysid::Config *configs, std::size_t count) {
+  if (isRunning() || count > MAX_RUNS) return false;
+  std::size_t ticks = 0;
+  for (std::size_t i = 0; i < count; i++) ticks += configs[i].ticks;
+  if (ticks > LOG_SIZE) return false;
+
+  // 前の記録を出力していなければ使い回す
+  if (log_ == nullptr) {
+    log_ = new (std::nothrow) Log();
+    if (log_ == nullptr) return false;
+  }
+  log_->clear();
+  mode_ = Mode::Excitation;
+  configs_ = configs;
+  count_ = count;
+  index_ = 0;
+  rest_ = 0;
+  excitation_.start(configs_[index_++], CONTROL_PERIOD);
+  log_->begin(excitation_.config());
+  running_.store(true, std::memory_order_release);
+  return true;
+}
+
+// リレー帰還の実験を始める
+bool Identification::startRelay(sysid::Axis axis, const autotune::Config &config) {
+  if (isRunning()) return false;
+  mode_ = Mode::Relay;
+  axis_ = axis;
+  relay_.start(config);
+  running_.store(true, std::memory_order_release);
+  return true;
+}
+
+// 更新
+void Identification::update() {
+  if (!isRunning()) return;
+
+  auto sensed = sensor_->getSensed();
+  // 電圧が低い場合は止める
+  if (static_cast<float>(sensed.battery_voltage_average) < VOLTAGE_LOW_LIMIT * 1000.0f) {
+    finish();
+    return;
+  }
+  if (mode_ == Mode::Relay) {
+    updateRelay(sensed);
+  } else {
+    updateExcitation(sensed);
+  }
+}
+
+void Identification::updateExcitation(const Sensed &sensed) {
+  // 信号の間は止まるのを待つ
+  if (rest_ > 0) {
+    if (--rest_ == 0) next();
+    return;
+  }
+
+  auto voltage = excitation_.update();
+  driver_->motor_right->speed(static_cast<int>(voltage.right * 1000.0f), sensed.battery_voltage_average);
+  driver_->motor_left->speed(static_cast<int>(voltage.left * 1000.0f), sensed.battery_voltage_average);
+  log_->push({voltage.right, voltage.left, sensed.velocity, sensed.angular_velocity});
+
+  if (excitation_.finished()) {
+    driver_->motor_right->coast();
+    driver_->motor_left->coast();
+    if (index_ < count_) {
+      rest_ = REST_TICKS;
+    } else {
+      finish();
+    }
+  }
+}
+
+void Identification::updateRelay(const Sensed &sensed) {
+  auto measurement = axis_ == sysid::Axis::Translation ? sensed.velocity : sensed.angular_velocity;
+  auto voltage = std::clamp(relay_.update(measurement, CONTROL_PERIOD), -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+  if (relay_.finished()) {
+    finish();
+    return;
+  }
+  // 旋回は左回りが正なので右に正の電圧をかける
+  auto left = axis_ == sysid::Axis::Translation ? voltage : -voltage;
+  driver_->motor_right->speed(static_cast<int>(voltage * 1000.0f), sensed.battery_voltage_average);
+  driver_->motor_left->speed(static_cast<int>(left * 1000.0f), sensed.battery_voltage_average);
+}
+
+void Identification::next() {
+  excitation_.start(configs_[index_++], CONTROL_PERIOD);
+  log_->begin(excitation_.config());
+}
+
+void Identification::finish() {
+  driver_->motor_right->coast();
+  driver_->motor_left->coast();
+  running_.store(false, std::memory_order_release);
+}
+
+// 記録をCSVで表示して解放する
+bool Identification::print() {
+  if (isRunning() || log_ == nullptr) return false;
+  // 1行目は制御周波数 (tools/sysidが読む)
+  printf("# sysid %u\n", static_cast<unsigned>(CONTROL_FREQUENCY));
+  printf("run,signal,axis,right,left,velocity,angular_velocity\n");
+  for (std::size_t r = 0; r < log_->runs(); r++) {
+    const auto &run = log_->run(r);
+    for (std::size_t i = run.begin; i < run.begin + run.size; i++) {
+      const auto &s = log_->sample(i);
+      printf("%u,%s,%s,%.4f,%.4f,%.5f,%.4f\n", static_cast<unsigned>(r), sysid::name(run.config.signal),
+             sysid::name(run.config.axis), static_cast<double>(s.right), static_cast<double>(s.left),
+             static_cast<double>(s.velocity), static_cast<double>(s.angular_velocity));
+    }
+  }
+  delete log_;
+  log_ = nullptr;
+  return true;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Project
+#include "autotune.h"
+#include "dri/driver.h"
+#include "parameters.h"
+#include "sensor.h"
+#include "sysid.h"
+
+/**
+ * システム同定のためにモーターを直接動かすクラス
+ * @details
+ * start()で入力信号の列を渡すと、制御周期ごとのupdate()で順に電圧を与え、応答をRAMに記録する。
+ * 動かしている間はMotionの代わりにupdate()を呼ぶ (モーターを取り合わないように)。
+ * 信号の間はモーターを解放して止まるのを待つ。記録はprint()でCSVとして出力し、tools/sysidで解析する。
+ * 記録は大きいので、start()でヒープに確保し、print()で出力した後に解放する。
+ * startRelay()では1つの軸でリレー帰還の実験を行い、PIDの自動調整に使う限界ゲイン・周期を測る。
+ */
+class Identification {
+ public:
+  // 記録できる周期の数 (1周期16バイト、制御周波数によらず約4秒分。4 kHzでは256 KBになり確保できないことがある)
+  static constexpr std::size_t LOG_SIZE = 4096 * CONTROL_FREQUENCY / 1'000;
+  // 記録できる信号の数
+  static constexpr std::size_t MAX_RUNS = 8;
+  // 信号の間に止まるのを待つ周期の数
+  static constexpr uint32_t REST_TICKS = 500;
+
+  using Log = sysid::Log<LOG_SIZE, MAX_RUNS>;
+
+  explicit Identification(Driver *dri, Sensor *sensor);
+  ~Identification();
+
+  /**
+   * @brief 入力信号の列を始める (Core 1から呼ぶ)
+   * @param configs 入力信号の列 (終わるまで保持すること)
+   * @return 動作中、記録に入り切らない、または記録を確保できない場合はfalse
+   */
+  bool start(const sysid::Config *configs, std::size_t count);
+
+  /**
+   * @brief リレー帰還の実験を始める (Core 1から呼ぶ)
+   * @return 動作中の場合はfalse
+   */
+  bool startRelay(sysid::Axis axis, const autotune::Config &config);
+
+  // 更新 (動作中は制御周期ごとにMotionの代わりに呼ぶ)
+  void update();
+
+  // 動作中かどうか
+  bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+  // 記録をCSVで表示して解放する (動作中、または記録がない場合はfalse)
+  bool print();
+
+  // リレー帰還の実験の結果 (終わった後に読む)
+  const autotune::RelayTuner &getRelay() const { return relay_; }
+
+ private:
+  // ドライバ
+  Driver *driver_;
+  // センサ
+  Sensor *sensor_;
+
+  // 記録 (start()からprint()まで、大きいのでヒープに置く)
+  Log *log_;
+  // 動かし方
+  enum class Mode : uint8_t { Excitation, Relay };
+  Mode mode_;
+  // 入力信号
+  sysid::Excitation excitation_;
+  // リレー帰還の実験
+  autotune::RelayTuner relay_;
+  // リレー帰還で動かす軸
+  sysid::Axis axis_;
+  // 入力信号の列
+  const sysid::Config *configs_;
+  std::size_t count_;
+  // 次の信号の位置
+  std::size_t index_;
+  // 信号の間に待つ残りの周期の数
+  uint32_t rest_;
+  // 動作中かどうか
+  std::atomic<bool> running_;
+
+  // 入力信号を1周期分与える
+  void updateExcitation(const Sensed &sensed);
+  // リレー帰還を1周期分進める
+  void updateRelay(const Sensed &sensed);
+  // 次の信号に進む (残っていなければ終わる)
+  void next();
+  // 止めて終わる
+  void finish();
+};
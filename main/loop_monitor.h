@@ -0,0 +1,131 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+// Project
+#include "dri/histogram.h"
+#include "parameters.h"
+
+/**
+ * @brief 制御ループの周期ごとの遅れと実行時間を記録する
+ * @details
+ * - 開始遅延: タイマー割り込みから制御処理を始めるまでの時間
+ * - 実行時間: 制御処理の開始から終了までの時間
+ * - オーバーラン: 実行が次の周期にはみ出した回数 (取りこぼした周期を含む)
+ * 統計は制御ループだけが読み書きする。他のコアからは次のように要求し、制御ループがupdate()で処理する。
+ * - リセット: requestReset()で要求し、update()の最初に行う
+ * - 読み出し: requestSnapshot()で要求し、update()の最後に統計を写す。snapshotTaken()になったらsnapshot()を読む
+ */
+class LoopMonitor {
+ public:
+  // ビン数
+  static constexpr std::size_t HISTOGRAM_SIZE = 64;
+  // 開始遅延のビン幅 [us]
+  static constexpr uint32_t LATENCY_HISTOGRAM_WIDTH = 1;
+  // 実行時間のビン幅 [us] (制御周期の2倍までを記録する)
+  static constexpr uint32_t EXECUTION_HISTOGRAM_WIDTH = CONTROL_PERIOD_US * 2 / HISTOGRAM_SIZE;
+
+  using Histogram = data::Histogram<uint32_t, HISTOGRAM_SIZE>;
+
+  // 統計
+  struct Stats {
+    //! 開始遅延 [us]
+    Histogram latency{0, LATENCY_HISTOGRAM_WIDTH};
+    //! 実行時間 [us]
+    Histogram execution{0, EXECUTION_HISTOGRAM_WIDTH};
+    //! 記録した周期の数
+    uint32_t cycles{0};
+    //! オーバーランした周期の数
+    uint32_t overruns{0};
+    //! 取りこぼした周期の数
+    uint32_t missed{0};
+  };
+
+  explicit LoopMonitor() = default;
+  ~LoopMonitor() = default;
+
+  void reset() { stats_ = Stats{}; }
+
+  // リセットを要求 (他のコアから呼ぶ)
+  void requestReset() { reset_requested_.store(true, std::memory_order_release); }
+
+  /**
+   * @brief 統計の写しを要求する (他のコアから呼ぶ)
+   * @return 要求の番号 (snapshotTaken()に渡す)
+   */
+  uint32_t requestSnapshot() { return snapshot_requested_.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+  // 要求した写しが取られたかどうか
+  [[nodiscard]] bool snapshotTaken(uint32_t request) const {
+    return snapshot_taken_.load(std::memory_order_acquire) == request;
+  }
+
+  // 最後に写した統計 (snapshotTaken()の後、次の要求までに読む)
+  [[nodiscard]] const Stats &snapshot() const { return snapshot_; }
+
+  /**
+   * @brief 1周期分を記録する
+   * @param release タイマー割り込みの時刻 [us]
+   * @param missed 取りこぼした周期の数
+   * @param start 制御処理を始めた時刻 [us]
+   * @param end 制御処理を終えた時刻 [us]
+   */
+  void update(uint32_t release, uint32_t missed, uint32_t start, uint32_t end) {
+    if (reset_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+      reset_requested_.store(false, std::memory_order_relaxed);
+      reset();
+    }
+    auto latency = start - release;
+    auto execution = end - start;
+    stats_.latency.update(latency);
+    stats_.execution.update(execution);
+    stats_.cycles++;
+    stats_.missed += missed;
+    if (missed > 0 || latency + execution > CONTROL_PERIOD_US) {
+      stats_.overruns++;
+    }
+    if (auto request = snapshot_requested_.load(std::memory_order_acquire);
+        request != snapshot_taken_.load(std::memory_order_relaxed)) [[unlikely]] {
+      snapshot_ = stats_;
+      snapshot_taken_.store(request, std::memory_order_release);
+    }
+  }
+
+  // 統計 (制御ループから読む)
+  [[nodiscard]] const Stats &stats() const { return stats_; }
+
+  // 最後に写した統計を表示
+  void print() const {
+    printf("control loop: %u Hz, %u cycles, %u overruns, %u missed\n", static_cast<unsigned>(CONTROL_FREQUENCY),
+           static_cast<unsigned>(snapshot_.cycles), static_cast<unsigned>(snapshot_.overruns),
+           static_cast<unsigned>(snapshot_.missed));
+    print("latency  ", snapshot_.latency);
+    print("execution", snapshot_.execution);
+  }
+
+ private:
+  //! 統計
+  Stats stats_;
+  //! 他のコアに渡す統計の写し
+  Stats snapshot_;
+  //! リセットの要求
+  std::atomic<bool> reset_requested_{false};
+  //! 写しを要求した回数
+  std::atomic<uint32_t> snapshot_requested_{0};
+  //! 写しを取った要求の番号
+  std::atomic<uint32_t> snapshot_taken_{0};
+
+  static void print(const char *name, const Histogram &histogram) {
+    printf("%s [us]: min %u, mean %.1f, p50 %u, p99 %u, p99.9 %u, max %u\n", name,
+           static_cast<unsigned>(histogram.min()), static_cast<double>(histogram.mean()),
+           static_cast<unsigned>(histogram.percentile(0.5f)), static_cast<unsigned>(histogram.percentile(0.99f)),
+           static_cast<unsigned>(histogram.percentile(0.999f)), static_cast<unsigned>(histogram.max()));
+    for (std::size_t i = 0; i < histogram.size(); i++) {
+      if (histogram[i] == 0) continue;
+      printf("  %5u - : %u\n", static_cast<unsigned>(histogram.lower(i)), static_cast<unsigned>(histogram[i]));
+    }
+  }
+};
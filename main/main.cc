@@ -1,13 +1,33 @@
 // C++
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
+
+// ESP-IDF
+#include <esp_cpu.h>
+#include <esp_timer.h>
 
 // Project
+#include "dri/control_timer.h"
 #include "dri/driver.h"
+#include "dri/spsc_queue.h"
+#include "fastmath.h"
+#include "identification.h"
+#include "loop_monitor.h"
 #include "map.h"
 #include "motion.h"
+#include "pose.h"
+#include "profiler.h"
+#include "route.h"
+#include "rtos.h"
 #include "run.h"
 #include "sensor.h"
+#include "telemetry.h"
 
 // バックグラウンドタスク
 [[noreturn]] static void proTask(void *);
@@ -22,15 +42,132 @@ Sensor *sensor = nullptr;
 Motion *motion = nullptr;
 // 走行
 Run *run = nullptr;
+// 制御ループの計測
+LoopMonitor *monitor = nullptr;
+// システム同定
+Identification *identification = nullptr;
+// テレメトリ
+telemetry::Channel *telemetry_channel = nullptr;
+
+// 制御タスクの優先度 (Core 0で最優先)
+static constexpr UBaseType_t CONTROL_TASK_PRIORITY = configMAX_PRIORITIES - 1;
+// 制御タスク
+static TaskHandle_t control_task = nullptr;
+// 制御ループの停止要求
+static std::atomic<bool> control_pause_requested{false};
+// 制御ループが止まっているかどうか
+static std::atomic<bool> control_paused{false};
+
+// 制御ループを止める (Core 1から呼ぶ、モーターを解放して止まるまで待つ)
+static void pauseControl() {
+  control_pause_requested.store(true, std::memory_order_release);
+  while (!control_paused.load(std::memory_order_acquire)) {
+    vTaskDelay(1);
+  }
+}
+
+// 制御ループを再開する (再開するまで待つ)
+static void resumeControl() {
+  control_pause_requested.store(false, std::memory_order_release);
+  xTaskNotifyGive(control_task);
+  while (control_paused.load(std::memory_order_acquire)) {
+    vTaskDelay(1);
+  }
+}
+
+// 統計の写しを制御ループに要求して待つ (制御ループが止まっていて写せない場合はfalse)
+template <typename T>
+static bool waitSnapshot(T &stats) {
+  constexpr auto TIMEOUT = pdMS_TO_TICKS(100);
+  auto request = stats.requestSnapshot();
+  auto start = xTaskGetTickCount();
+  while (!stats.snapshotTaken(request)) {
+    if (xTaskGetTickCount() - start > TIMEOUT) return false;
+    vTaskDelay(1);
+  }
+  return true;
+}
+
+// コンソールコマンド: 制御ループの統計を表示 ("loop reset"でリセット)
+static int commandLoop(int argc, char **argv) {
+  if (argc > 1 && std::strcmp(argv[1], "reset") == 0) {
+    monitor->requestReset();
+    return 0;
+  }
+  if (!waitSnapshot(*monitor)) {
+    printf("loop: control loop is not running\n");
+    return 1;
+  }
+  monitor->print();
+  return 0;
+}
+
+// コンソールコマンド: 制御ループの区間ごとの所要時間を表示 ("prof reset"でリセット)
+static int commandProfile(int argc, char **argv) {
+  if (argc > 1 && std::strcmp(argv[1], "reset") == 0) {
+    profiler::instance.requestReset();
+    return 0;
+  }
+  if constexpr (!profiler::ENABLED) {
+    printf("prof: disabled in this build\n");
+    return 1;
+  }
+  if (!waitSnapshot(profiler::instance)) {
+    printf("prof: control loop is not running\n");
+    return 1;
+  }
+  profiler::instance.print();
+  return 0;
+}
+
+// コンソールコマンド: システム同定の記録をCSVで表示 (表示した記録は解放する)
+static int commandSysid(int, char **) {
+  if (!identification->print()) {
+    printf("sysid: %s\n", identification->isRunning() ? "running" : "no log");
+    return 1;
+  }
+  return 0;
+}
+
+// 自動調整の調整則 (コンソールの"gain rule"で選ぶ)
+static std::atomic<autotune::Rule> autotune_rule = autotune::Rule::TyreusLuybenPi;
+// 調整則の名前
+static constexpr const char *AUTOTUNE_RULE_NAMES[] = {"zn-pi", "zn-pid", "tl-pi", "tl-pid"};
+
+// コンソールコマンド: PIDの基準のゲインを表示 ("gain reset"で戻す、"gain rule <name>"で自動調整の調整則を選ぶ)
+static int commandGain(int argc, char **argv) {
+  if (argc > 1 && std::strcmp(argv[1], "reset") == 0) {
+    if (!motion->resetGain()) printf("gain: failed to write NVS\n");
+  } else if (argc > 2 && std::strcmp(argv[1], "rule") == 0) {
+    auto found = false;
+    for (std::size_t i = 0; i < std::size(AUTOTUNE_RULE_NAMES); i++) {
+      if (std::strcmp(argv[2], AUTOTUNE_RULE_NAMES[i]) == 0) {
+        autotune_rule.store(static_cast<autotune::Rule>(i));
+        found = true;
+      }
+    }
+    if (!found) {
+      printf("gain: unknown rule '%s' (zn-pi, zn-pid, tl-pi, tl-pid)\n", argv[2]);
+      return 1;
+    }
+  }
+  auto gain = motion->getGain();
+  printf("velocity: kp %g, ki %g, kd %g\n", static_cast<double>(gain.velocity.kp),
+         static_cast<double>(gain.velocity.ki), static_cast<double>(gain.velocity.kd));
+  printf("angular velocity: kp %g, ki %g, kd %g\n", static_cast<double>(gain.angular_velocity.kp),
+         static_cast<double>(gain.angular_velocity.ki), static_cast<double>(gain.angular_velocity.kd));
+  printf("autotune rule: %s\n", AUTOTUNE_RULE_NAMES[static_cast<std::size_t>(autotune_rule.load())]);
+  return 0;
+}
 
 // モード選択
 static uint8_t selectMode() {
-  auto &sensed = sensor->getSensed();
   uint8_t mode = 0;
 
   auto xLastWakeTime = xTaskGetTickCount();
   while (true) {
     vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(50));
+    auto sensed = sensor->getSensed();
 
     // 車輪が一定速度以上か一定速度以下で回されたらモード変更
     if (std::abs(sensed.velocity) > MODE_THRESHOLD_SPEED) {
@@ -51,6 +188,7 @@ static uint8_t selectMode() {
       xLastWakeTime = xTaskGetTickCount();
       while (true) {
         vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(50));
+        sensed = sensor->getSensed();
         // 左壁センサが一定以上ならモード確定
         if (sensed.wall_left90.raw > MODE_THRESHOLD_WALL[PARAMETER_WALL_LEFT90] &&
             sensed.wall_left45.raw > MODE_THRESHOLD_WALL[PARAMETER_WALL_LEFT45]) {
@@ -88,10 +226,7 @@ void printParam() {
 }
 
 // センサ値表示
-[[noreturn]] void printSensor(bool is_csv) {
-  auto &sensed = sensor->getSensed();
-  auto &target = motion->getTarget();
-
+[[noreturn]] void printSensor() {
   // 出力モードを示す
   driver->indicator->clear();
   driver->indicator->set(0, 0x0F, 0, 0);
@@ -100,53 +235,32 @@ void printParam() {
   // 画面クリア
   printf("\x1b[2J");
 
-  // ヘッダーを出力
-  if (is_csv) {
-    printf("vbatt, vbatt_avg, velo, len, ang_velo, ang, x, y, r90, r45, l45, l90, tvelo, tang_velo\n");
-  }
-
   auto xLastWakeTime = xTaskGetTickCount();
   while (true) {
     vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(50));
+    auto sensed = sensor->getSensed();
+    auto target = motion->getTarget();
 
     // 表示
-    if (is_csv) {
-      printf("%d, ", sensed.battery_voltage);
-      printf("%d, ", sensed.battery_voltage_average);
-      printf("%f, ", static_cast<double>(sensed.velocity));
-      printf("%f, ", static_cast<double>(sensed.length));
-      printf("%f, ", static_cast<double>(sensed.angular_velocity));
-      printf("%f, ", static_cast<double>(sensed.angle));
-      printf("%f, ", static_cast<double>(sensed.x));
-      printf("%f, ", static_cast<double>(sensed.y));
-      printf("%d, ", sensed.wall_right90.raw);
-      printf("%d, ", sensed.wall_right45.raw);
-      printf("%d, ", sensed.wall_left45.raw);
-      printf("%d, ", sensed.wall_left90.raw);
-      printf("%f, ", static_cast<double>(target.velocity));
-      printf("%f, ", static_cast<double>(target.angular_velocity));
-      printf("\n");
-    } else {
-      printf("\x1b[0;0H");
-      printf(" ----- Sensor Info ----- \n");
-      printf("bat_vol    : %-30d\n", sensed.battery_voltage);
-      printf("bat_vol_avg: %-30d\n", sensed.battery_voltage_average);
-      printf("velo    : %-30f\n", static_cast<double>(sensed.velocity));
-      printf("length  : %-30f\n", static_cast<double>(sensed.length));
-      printf("ang_velo: %-30f\n", static_cast<double>(sensed.angular_velocity));
-      printf("angle   : %-30f\n", static_cast<double>(sensed.angle));
-      printf("x: %-30f\n", static_cast<double>(sensed.x));
-      printf("y: %-30f\n", static_cast<double>(sensed.y));
-
-      printf("right90: %-30d\n", sensed.wall_right90.raw);
-      printf("right45: %-30d\n", sensed.wall_right45.raw);
-      printf("left45 : %-30d\n", sensed.wall_left45.raw);
-      printf("left90 : %-30d\n", sensed.wall_left90.raw);
-
-      printf("----- Target ----- \n");
-      printf("velo     : %-30f\n", static_cast<double>(target.velocity));
-      printf("ang velo : %-30f\n", static_cast<double>(target.angular_velocity));
-    }
+    printf("\x1b[0;0H");
+    printf(" ----- Sensor Info ----- \n");
+    printf("bat_vol    : %-30d\n", sensed.battery_voltage);
+    printf("bat_vol_avg: %-30d\n", sensed.battery_voltage_average);
+    printf("velo    : %-30f\n", static_cast<double>(sensed.velocity));
+    printf("length  : %-30f\n", static_cast<double>(sensed.length));
+    printf("ang_velo: %-30f\n", static_cast<double>(sensed.angular_velocity));
+    printf("angle   : %-30f\n", static_cast<double>(sensed.angle));
+    printf("x: %-30f\n", static_cast<double>(sensed.x));
+    printf("y: %-30f\n", static_cast<double>(sensed.y));
+
+    printf("right90: %-30d\n", sensed.wall_right90.raw);
+    printf("right45: %-30d\n", sensed.wall_right45.raw);
+    printf("left45 : %-30d\n", sensed.wall_left45.raw);
+    printf("left90 : %-30d\n", sensed.wall_left90.raw);
+
+    printf("----- Target ----- \n");
+    printf("velo     : %-30f\n", static_cast<double>(target.velocity));
+    printf("ang velo : %-30f\n", static_cast<double>(target.angular_velocity));
   }
 }
 
@@ -168,6 +282,8 @@ void testRightTurn() {
   driver->indicator->update();
 
   run->turn(90, ANGULAR_ACCELERATION_DEFAULT, ANGULAR_VELOCITY_DEFAULT, MotionDirection::Right);
+  // 前壁があれば向きを揃える
+  run->align();
   run->wait();
   run->stop();
 }
@@ -177,10 +293,237 @@ void testLeftTurn() {
   driver->indicator->update();
 
   run->turn(90, ANGULAR_ACCELERATION_DEFAULT, ANGULAR_VELOCITY_DEFAULT, MotionDirection::Left);
+  run->align();
   run->wait();
   run->stop();
 }
 
+// テストスラローム (右の大回り90度を往復して元の区画に戻る)
+void testSlalom() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0x0F, 0);
+  driver->indicator->update();
+
+  sensor->reset();
+  run->straight(MotionDirection::Forward, MAZE_SECTION_SIZE / 2.0f, ACCELERATION_DEFAULT, VELOCITY_DEFAULT,
+                VELOCITY_DEFAULT);
+  for (int i = 0; i < 4; i++) {
+    run->slalom(slalom::TURN_LARGE_90, MotionDirection::Right, VELOCITY_DEFAULT);
+  }
+  run->straight(MotionDirection::Forward, MAZE_SECTION_SIZE / 2.0f, ACCELERATION_DEFAULT, VELOCITY_DEFAULT, 0.0f);
+  run->wait();
+  run->stop();
+
+  auto sensed = sensor->getSensed();
+  printf("slalom: x %f, y %f, angle %f\n", static_cast<double>(sensed.x), static_cast<double>(sensed.y),
+         static_cast<double>(sensed.angle));
+}
+
+// テスト経路 (2区画直進してから斜めで3区画ジグザグに進み、直進に戻って止まる)
+void testRoute() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0x0F, 0);
+  driver->indicator->update();
+
+  static const std::vector<RouteAction> ACTIONS = {
+      RouteAction::Straight, RouteAction::Straight, RouteAction::Right, RouteAction::Left,
+      RouteAction::Right,    RouteAction::Left,     RouteAction::Straight,
+  };
+  static Route route;
+  auto start = static_cast<uint32_t>(esp_timer_get_time());
+  auto planned = route.compile(ACTIONS) && route.plan(VELOCITY_DEFAULT * 2.0f, VELOCITY_DEFAULT);
+  auto elapsed = static_cast<uint32_t>(esp_timer_get_time()) - start;
+  printf("route: %zu segments, plan %lu us, predicted %.3f s\n", route.segments().size(),
+         static_cast<unsigned long>(elapsed), static_cast<double>(route.time()));
+  if (!planned) return;
+
+  sensor->reset();
+  // 区画の中央から走り出す
+  run->straight(MotionDirection::Forward, MAZE_SECTION_SIZE / 2.0f, ACCELERATION_DEFAULT, VELOCITY_DEFAULT, 0.0f);
+  run->follow(route);
+  run->wait();
+  run->stop();
+}
+
+// 秒を制御周期の数にする
+static constexpr uint32_t toTicks(float time) {
+  return static_cast<uint32_t>(time * static_cast<float>(CONTROL_FREQUENCY));
+}
+
+// システム同定の入力信号 (並進のあと旋回)
+static constexpr sysid::Config SYSID_SEQUENCE[] = {
+    {sysid::Signal::Step, sysid::Axis::Translation, SYSID_VOLTAGE, toTicks(SYSID_STEP_TIME), 1, 0.0f, 0.0f},
+    {sysid::Signal::Prbs, sysid::Axis::Translation, SYSID_VOLTAGE, toTicks(SYSID_PRBS_TIME),
+     toTicks(SYSID_PRBS_BIT_TIME), 0.0f, 0.0f},
+    {sysid::Signal::Chirp, sysid::Axis::Translation, SYSID_VOLTAGE, toTicks(SYSID_CHIRP_TIME), 1,
+     SYSID_CHIRP_FREQUENCY_MIN, SYSID_CHIRP_FREQUENCY_MAX},
+    {sysid::Signal::Step, sysid::Axis::Rotation, SYSID_ANGULAR_VOLTAGE, toTicks(SYSID_STEP_TIME), 1, 0.0f, 0.0f},
+    {sysid::Signal::Prbs, sysid::Axis::Rotation, SYSID_ANGULAR_VOLTAGE, toTicks(SYSID_PRBS_TIME),
+     toTicks(SYSID_PRBS_BIT_TIME), 0.0f, 0.0f},
+    {sysid::Signal::Chirp, sysid::Axis::Rotation, SYSID_ANGULAR_VOLTAGE, toTicks(SYSID_CHIRP_TIME), 1,
+     SYSID_CHIRP_FREQUENCY_MIN, SYSID_CHIRP_FREQUENCY_MAX},
+};
+static_assert(
+    [] {
+      std::size_t ticks = 0;
+      for (const auto &config : SYSID_SEQUENCE) ticks += config.ticks;
+      return ticks <= Identification::LOG_SIZE;
+    }(),
+    "SYSID_SEQUENCE does not fit in the identification log");
+
+// システム同定 (モーターに電圧を直接かけて応答を記録し、コンソールの"sysid"で取り出す)
+void identifySystem() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0, 0x0F);
+  driver->indicator->update();
+
+  // 列の長さは上で確かめているので、失敗するのは記録を確保できない場合
+  if (!identification->start(SYSID_SEQUENCE, std::size(SYSID_SEQUENCE))) {
+    printf("sysid: not enough heap for the log (%u bytes)\n", static_cast<unsigned>(sizeof(Identification::Log)));
+    return;
+  }
+  while (identification->isRunning()) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  driver->buzzer->tone(C5, 100);
+  printf("sysid: done, run 'sysid' to dump the log\n");
+}
+
+// リレー帰還の実験を1つの軸で行い、調整則でゲインを求める (失敗した場合はfalse)
+static bool relayTune(sysid::Axis axis, const autotune::Config &config, PidGain<float> &gain) {
+  if (!identification->startRelay(axis, config)) return false;
+  while (identification->isRunning()) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  const auto &relay = identification->getRelay();
+  const auto &result = relay.result();
+  printf("autotune %s: %s, Ku %g, Pu %g s, amplitude %g, bias %g V\n", sysid::name(axis),
+         result.valid ? "ok" : "failed", static_cast<double>(result.ultimate_gain),
+         static_cast<double>(result.ultimate_period), static_cast<double>(result.amplitude),
+         static_cast<double>(relay.bias()));
+  if (!result.valid) return false;
+  gain = autotune::RelayTuner::gain(result, autotune_rule.load());
+  printf("  kp %g, ki %g, kd %g\n", static_cast<double>(gain.kp), static_cast<double>(gain.ki),
+         static_cast<double>(gain.kd));
+  return true;
+}
+
+// PIDの自動調整 (並進と旋回でリレー帰還の実験を行い、結果をNVSに保存する)
+void autotunePid() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0x0F, 0x0F);
+  driver->indicator->update();
+
+  // 中心の電圧はフィードフォワードと同じモデルから決める
+  const autotune::Config velocity = {
+      .setpoint = AUTOTUNE_VELOCITY,
+      .bias = Feedforward::VELOCITY_CONSTANT * AUTOTUNE_VELOCITY + MOTOR_FRICTION_VOLTAGE,
+      .amplitude = AUTOTUNE_RELAY_VOLTAGE,
+      .hysteresis = AUTOTUNE_VELOCITY_HYSTERESIS,
+      .settle_cycles = AUTOTUNE_SETTLE_CYCLES,
+      .measure_cycles = AUTOTUNE_MEASURE_CYCLES,
+      .timeout = AUTOTUNE_TIMEOUT,
+  };
+  const autotune::Config angular = {
+      .setpoint = AUTOTUNE_ANGULAR_VELOCITY,
+      .bias = Feedforward::VELOCITY_CONSTANT * AUTOTUNE_ANGULAR_VELOCITY * TREAD_WIDTH / 2000.0f +
+              MOTOR_FRICTION_VOLTAGE,
+      .amplitude = AUTOTUNE_ANGULAR_RELAY_VOLTAGE,
+      .hysteresis = AUTOTUNE_ANGULAR_VELOCITY_HYSTERESIS,
+      .settle_cycles = AUTOTUNE_SETTLE_CYCLES,
+      .measure_cycles = AUTOTUNE_MEASURE_CYCLES,
+      .timeout = AUTOTUNE_TIMEOUT,
+  };
+
+  PidGain<float> velocity_gain{}, angular_gain{};
+  if (!relayTune(sysid::Axis::Translation, velocity, velocity_gain)) return;
+  // 止まるのを待つ
+  vTaskDelay(pdMS_TO_TICKS(500));
+  if (!relayTune(sysid::Axis::Rotation, angular, angular_gain)) return;
+
+  if (!motion->setGain(velocity_gain, angular_gain)) {
+    printf("autotune: failed to write NVS\n");
+    return;
+  }
+  driver->buzzer->tone(C5, 100);
+}
+
+// テレメトリのフレームを作る (制御ループから呼ぶ)
+static void publishTelemetry(uint32_t timestamp) {
+  auto sensed = sensor->getSensed();
+  auto target = motion->getTarget();
+
+  TelemetryFrame frame{};
+  frame.timestamp = timestamp;
+  frame.velocity = sensed.velocity;
+  frame.angular_velocity = sensed.angular_velocity;
+  frame.angle = sensed.angle;
+  frame.length = sensed.length;
+  frame.x = sensed.x;
+  frame.y = sensed.y;
+  frame.slip = sensed.slip;
+  frame.target_velocity = target.velocity;
+  frame.target_angular_velocity = target.angular_velocity;
+  frame.wall[0] = static_cast<int16_t>(sensed.wall_right90.raw);
+  frame.wall[1] = static_cast<int16_t>(sensed.wall_right45.raw);
+  frame.wall[2] = static_cast<int16_t>(sensed.wall_left45.raw);
+  frame.wall[3] = static_cast<int16_t>(sensed.wall_left90.raw);
+  frame.flags = (sensed.wall_right90.exist ? TelemetryFrame::FLAG_WALL_RIGHT90 : 0) |
+                (sensed.wall_right45.exist ? TelemetryFrame::FLAG_WALL_RIGHT45 : 0) |
+                (sensed.wall_left45.exist ? TelemetryFrame::FLAG_WALL_LEFT45 : 0) |
+                (sensed.wall_left90.exist ? TelemetryFrame::FLAG_WALL_LEFT90 : 0);
+  frame.battery_voltage = static_cast<int16_t>(sensed.battery_voltage);
+  frame.motor_voltage_right = static_cast<int16_t>(driver->motor_right->voltage());
+  frame.motor_voltage_left = static_cast<int16_t>(driver->motor_left->voltage());
+  for (std::size_t i = 0; i < profiler::NUM_STAGE; i++) {
+    auto counts = profiler::instance.last(static_cast<profiler::Stage>(i));
+    auto time = profiler::Profiler::to_us(static_cast<float>(counts)) * 10.0f;
+    frame.profile[i] = static_cast<uint16_t>(std::min(time, static_cast<float>(UINT16_MAX)));
+  }
+  telemetry_channel->publish(frame);
+}
+
+// 1フレームあたりの制御周期の数
+static constexpr uint32_t TELEMETRY_DECIMATION = CONTROL_FREQUENCY / TELEMETRY_FREQUENCY;
+// 8N1で1バイトあたり10ビットを送る
+static_assert(telemetry::MAX_ENCODED_SIZE * 10 * TELEMETRY_FREQUENCY <= TELEMETRY_BAUD_RATE,
+              "TELEMETRY_BAUD_RATE is too low for TELEMETRY_FREQUENCY");
+
+// テレメトリ送信 (TELEMETRY_FREQUENCYごとのフレームをCOBSで区切ってUARTに流す)
+[[noreturn]] void streamTelemetry() {
+  // 一度に書き込むフレーム数
+  constexpr std::size_t BATCH_FRAMES = 16;
+  static std::array<uint8_t, telemetry::MAX_ENCODED_SIZE * BATCH_FRAMES> buffer;
+
+  // 出力モードを示す
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0, 0);
+  driver->indicator->update();
+
+  printf("telemetry: %u frames/s at %u bps\n", static_cast<unsigned>(TELEMETRY_FREQUENCY),
+         static_cast<unsigned>(TELEMETRY_BAUD_RATE));
+  fflush(stdout);
+  vTaskDelay(pdMS_TO_TICKS(10));
+  driver->console->set_baud_rate(TELEMETRY_BAUD_RATE);
+  // それまでのテキスト出力と最初のフレームを区切る
+  const uint8_t delimiter = 0;
+  driver->console->write(&delimiter, sizeof(delimiter));
+  telemetry_channel->enable();
+
+  TelemetryFrame frame{};
+  while (true) {
+    std::size_t size = 0;
+    while (size + telemetry::MAX_ENCODED_SIZE <= buffer.size() && telemetry_channel->receive(frame)) {
+      size += telemetry::encode(frame, buffer.data() + size);
+    }
+    if (size > 0) {
+      driver->console->write(buffer.data(), size);
+    } else {
+      vTaskDelay(1);
+    }
+  }
+}
+
 // テスト宴会芸
 [[noreturn]] void testEnkaigei() {
   // 動作テストモードを示す
@@ -195,9 +538,104 @@ void testLeftTurn() {
   param.acceleration = 0;
   param.max_angular_velocity = 0;
   param.angular_acceleration = 0;
-  motion->getParameterQueue().overwrite(&param);
+  motion->getParameterQueue().send(&param);
+
+  streamTelemetry();
+}
+
+// IMUキャリブレーション
+void calibrateImu() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0x0F, 0, 0x0F);
+  driver->indicator->update();
+
+  // 手を離して静止するまで待つ
+  vTaskDelay(pdMS_TO_TICKS(1000));
+  // 数秒かかるので、制御ループを止めてこのタスクで計測する
+  pauseControl();
+  if (!sensor->calibrate()) printf("imu: failed to write NVS\n");
+  resumeControl();
+  driver->buzzer->tone(C5, 100);
+}
+
+// 姿勢計算のベンチマーク
+void benchmarkPose() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0, 0x0F, 0x0F);
+  driver->indicator->update();
+
+  constexpr uint32_t COUNTS = 10000;
+  // 最適化で消えないようvolatileを経由する
+  volatile float input = 0.0f;
+  volatile float sink = 0.0f;
+
+  // libm
+  auto start = esp_cpu_get_cycle_count();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    input = input + 1.0e-3f;
+    sink = sink + std::sin(input) + std::cos(input);
+  }
+  auto libm = esp_cpu_get_cycle_count() - start;
+
+  // 多項式近似
+  input = 0.0f;
+  start = esp_cpu_get_cycle_count();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    input = input + 1.0e-3f;
+    auto result = fastmath::sincos(input);
+    sink = sink + result.sin + result.cos;
+  }
+  auto fast = esp_cpu_get_cycle_count() - start;
+
+  // 姿勢の更新 (角速度3rad/sで旋回)
+  Pose pose;
+  start = esp_cpu_get_cycle_count();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    pose.update(input, 3.0f, 0.001f);
+  }
+  auto update = esp_cpu_get_cycle_count() - start;
+  sink = sink + pose.x();
 
-  printSensor(true);
+  printf("std::sin + std::cos : %u cycles\n", static_cast<unsigned>(libm / COUNTS));
+  printf("fastmath::sincos    : %u cycles\n", static_cast<unsigned>(fast / COUNTS));
+  printf("Pose::update        : %u cycles\n", static_cast<unsigned>(update / COUNTS));
+  driver->buzzer->tone(C5, 100);
+}
+
+// キューのベンチマーク (送信と受信の組)
+void benchmarkQueue() {
+  driver->indicator->clear();
+  driver->indicator->set(0, 0, 0x0F, 0x0F);
+  driver->indicator->update();
+
+  constexpr uint32_t COUNTS = 10000;
+  uint32_t item = 0;
+  // 最適化で消えないようvolatileを経由する
+  volatile uint32_t sink = 0;
+
+  // FreeRTOSのキュー
+  rtos::Queue<uint32_t> queue(16);
+  auto start = esp_cpu_get_cycle_count();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    queue.send(&i, 0);
+    queue.receive(&item, 0);
+    sink = sink + item;
+  }
+  auto kernel = esp_cpu_get_cycle_count() - start;
+
+  // 待ちなしのキュー
+  data::SpscQueue<uint32_t, 16> spsc;
+  start = esp_cpu_get_cycle_count();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    spsc.send(&i);
+    spsc.receive(&item);
+    sink = sink + item;
+  }
+  auto wait_free = esp_cpu_get_cycle_count() - start;
+
+  printf("xQueueSend + xQueueReceive : %u cycles\n", static_cast<unsigned>(kernel / COUNTS));
+  printf("SpscQueue send + receive   : %u cycles\n", static_cast<unsigned>(wait_free / COUNTS));
+  driver->buzzer->tone(C5, 100);
 }
 
 /**
@@ -209,6 +647,29 @@ void testLeftTurn() {
   driver->buzzer->enable();
   driver->buzzer->tone(C5, 100);
 
+  // コンソールコマンドを登録
+  esp_console_cmd_t loop_command = {};
+  loop_command.command = "loop";
+  loop_command.help = "Print control loop latency, execution time and overruns ('loop reset' to clear)";
+  loop_command.func = commandLoop;
+  driver->console->reg(&loop_command);
+  esp_console_cmd_t profile_command = {};
+  profile_command.command = "prof";
+  profile_command.help = "Print time spent in each control loop stage ('prof reset' to clear)";
+  profile_command.func = commandProfile;
+  driver->console->reg(&profile_command);
+  esp_console_cmd_t sysid_command = {};
+  sysid_command.command = "sysid";
+  sysid_command.help = "Dump the system identification log as CSV and free it (for tools/sysid)";
+  sysid_command.func = commandSysid;
+  driver->console->reg(&sysid_command);
+  esp_console_cmd_t gain_command = {};
+  gain_command.command = "gain";
+  gain_command.help = "Print PID gains ('gain reset' to restore defaults, 'gain rule <zn-pi|zn-pid|tl-pi|tl-pid>')";
+  gain_command.func = commandGain;
+  driver->console->reg(&gain_command);
+  driver->console->start();
+
   printf("mm-bluelight is started!\n");
 
   auto xLastWakeTime = xTaskGetTickCount();
@@ -221,7 +682,7 @@ void testLeftTurn() {
         break;
 
       case 0x01:
-        printSensor(false);
+        printSensor();
         break;
 
       case 0x02:
@@ -241,12 +702,33 @@ void testLeftTurn() {
         break;
 
       case 0x06:
+        calibrateImu();
+        break;
+
       case 0x07:
+        benchmarkPose();
+        break;
+
       case 0x08:
+        benchmarkQueue();
+        break;
+
       case 0x09:
+        testSlalom();
+        break;
+
       case 0x0A:
+        testRoute();
+        break;
+
       case 0x0B:
+        identifySystem();
+        break;
+
       case 0x0C:
+        autotunePid();
+        break;
+
       case 0x0D:
       case 0x0E:
       case 0x0F:
@@ -269,12 +751,43 @@ void testLeftTurn() {
   // センサ初期化
   sensor->setup();
 
-  // TODO: 止める手段を作る (フラッシュ読み書きのため)
-  auto xLastWakeTime = xTaskGetTickCount();
+  // 制御周期をハードウェアタイマーで刻む
+  ControlTimer timer(CONTROL_FREQUENCY, xTaskGetCurrentTaskHandle());
+  timer.start();
+  uint32_t telemetry_count = 0;
   while (true) {
+    auto tick = timer.wait();
+    // 停止要求があればモーターを解放してタイマーを止め、再開の通知を待つ
+    if (control_pause_requested.load(std::memory_order_acquire)) [[unlikely]] {
+      driver->motor_right->coast();
+      driver->motor_left->coast();
+      timer.stop();
+      // 止める前に届いていたタイマーの通知を捨てる
+      ulTaskNotifyTake(pdTRUE, 0);
+      control_paused.store(true, std::memory_order_release);
+      while (control_pause_requested.load(std::memory_order_acquire)) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      }
+      control_paused.store(false, std::memory_order_release);
+      timer.start();
+      continue;
+    }
+    auto start = static_cast<uint32_t>(esp_timer_get_time());
     sensor->update();
-    motion->update();
-    vTaskDelayUntil(&xLastWakeTime, pdMS_TO_TICKS(1));
+    {
+      profiler::Scope scope(profiler::STAGE_MOTION);
+      // システム同定中はモーターを直接動かす
+      if (identification->isRunning()) {
+        identification->update();
+      } else {
+        motion->update();
+      }
+    }
+    if (telemetry_channel->enabled() && ++telemetry_count >= TELEMETRY_DECIMATION) {
+      telemetry_count = 0;
+      publishTelemetry(start);
+    }
+    monitor->update(tick.release, tick.missed, start, static_cast<uint32_t>(esp_timer_get_time()));
   }
 }
 
@@ -286,6 +799,9 @@ extern "C" void app_main(void) {
   sensor = new Sensor(driver);
   motion = new Motion(driver, sensor);
   run = new Run(sensor, motion);
-  xTaskCreatePinnedToCore(proTask, "proTask", 8192, nullptr, 20, nullptr, 0);
+  monitor = new LoopMonitor();
+  identification = new Identification(driver, sensor);
+  telemetry_channel = new telemetry::Channel();
+  xTaskCreatePinnedToCore(proTask, "proTask", 8192, nullptr, CONTROL_TASK_PRIORITY, &control_task, 0);
   xTaskCreatePinnedToCore(appTask, "appTask", 8192, nullptr, 20, nullptr, 1);
 }
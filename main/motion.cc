@@ -0,0 +1,181 @@
+#include "motion.h"
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+
+// ESP-IDF
+#include <esp_rom_crc.h>
+
+// Project
+#include "parameters.h"
+
+// 制御周期 [s]
+static constexpr float CONTROL_PERIOD = 1.0f / static_cast<float>(CONTROL_FREQUENCY);
+
+static constexpr PidGain<float> toGain(const float (&gain)[NUM_PARAMETER_PID]) {
+  return {gain[PARAMETER_PID_KP], gain[PARAMETER_PID_KI], gain[PARAMETER_PID_KD]};
+}
+
+// 速度・角速度PIDの設定 (出力の範囲は周期ごとに決める)
+static constexpr PidConfig<float> toConfig(const PidGain<float> &gain) {
+  return {
+      .gain = gain,
+      .output_min = -VOLTAGE_MOTOR_LIMIT,
+      .output_max = VOLTAGE_MOTOR_LIMIT,
+      .anti_windup = AntiWindup::BackCalculation,
+      .tracking_time_constant = PID_TRACKING_TIME_CONSTANT,
+      .derivative_time_constant = PID_DERIVATIVE_TIME_CONSTANT,
+      // 目標値の段差 (スラロームのテーブルなど) を微分しない
+      .setpoint_weight_p = 1.0f,
+      .setpoint_weight_d = 0.0f,
+  };
+}
+
+static uint32_t checksum(const Motion::Gain &gain) {
+  return esp_rom_crc32_le(0, reinterpret_cast<const uint8_t *>(&gain), offsetof(Motion::Gain, checksum));
+}
+
+// コンストラクタ
+Motion::Motion(Driver *dri, Sensor *sensor)
+    : driver_(dri),
+      sensor_(sensor),
+      completed_(0),
+      velocity_pid_(toConfig(toGain(VELOCITY_PID_GAIN))),
+      angular_velocity_pid_(toConfig(toGain(ANGULAR_VELOCITY_PID_GAIN))),
+      gain_(loadGain(*dri->nvs)),
+      applied_gain_(gain_.version()),
+      velocity_schedule_(PID_SCHEDULE_VELOCITIES, gain_.load().velocity, VELOCITY_PID_SCHEDULE),
+      angular_velocity_schedule_(PID_SCHEDULE_VELOCITIES, gain_.load().angular_velocity,
+                                 ANGULAR_VELOCITY_PID_SCHEDULE) {
+  published_.store(generator_.target());
+}
+// デストラクタ
+Motion::~Motion() = default;
+
+// NVSから基準のゲインを読む
+Motion::Gain Motion::loadGain(Nvs &nvs) {
+  Gain gain{};
+  if (nvs.read(GAIN_KEY, gain) && gain.version == GAIN_VERSION && gain.checksum == checksum(gain)) {
+    return gain;
+  }
+  return {GAIN_VERSION, toGain(VELOCITY_PID_GAIN), toGain(ANGULAR_VELOCITY_PID_GAIN), 0};
+}
+
+// 基準のゲインを変えてNVSに保存する
+bool Motion::setGain(const PidGain<float> &velocity, const PidGain<float> &angular_velocity) {
+  Gain gain{};
+  gain.version = GAIN_VERSION;
+  gain.velocity = velocity;
+  gain.angular_velocity = angular_velocity;
+  gain.checksum = checksum(gain);
+  gain_.store(gain);
+  return driver_->nvs->write(GAIN_KEY, gain);
+}
+
+// parameters.hのゲインに戻す
+bool Motion::resetGain() { return setGain(toGain(VELOCITY_PID_GAIN), toGain(ANGULAR_VELOCITY_PID_GAIN)); }
+
+void Motion::next() {
+  if (!generator_.next(queue_)) return;
+  // 同じ向きの直進が続く場合は、側壁の有無と制御の状態を持ち越す (消すと壁の見え始めとして補正を止めてしまう)
+  if (!generator_.continued()) side_wall_.reset();
+  front_wall_.reset();
+  // すぐに終わる指令 (Idle・Stop) もここで完了として数える
+  if (generator_.finished()) {
+    completed_.fetch_add(1, std::memory_order_release);
+  }
+}
+
+void Motion::coast() {
+  driver_->motor_right->coast();
+  driver_->motor_left->coast();
+  velocity_pid_.reset();
+  angular_velocity_pid_.reset();
+}
+
+// 更新
+void Motion::update() {
+  // 目標値を進める
+  if (generator_.finished()) {
+    next();
+  } else {
+    // 途中で届いた指令につなげられるなら終端速度を上げる
+    generator_.lookahead(queue_);
+    if (generator_.update(CONTROL_PERIOD)) {
+      completed_.fetch_add(1, std::memory_order_release);
+    }
+  }
+  auto sensed = sensor_->getSensed();
+  // 前壁合わせが合ったら終える
+  FrontWallAlignment::Command front{};
+  if (generator_.target().pattern == MotionPattern::FrontAlign && !generator_.finished()) {
+    front = front_wall_.update(sensed.wall_left90.raw, sensed.wall_right90.raw,
+                               sensed.wall_left90.exist && sensed.wall_right90.exist);
+    if (front_wall_.finished() && generator_.finish()) {
+      completed_.fetch_add(1, std::memory_order_release);
+    }
+  }
+  auto target = generator_.target();
+  published_.store(target);
+
+  // 電圧が低い、または指令がない場合はモーターを解放する
+  if (target.pattern == MotionPattern::Idle ||
+      static_cast<float>(sensed.battery_voltage_average) < VOLTAGE_LOW_LIMIT * 1000.0f) {
+    coast();
+    return;
+  }
+
+  // 横壁制御による角速度の補正 [rad/s] (フィードフォワードには入れない)
+  auto wall = 0.0f;
+  if (target.pattern == MotionPattern::FrontAlign) {
+    // 前壁合わせは壁センサから決めた目標値を追う
+    target.velocity = front.velocity;
+    target.angular_velocity = front.angular_velocity;
+  } else if (target.pattern == MotionPattern::Straight) {
+    SideWallControl::Observation observation{
+        .left = sensed.wall_left45.error,
+        .right = sensed.wall_right45.error,
+        .left_exist = sensed.wall_left45.exist,
+        .right_exist = sensed.wall_right45.exist,
+    };
+    wall = side_wall_.update(observation, target.velocity, CONTROL_PERIOD);
+  }
+
+  // モーターモデルから求めた電圧 [V]
+  auto feedforward =
+      feedforward_.update(target.velocity, target.acceleration, target.angular_velocity, target.angular_acceleration);
+  // 基準のゲインが変わったらスケジュールを作り直す (積分はゲインを掛けた後の値なので出力は跳ねない)
+  if (gain_.version() != applied_gain_) {
+    applied_gain_ = gain_.version();
+    auto gain = gain_.load();
+    velocity_schedule_ = Schedule(PID_SCHEDULE_VELOCITIES, gain.velocity, VELOCITY_PID_SCHEDULE);
+    angular_velocity_schedule_ =
+        Schedule(PID_SCHEDULE_VELOCITIES, gain.angular_velocity, ANGULAR_VELOCITY_PID_SCHEDULE);
+  }
+  // 速度に応じてゲインを変える
+  auto speed = std::abs(target.velocity);
+  velocity_pid_.gain(velocity_schedule_.at(speed));
+  angular_velocity_pid_.gain(angular_velocity_schedule_.at(speed));
+  // 速度・角速度のフィードバック (モデルとの差を補正する) [V]
+  // 各車輪の電圧が上限を超えて積分が飽和しないよう、車輪ごとの残りの余裕を出力の範囲にする
+  // 速度を先に決め、角速度には両輪がまだ受けられる分だけを残す
+  velocity_pid_.limit(-VOLTAGE_MOTOR_LIMIT - std::min(feedforward.right, feedforward.left),
+                      VOLTAGE_MOTOR_LIMIT - std::max(feedforward.right, feedforward.left));
+  auto voltage = velocity_pid_.update(target.velocity, sensed.velocity, CONTROL_PERIOD);
+  auto right_base = feedforward.right + voltage;
+  auto left_base = feedforward.left + voltage;
+  angular_velocity_pid_.limit(std::max(-VOLTAGE_MOTOR_LIMIT - right_base, left_base - VOLTAGE_MOTOR_LIMIT),
+                              std::min(VOLTAGE_MOTOR_LIMIT - right_base, left_base + VOLTAGE_MOTOR_LIMIT));
+  auto angular_voltage =
+      angular_velocity_pid_.update(target.angular_velocity + wall, sensed.angular_velocity, CONTROL_PERIOD);
+
+  // 左回りが正なので、右が速く左が遅くなる
+  auto right = std::clamp(feedforward.right + voltage + angular_voltage, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+  auto left = std::clamp(feedforward.left + voltage - angular_voltage, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+  // 電圧降下はバッテリー電圧の移動平均でデューティ比に換算して補う (瞬時値のノイズを避ける)
+  driver_->motor_right->speed(static_cast<int>(right * 1000.0f), sensed.battery_voltage_average);
+  driver_->motor_left->speed(static_cast<int>(left * 1000.0f), sensed.battery_voltage_average);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+
+// Project
+#include "dri/driver.h"
+#include "dri/seqlock.h"
+#include "dri/spsc_queue.h"
+#include "feedforward.h"
+#include "motion_generator.h"
+#include "parameters.h"
+#include "pid.h"
+#include "sensor.h"
+#include "wall_control.h"
+
+/**
+ * 目標値の生成と速度・角速度の制御を行うクラス
+ * @details
+ * モーター電圧はモデルから求めたフィードフォワードに、速度・角速度のPIDで残差を足して決める。
+ * update()はCore 0の制御周期で呼び、動作の指令はCore 1からgetParameterQueue()に送る。
+ * 指令を1つ終えるごとに完了数を増やす。キューに続けて積んだ直進・スラロームは止まらずにつながる。
+ * PIDの基準のゲインはNVSに保存した値 (自動調整の結果) を使い、なければparameters.hの値を使う。
+ * 前進中は横壁制御の補正を角速度の目標値に足し、前壁合わせの間は壁センサから速度・角速度の目標値を決める。
+ */
+class Motion {
+ public:
+  // 溜めておける指令の数
+  static constexpr std::size_t PARAMETER_QUEUE_SIZE = 8;
+
+  using ParameterQueue = data::SpscQueue<MotionParameter, PARAMETER_QUEUE_SIZE>;
+
+  // 速度・角速度PIDの基準のゲイン (NVSに保存する)
+  struct Gain {
+    // 形式のバージョン
+    uint32_t version;
+    // 速度PIDゲイン
+    PidGain<float> velocity;
+    // 角速度PIDゲイン
+    PidGain<float> angular_velocity;
+    // version ~ angular_velocityのCRC32
+    uint32_t checksum;
+  };
+  static constexpr uint32_t GAIN_VERSION = 1;
+
+  explicit Motion(Driver *dri, Sensor *sensor);
+  ~Motion();
+
+  // 更新 (制御周期ごとに呼ぶ)
+  void update();
+
+  // 動作の指令を送るキューを取得
+  ParameterQueue &getParameterQueue() { return queue_; }
+
+  // 目標値を取得 (別のコアからも一貫した値を読める)
+  MotionTarget getTarget() const { return published_.load(); }
+
+  // 終えた指令の数を取得
+  uint32_t getCompleted() const { return completed_.load(std::memory_order_acquire); }
+
+  // 基準のゲインを変えてNVSに保存する (Core 1から呼ぶ、次の制御周期から使う)
+  bool setGain(const PidGain<float> &velocity, const PidGain<float> &angular_velocity);
+  // parameters.hのゲインに戻す
+  bool resetGain();
+  // 基準のゲインを取得
+  Gain getGain() const { return gain_.load(); }
+
+ private:
+  // ドライバ
+  Driver *driver_;
+  // センサ
+  Sensor *sensor_;
+
+  // 指令
+  ParameterQueue queue_;
+  // 目標値の生成
+  MotionGenerator generator_;
+  // 公開中の目標値
+  data::SeqLock<MotionTarget> published_;
+  // 終えた指令の数
+  std::atomic<uint32_t> completed_;
+
+  // モーターモデルによるフィードフォワード
+  Feedforward feedforward_;
+  // 速度PID (微分は計測値だけにかける2自由度)
+  PidController<float, PidStructure::TwoDof> velocity_pid_;
+  // 角速度PID
+  PidController<float, PidStructure::TwoDof> angular_velocity_pid_;
+  // 横壁制御
+  SideWallControl side_wall_;
+  // 前壁合わせ
+  FrontWallAlignment front_wall_;
+
+  using Schedule = GainSchedule<float, std::size(PID_SCHEDULE_VELOCITIES)>;
+  // NVSでのキー
+  static constexpr auto GAIN_KEY = "pid_gain";
+
+  // 基準のゲイン
+  data::SeqLock<Gain> gain_;
+  // スケジュールに反映した基準のゲインの版
+  uint32_t applied_gain_;
+  // 速度ごとのゲイン
+  Schedule velocity_schedule_;
+  Schedule angular_velocity_schedule_;
+
+  // NVSから基準のゲインを読む (なければparameters.hの値)
+  static Gain loadGain(Nvs &nvs);
+  // 次の指令を始める
+  void next();
+  // モーターを解放する
+  void coast();
+};
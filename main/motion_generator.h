@@ -0,0 +1,347 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Project
+#include "slalom.h"
+#include "trajectory.h"
+
+// 動作の向き
+enum class MotionDirection : uint8_t {
+  Forward,
+  Backward,
+  Right,
+  Left,
+};
+
+// 動作の種類
+enum class MotionPattern : uint8_t {
+  // モーターを解放する
+  Idle,
+  // 速度0を保つ
+  Stop,
+  // 直進
+  Straight,
+  // 超信地旋回
+  Turn,
+  // スラローム (テーブルの角速度を順に出す)
+  Slalom,
+  // 前壁合わせ (目標値は壁センサから決める)
+  FrontAlign,
+};
+
+// 動作の指令
+struct MotionParameter {
+  // 動作の種類
+  MotionPattern pattern;
+  // 向き (直進はForward/Backward、旋回・スラロームはRight/Left)
+  MotionDirection direction;
+  // 距離 [m] または角度 [rad] (0以上)
+  float distance;
+  // 打ち切る時間 [s] (前壁合わせのみ)
+  float timeout;
+  // 最大速度 [m/s]
+  float max_velocity;
+  // 加速度 [m/s^2]
+  float acceleration;
+  // 躍度 [m/s^3] (0の場合は台形加速)
+  float jerk;
+  // 終端速度 [m/s]
+  float end_velocity;
+  // 最大角速度 [rad/s]
+  float max_angular_velocity;
+  // 角加速度 [rad/s^2]
+  float angular_acceleration;
+  // 角躍度 [rad/s^3] (0の場合は台形加速)
+  float angular_jerk;
+  // スラロームのテーブル
+  const slalom::Table *slalom;
+};
+
+// 目標値
+struct MotionTarget {
+  // 動作の種類
+  MotionPattern pattern;
+  // 速度 [m/s]
+  float velocity;
+  // 加速度 [m/s^2]
+  float acceleration;
+  // 角速度 [rad/s]
+  float angular_velocity;
+  // 角加速度 [rad/s^2]
+  float angular_acceleration;
+  // 動作開始からの距離 [m]
+  float length;
+  // 動作開始からの角度 [rad]
+  float angle;
+};
+
+/**
+ * @brief 動作の指令から制御周期ごとの目標値を作る
+ * @details
+ * ハードウェアに依存しないため、ホストでもそのまま動かせる。
+ * 直進は現在の目標速度から始め、終わった後は終端速度を保つ。
+ * next()でキューから始める場合は続く指令を先読みし、同じ向きの直進・スラロームが続く間は
+ * 直進の終端速度を次の指令の開始速度に合わせて、止まらずにつなぐ。
+ */
+class MotionGenerator {
+ public:
+  // 先読みする指令の数
+  static constexpr std::size_t LOOKAHEAD = 4;
+
+  explicit MotionGenerator() { reset(); }
+  ~MotionGenerator() = default;
+
+  // 動作を止めてモーターを解放する
+  void reset() {
+    target_ = {MotionPattern::Idle, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    slalom_ = nullptr;
+    time_ = 0.0f;
+    tick_ = 0;
+    sign_ = 1.0f;
+    offset_ = 0.0f;
+    finished_ = true;
+    parameter_ = {};
+    open_ = false;
+    known_ = 0;
+    continued_ = false;
+  }
+
+  /**
+   * @brief 動作を始める
+   * @details Idle・Stopはすぐに終わる。直進は指令の終端速度で終わる
+   */
+  void start(const MotionParameter &parameter) {
+    open_ = false;
+    begin(parameter, parameter.end_velocity);
+  }
+
+  /**
+   * @brief キューから次の指令を取り出して始める (受信側から呼ぶ)
+   * @details 直進の終端速度は、続けて動ける指令をLOOKAHEAD個まで先読みして決める
+   * @return 指令を取り出した場合はtrue
+   */
+  template <typename Queue>
+  bool next(Queue &queue) {
+    MotionParameter parameter{};
+    if (!queue.receive(&parameter)) return false;
+    if (parameter.pattern != MotionPattern::Straight) {
+      start(parameter);
+      return true;
+    }
+    std::array<MotionParameter, LOOKAHEAD> following;
+    known_ = 0;
+    while (known_ < LOOKAHEAD && queue.peek(known_, &following[known_])) known_++;
+    begin(parameter, blend(parameter, following.data(), known_, open_));
+    return true;
+  }
+
+  /**
+   * @brief 直進の途中で届いた指令に合わせて終端速度を上げる (受信側から周期ごとに呼ぶ)
+   * @details 始めた時点で続く指令が足りず、指令の終端速度で終わる予定だった場合だけ、等速区間で計算し直す
+   */
+  template <typename Queue>
+  void lookahead(Queue &queue) {
+    if (!open_ || finished_ || target_.pattern != MotionPattern::Straight) return;
+    std::array<MotionParameter, LOOKAHEAD> following;
+    if (known_ >= LOOKAHEAD || !queue.peek(known_, &following[known_])) return;
+    // 計算し直すと加速度0から始まるので、加速度が0の等速区間でだけ計算し直す (加減速中は躍度の制限を超える)
+    if (std::abs(target_.acceleration) > 0.0f) return;
+    known_ = 0;
+    while (known_ < LOOKAHEAD && queue.peek(known_, &following[known_])) known_++;
+    auto end_velocity = blend(parameter_, following.data(), known_, open_);
+    if (end_velocity <= trajectory_.end_velocity()) return;
+    // 残りの距離を今の速度から計算し直す
+    offset_ = target_.length;
+    trajectory_.reset(parameter_.distance - std::abs(offset_), sign_ * target_.velocity, parameter_.max_velocity,
+                      end_velocity, parameter_.acceleration, parameter_.jerk);
+    time_ = 0.0f;
+  }
+
+  /**
+   * @brief 続く指令から直進の終端速度を決める
+   * @param current 直進の指令
+   * @param following 続く指令 (先頭から順に)
+   * @param count 続く指令の数
+   * @param open 続く指令がすべて続けて動ける (後から届く指令で上げられる) 場合はtrue
+   * @details
+   * 続けて動ける指令を後ろから順にたどり、各指令の開始速度の上限を求める。
+   * 最後の指令は指令の終端速度で終わるものとし、スラロームはテーブルの速度で入る。
+   */
+  [[nodiscard]] static float blend(const MotionParameter &current, const MotionParameter *following,
+                                   std::size_t count, bool &open) {
+    std::size_t chain = 0;
+    while (chain < count && continuous(current.direction, following[chain])) chain++;
+    open = chain == count;
+    if (chain == 0) return current.end_velocity;
+    // 次の指令の開始速度の上限
+    float velocity = 0.0f;
+    for (auto i = chain; i-- > 0;) {
+      const auto &parameter = following[i];
+      if (parameter.pattern == MotionPattern::Slalom) {
+        velocity = parameter.slalom->velocity;
+        continue;
+      }
+      auto end_velocity = i + 1 == chain ? parameter.end_velocity : std::min(velocity, parameter.max_velocity);
+      velocity = Trajectory::reachable_velocity(parameter.distance, end_velocity, parameter.max_velocity,
+                                                parameter.acceleration, parameter.jerk);
+    }
+    return std::min(velocity, current.max_velocity);
+  }
+
+  /**
+   * @brief 1周期進める
+   * @param dt 制御周期 [s]
+   * @return この周期で動作が終わった場合はtrue
+   */
+  bool update(float dt) {
+    if (finished_) return false;
+    if (target_.pattern == MotionPattern::Slalom) {
+      // テーブルは制御周期ごとなのでdtは使わない
+      target_.length += target_.velocity * dt;
+      target_.angle += target_.angular_velocity * dt;
+      tick_++;
+      if (tick_ >= slalom_->size) {
+        target_.angular_velocity = 0.0f;
+        target_.angular_acceleration = 0.0f;
+        finished_ = true;
+        return true;
+      }
+      replay();
+      return false;
+    }
+    time_ += dt;
+    if (target_.pattern == MotionPattern::FrontAlign) {
+      // 目標値は0のまま、合わなければ打ち切る
+      if (time_ < parameter_.timeout) return false;
+      finished_ = true;
+      return true;
+    }
+    apply(trajectory_.state(time_));
+    if (time_ >= trajectory_.duration()) {
+      finished_ = true;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief 外の条件で動作を終える (前壁合わせが合った場合など)
+   * @return 動作中だった場合はtrue
+   */
+  bool finish() {
+    if (finished_) return false;
+    target_.velocity = 0.0f;
+    target_.acceleration = 0.0f;
+    target_.angular_velocity = 0.0f;
+    target_.angular_acceleration = 0.0f;
+    finished_ = true;
+    return true;
+  }
+
+  [[nodiscard]] const MotionTarget &target() const { return target_; }
+  [[nodiscard]] bool finished() const { return finished_; }
+  // 実行中の指令が、前の直進から同じ向きに続く直進か
+  [[nodiscard]] bool continued() const { return continued_; }
+
+ private:
+  //! 目標値
+  MotionTarget target_;
+  //! 速度プロファイル
+  Trajectory trajectory_;
+  //! スラロームのテーブル
+  const slalom::Table *slalom_;
+  //! 動作開始からの時間 [s]
+  float time_;
+  //! スラロームの周期数
+  std::size_t tick_;
+  //! 向き
+  float sign_;
+  //! 計算し直す前に進んだ距離 [m]
+  float offset_;
+  //! 動作が終わったか
+  bool finished_;
+  //! 実行中の指令
+  MotionParameter parameter_;
+  //! 先読みした指令がすべて続けて動けたか
+  bool open_;
+  //! 先読みした指令の数
+  std::size_t known_;
+  //! 前の直進から同じ向きに続く直進か
+  bool continued_;
+
+  // 直進・スラロームが続けて動けるか
+  static bool continuous(MotionDirection direction, const MotionParameter &parameter) {
+    if (parameter.pattern == MotionPattern::Straight) return parameter.direction == direction;
+    return parameter.pattern == MotionPattern::Slalom && direction == MotionDirection::Forward;
+  }
+
+  // 終端速度を指定して動作を始める
+  void begin(const MotionParameter &parameter, float end_velocity) {
+    auto velocity = target_.velocity;
+    continued_ = parameter_.pattern == MotionPattern::Straight && parameter.pattern == MotionPattern::Straight &&
+                 continuous(parameter_.direction, parameter);
+    parameter_ = parameter;
+    target_ = {parameter.pattern, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    time_ = 0.0f;
+    tick_ = 0;
+    offset_ = 0.0f;
+    finished_ = false;
+    switch (parameter.pattern) {
+      case MotionPattern::Idle:
+      case MotionPattern::Stop:
+        finished_ = true;
+        break;
+      case MotionPattern::Straight:
+        sign_ = parameter.direction == MotionDirection::Backward ? -1.0f : 1.0f;
+        // 逆向きに動いている場合は0から始める
+        trajectory_.reset(parameter.distance, std::max(sign_ * velocity, 0.0f), parameter.max_velocity, end_velocity,
+                          parameter.acceleration, parameter.jerk);
+        break;
+      case MotionPattern::Turn:
+        // 左回りが正
+        sign_ = parameter.direction == MotionDirection::Right ? -1.0f : 1.0f;
+        trajectory_.reset(parameter.distance, 0.0f, parameter.max_angular_velocity, 0.0f,
+                          parameter.angular_acceleration, parameter.angular_jerk);
+        break;
+      case MotionPattern::Slalom:
+        sign_ = parameter.direction == MotionDirection::Right ? -1.0f : 1.0f;
+        slalom_ = parameter.slalom;
+        target_.velocity = slalom_->velocity;
+        break;
+      case MotionPattern::FrontAlign:
+        return;
+    }
+    if (finished_) return;
+    if (target_.pattern == MotionPattern::Slalom) {
+      replay();
+    } else {
+      apply(trajectory_.state(0.0f));
+    }
+  }
+
+  // スラロームのテーブルから目標値を出す
+  void replay() {
+    auto current = slalom_->angular_velocity[tick_];
+    auto next = tick_ + 1 < slalom_->size ? slalom_->angular_velocity[tick_ + 1] : 0.0f;
+    target_.angular_velocity = sign_ * current;
+    target_.angular_acceleration = sign_ * (next - current) * static_cast<float>(slalom::GENERATED_FREQUENCY);
+  }
+
+  void apply(const Trajectory::State &state) {
+    if (target_.pattern == MotionPattern::Straight) {
+      target_.length = offset_ + sign_ * state.position;
+      target_.velocity = sign_ * state.velocity;
+      target_.acceleration = sign_ * state.acceleration;
+    } else {
+      target_.angle = sign_ * state.position;
+      target_.angular_velocity = sign_ * state.velocity;
+      target_.angular_acceleration = sign_ * state.acceleration;
+    }
+  }
+};
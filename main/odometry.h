@@ -2,141 +2,45 @@
 
 // C++
 #include <cmath>
-#include <limits>
+#include <numbers>
 
 // Project
 #include "dri/driver.h"
+#include "fusion.h"
+#include "gyro_bias.h"
+#include "gyro_integrator.h"
 #include "parameters.h"
+#include "pose.h"
+#include "wheel.h"
 
 /**
  * @brief マウスの自己位置を推定する。
- * 速度はエンコーダーから算出。
+ * 車輪速度はエンコーダー・IMUの加速度・モーター電圧からオブザーバで推定。
+ * 速度は車輪速度とIMUの加速度から推定。
  * 加速度はIMUから取得。
  * 角速度はIMUから取得。
  * 角加速度はIMUから算出。
+ * 距離・角度・位置は実際の更新周期で台形積分する。
  * @details
  * 以下の記事を参考にした。
  * https://www.mech.tohoku-gakuin.ac.jp/rde/contents/course/robotics/wheelrobot.html
  * https://rikei-tawamure.com/entry/2020/05/22/232227
  */
 
-/**
- * @berif 左右車輪の値
- */
-struct WheelsPair {
-  float right;
-  float left;
-};
-
-/**
- * @brief 車輪から得られる車体情報を管理する
- */
-class Wheel {
- public:
-  /**
-   * @param resolution エンコーダーの分解能
-   * @param tire_diameter 車輪の直径 [mm]
-   * @param invert エンコーダーの回転方向を反転する
-   */
-  explicit Wheel(uint16_t resolution, float tire_diameter, bool invert)
-      : tire_diameter_(tire_diameter),
-        invert_(invert),
-        resolution_(resolution),
-        resolution_half_(resolution / 2),
-        angle_per_resolution_((2.0f * std::numbers::pi_v<float>) / static_cast<float>(resolution)) {}
-  ~Wheel() = default;
-
-  /**
-   * @brief 車輪情報を更新する
-   * @param current 最新の観測角度
-   * @param delta_us 更新周期 [us]
-   */
-  void update(uint16_t current, uint32_t delta_us) {
-    // 回転方向を反転
-    if (invert_) {
-      current = resolution_ - current;
-    }
-    if (reset_) [[unlikely]] {
-      previous_ = current;
-      reset_ = false;
-    }
-
-    auto angular_velocity = calculate_angular_velocity(current, delta_us);
-    auto current_velocity = angular_velocity * (tire_diameter_ / 2.0f);
-    velocity_ = (current_velocity + velocity_) / 2.0f;
-    angular_velocity_ = angular_velocity;
-    previous_ = current;
-  }
-
-  /**
-   * @brief リセット
-   */
-  void reset() {
-    reset_ = true;
-    angular_velocity_ = 0.0f;
-    velocity_ = 0.0f;
-  }
-
-  [[nodiscard]] float angular_velocity() const { return angular_velocity_; }
-  [[nodiscard]] float velocity() const { return velocity_; }
-
- private:
-  //! 車輪の直径 [mm]
-  const float tire_diameter_;
-
-  //! エンコーダーの回転方向を反転するか
-  const bool invert_;
-
-  //! 初期化後かどうか
-  bool reset_{true};
-
-  //! エンコーダーの分解能
-  uint16_t resolution_{0};
-
-  //! エンコーダーの分解能の半分
-  uint16_t resolution_half_{0};
-
-  //! 分解能あたりの角度 [rad]
-  float angle_per_resolution_{0};
-
-  //! 一つ前の観測角度
-  uint16_t previous_{0};
-
-  //! 車輪の角速度 [rad/s]
-  float angular_velocity_{0.0f};
-
-  //! 車輪位置の移動速度 [mm/s]
-  float velocity_{0.0f};
-
-  /**
-   * @brief 車輪エンコーダーの更新周期の差分を計算し角速度に変換する。
-   * @param current 最新の観測角度 [rad]
-   * @param delta_us 更新周期 [us]
-   * @return 車輪の角速度 [rad/s]
-   */
-  [[nodiscard]] float calculate_angular_velocity(uint16_t current, uint32_t delta_us) const {
-    // センサ値更新間隔(delta_us)での観測値の変化量を計算
-    auto delta = current - previous_;
-    if (std::abs(delta) >= resolution_half_) {
-      if (previous_ >= resolution_half_) {
-        delta += resolution_;
-      } else {
-        delta -= resolution_;
-      }
-    }
-    // 角度に変換
-    auto angle = static_cast<float>(delta) * angle_per_resolution_;
-    // 1msでの変化量に換算する
-    return angle * (1000'000.0f / static_cast<float>(delta_us));
-  }
-};
-
 class Odometry {
  public:
   explicit Odometry(Driver *dri)
       : dri_(dri),
         right_(dri_->encoder_right->resolution(), TIRE_DIAMETER, true),
-        left_(dri_->encoder_left->resolution(), TIRE_DIAMETER, false) {}
+        left_(dri_->encoder_left->resolution(), TIRE_DIAMETER, false),
+        fusion_({
+            .tread_width = TREAD_WIDTH,
+            .time_constant = VELOCITY_FUSION_TIME_CONSTANT,
+            .slip_time_constant = VELOCITY_FUSION_SLIP_TIME_CONSTANT,
+            .slip_filter_time_constant = SLIP_FILTER_TIME_CONSTANT,
+            .slip_velocity = SLIP_THRESHOLD_VELOCITY,
+            .slip_angular_velocity = SLIP_THRESHOLD_ANGULAR_VELOCITY,
+        }) {}
   ~Odometry() = default;
 
   /**
@@ -148,66 +52,111 @@ class Odometry {
     // 左
     left_.reset();
     // 車体
-    length_ = 0.0f;
-    angle_ = 0.0f;
+    fusion_.reset();
+    pose_.reset();
+    velocity_ = 0.0f;
+    angular_velocity_ = 0.0f;
+    // IMU
+    gyro_integrator_.reset();
   }
 
+  /**
+   * @brief ジャイロのバイアス推定をやり直す
+   */
+  void reset_gyro_bias() { gyro_bias_.reset(); }
+
   /**
    * @brief 車体情報を更新する
-   * @param delta_us 更新周期
+   * @param delta_us 更新周期 [us]
    */
   void update(uint32_t delta_us) {
-    // 右
-    right_.update(dri_->encoder_right->raw(), delta_us);
-    // 左
-    left_.update(dri_->encoder_left->raw(), delta_us);
+    // 同じ時刻で呼ばれた場合は積分できない
+    if (delta_us == 0) [[unlikely]] {
+      return;
+    }
+    auto dt = static_cast<float>(delta_us) / 1000'000.0f;
 
     // 車体加速度[mm/s^2]
     auto &accel = dri_->imu->linear_acceleration();
     acceleration_ = accel.y * 9.80665f;
-    // 車体速度 [mm/s]
+
+    // 車輪の角加速度を予測
+    // 左右共通の成分はIMUから、左右差はモーターの電圧と時定数から求める
+    auto common = acceleration_ / TIRE_RADIUS;
+    auto motor_right = motor_angular_acceleration(dri_->motor_right->voltage(), right_.angular_velocity());
+    auto motor_left = motor_angular_acceleration(dri_->motor_left->voltage(), left_.angular_velocity());
+    auto differential = (motor_right - motor_left) / 2.0f;
+    // エンコーダーは制御周期とは独立に積算されている
+    // 制御周期で割ると、周期内の読み出し回数 (0〜2回) で速度が振れるので、読み出した時刻の間隔で割る
+    auto counts = dri_->encoder_sampler->counts();
+    if (counts.samples != encoder_samples_) {
+      auto interval_us = encoder_samples_ == 0 ? delta_us : counts.timestamp - encoder_timestamp_;
+      encoder_samples_ = counts.samples;
+      encoder_timestamp_ = counts.timestamp;
+      // 右
+      right_.update_total(counts.right, interval_us, common + differential);
+      // 左
+      left_.update_total(counts.left, interval_us, common - differential);
+    }
     auto wheel_velo_right = right_.velocity();
     auto wheel_velo_left = left_.velocity();
-    velocity_ = (wheel_velo_right + wheel_velo_left) / 2.0f;
-    // 車体並進距離 [mm]
-    length_ = length_ + velocity_ / 1000.0f;
 
-    // 車体角加速度 [rad/s^2]
+    // 静止中にジャイロのバイアスを推定
     auto &gyro = dri_->imu->angular_rate();
-    auto angular_velocity = gyro.z / 1000.0f * std::numbers::pi_v<float> / 180.0f;
+    auto raw_angular_velocity = gyro.z / 1000.0f * std::numbers::pi_v<float> / 180.0f;
+    auto accel_norm = std::sqrt(accel.x * accel.x + accel.y * accel.y + accel.z * accel.z);
+    gyro_bias_.update(raw_angular_velocity, wheel_velo_right, wheel_velo_left, accel_norm);
+
     // 車体角速度 [rad/s]
-    angular_acceleration_ = angular_velocity - angular_velocity_;
+    auto angular_velocity = raw_angular_velocity - gyro_bias_.bias();
+    // 車体角加速度 [rad/s^2]
+    angular_acceleration_ = (angular_velocity - angular_velocity_) / dt;
     angular_velocity_ = angular_velocity;
-    // 車体角度 [rad]
-    auto angle = angle_ + angular_velocity_ / 1000.0f;
-
-    // x, yの位置を推定
-    if (std::fabs(angular_velocity_) <= std::numeric_limits<float>::epsilon()) {
-      // 直線運動
-      auto a = velocity_ * static_cast<float>(delta_us) / 1000'000.0f;
-      x_ += a * std::cos(angle);
-      y_ += a * std::sin(angle);
+
+    // 車体速度 [mm/s] (エンコーダーと加速度を融合)
+    velocity_ = fusion_.update(wheel_velo_right, wheel_velo_left, acceleration_, angular_velocity_, dt);
+
+    // 車体並進距離・角度・位置
+    if (!dri_->imu->use_fifo()) {
+      pose_.update(velocity_, angular_velocity_, dt);
     } else {
-      // 曲線近似
-      auto delta = (angle - angle_) / 2.0f;
-      auto a = 2.0f * velocity_ / angular_velocity_ * std::sin(delta);
-      auto b = angle + delta;
-      x_ += a * std::cos(b);
-      y_ += a * std::sin(b);
+      // FIFOの各サンプルを計測時刻の間隔で積分 (サンプルが届かなかった周期は角度を変えない)
+      auto delta_angle = gyro_integrator_.update(dri_->imu->samples(), [&](const ImuFifo::Sample &sample) {
+        auto rate = dri_->imu->to_angular_rate(sample.gyro).z;
+        return rate / 1000.0f * std::numbers::pi_v<float> / 180.0f - gyro_bias_.bias();
+      });
+      pose_.update(velocity_, angular_velocity_, delta_angle, dt);
     }
-    angle_ = angle;
   }
 
   [[nodiscard]] float acceleration() const { return acceleration_; }
   [[nodiscard]] float velocity() const { return velocity_; }
-  [[nodiscard]] float length() const { return length_; }
+  [[nodiscard]] float length() const { return pose_.length(); }
   [[nodiscard]] float angular_acceleration() const { return angular_acceleration_; }
   [[nodiscard]] float angular_velocity() const { return angular_velocity_; };
-  [[nodiscard]] float angle() const { return angle_; }
-  [[nodiscard]] float x() const { return x_; }
-  [[nodiscard]] float y() const { return y_; }
+  [[nodiscard]] float angle() const { return pose_.angle(); }
+  [[nodiscard]] float x() const { return pose_.x(); }
+  [[nodiscard]] float y() const { return pose_.y(); }
+  [[nodiscard]] const GyroBias &gyro_bias() const { return gyro_bias_; }
+  [[nodiscard]] float slip() const { return fusion_.slip(); }
+  [[nodiscard]] bool slipping() const { return fusion_.slipping(); }
 
  private:
+  //! モーター電圧に対する車輪の定常角速度 [rad/s/mV]
+  static constexpr float WHEEL_ANGULAR_VELOCITY_PER_VOLTAGE =
+      2.0f * std::numbers::pi_v<float> / 60.0f / (MOTOR_KE * GEAR_RATIO);
+
+  /**
+   * @brief モーターの1次遅れモデルから車輪の角加速度を求める
+   * @param voltage モーター電圧 [mV]
+   * @param angular_velocity 車輪の角速度 [rad/s]
+   * @return 車輪の角加速度 [rad/s^2]
+   */
+  static float motor_angular_acceleration(int voltage, float angular_velocity) {
+    auto steady = static_cast<float>(voltage) * WHEEL_ANGULAR_VELOCITY_PER_VOLTAGE;
+    return (steady - angular_velocity) / MOTOR_TIME_CONSTANT;
+  }
+
   //! センサ値を取得するためのドライバクラス
   Driver *dri_;
 
@@ -220,18 +169,27 @@ class Odometry {
   //! 車体並進加速度 [mm/s^2]
   float acceleration_{0.0f};
 
-  //! 車体並進距離 [mm]
-  float length_{};
-
   //! 車体角速度 [rad/s]
   float angular_velocity_{0.0f};
 
   //! 車体角加速度 [rad/s^2]
   float angular_acceleration_{0.0f};
 
-  //! 車体角度 [rad]
-  float angle_{0.0f};
+  //! 車体並進距離・角度・位置
+  Pose pose_;
+
+  //! 車体速度の推定
+  VelocityFusion<float> fusion_;
+
+  //! ジャイロのバイアス推定
+  GyroBias gyro_bias_;
+
+  //! FIFOのサンプルの積分
+  GyroIntegrator gyro_integrator_;
+
+  //! 最後に使ったエンコーダーの読み出し回数 (0は未使用)
+  uint32_t encoder_samples_{0};
 
-  //! 車体位置 [mm]
-  float x_{0.0f}, y_{0.0f};
+  //! 最後に使ったエンコーダーの読み出し時刻 [us]
+  uint32_t encoder_timestamp_{0};
 };
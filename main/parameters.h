@@ -1,6 +1,7 @@
 #pragma once
 
 // C++
+#include <cstddef>
 #include <cstdint>
 #include <numbers>
 
@@ -33,36 +34,176 @@ constexpr float GEAR_RATIO = 38.0f / 9.0f;
 constexpr float TIRE_DIAMETER = 12.80f;
 // タイヤの半径 [mm]
 constexpr float TIRE_RADIUS = TIRE_DIAMETER / 2.0f;
+// モーターの機械的時定数 (車体を載せた状態) [s]
+constexpr float MOTOR_TIME_CONSTANT = 0.05f;
+// 旋回時のモーターの機械的時定数 (車体の慣性モーメントを含む) [s]
+constexpr float MOTOR_ANGULAR_TIME_CONSTANT = 0.03f;
+// 摩擦に打ち勝つためのモーター電圧 [V]
+constexpr float MOTOR_FRICTION_VOLTAGE = 0.04f;
 
 // 動作停止電圧 [V]
 constexpr float VOLTAGE_LOW_LIMIT = 3.2f;
 // モーター電圧上限 [V]
 constexpr float VOLTAGE_MOTOR_LIMIT = 2.5f;
 
+// 制御周波数 [Hz]
+constexpr uint32_t CONTROL_FREQUENCY = 1'000;
+static_assert(CONTROL_FREQUENCY == 1'000 || CONTROL_FREQUENCY == 2'000 || CONTROL_FREQUENCY == 4'000,
+              "CONTROL_FREQUENCY must be 1, 2 or 4 kHz");
+// 制御周期 [us]
+constexpr uint32_t CONTROL_PERIOD_US = 1'000'000 / CONTROL_FREQUENCY;
+// テレメトリ送信中のUARTのボーレート [bps]
+constexpr uint32_t TELEMETRY_BAUD_RATE = 2'000'000;
+// テレメトリの送信周波数 [Hz] (制御周期ごとのフレームを間引く)
+constexpr uint32_t TELEMETRY_FREQUENCY = 1'000;
+static_assert(CONTROL_FREQUENCY % TELEMETRY_FREQUENCY == 0, "TELEMETRY_FREQUENCY must divide CONTROL_FREQUENCY");
+
 // 最小速度 [m/s]
 constexpr float VELOCITY_MIN = 0.1f;
 // デフォルト速度 [m/s]
 constexpr float VELOCITY_DEFAULT = 0.3f;
 // デフォルト加速度 [m/s^2]
 constexpr float ACCELERATION_DEFAULT = 1.0f;
+// デフォルト躍度 [m/s^3] (0の場合は台形加速)
+constexpr float JERK_DEFAULT = 100.0f;
 // 速度PIDゲイン
-constexpr float VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {0.6f, 0.01f, 0.05f};
+constexpr float VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {1.0f, 20.0f, 0.0f};
 // 最小角速度 [rad/s]
 constexpr float ANGULAR_VELOCITY_MIN = std::numbers::pi_v<float> / 10.0f;
 // デフォルト角速度 [rad/s]
 constexpr float ANGULAR_VELOCITY_DEFAULT = std::numbers::pi_v<float>;
 // デフォルト角加速度 [rad/s^2]
 constexpr float ANGULAR_ACCELERATION_DEFAULT = 20 * std::numbers::pi_v<float>;
+// デフォルト角躍度 [rad/s^3] (0の場合は台形加速)
+constexpr float ANGULAR_JERK_DEFAULT = 2000 * std::numbers::pi_v<float>;
+// スラロームの速度 [m/s] (tools/slalomでこの速度ごとのテーブルを作る)
+constexpr float SLALOM_VELOCITIES[] = {0.3f, 0.5f, 0.7f, 1.0f};
+// スラロームの遠心加速度の上限 [m/s^2]
+constexpr float SLALOM_LATERAL_ACCELERATION_LIMIT = 6.0f;
+// スラロームの旋回で各タイヤにかかる接線加速度の上限 [m/s^2]
+constexpr float SLALOM_WHEEL_ACCELERATION_LIMIT = 5.0f;
+// 最短走行で逆起電圧に使うモーター電圧の割合 (残りは加減速と制御に使う)
+constexpr float ROUTE_BACK_EMF_RATIO = 0.7f;
+// 最短走行の加速度 [m/s^2]
+constexpr float ROUTE_ACCELERATION = 5.0f;
+// 最短走行の躍度 [m/s^3]
+constexpr float ROUTE_JERK = 250.0f;
 // 角速度PIDゲイン
-constexpr float ANGULAR_VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {0.6f, 0.01f, 0.05f};
+constexpr float ANGULAR_VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {0.02f, 0.4f, 0.0f};
+// PIDの微分の1次フィルタ時定数 [s]
+constexpr float PID_DERIVATIVE_TIME_CONSTANT = 0.005f;
+// PIDの積分飽和対策 (逆算) の時定数 [s]
+constexpr float PID_TRACKING_TIME_CONSTANT = 0.02f;
+// PIDゲインを切り替える速度 [m/s]
+constexpr float PID_SCHEDULE_VELOCITIES[] = {0.0f, 1.0f, 3.0f};
+// 速度ごとに速度PIDゲインに掛ける倍率 (高速ではモデルの誤差が大きくなるので強める)
+constexpr float VELOCITY_PID_SCHEDULE[] = {1.0f, 1.0f, 1.5f};
+// 速度ごとに角速度PIDゲインに掛ける倍率
+constexpr float ANGULAR_VELOCITY_PID_SCHEDULE[] = {1.0f, 1.0f, 1.5f};
+
+// システム同定の並進の入力電圧の振幅 [V]
+constexpr float SYSID_VOLTAGE = 0.3f;
+// システム同定の旋回の入力電圧の振幅 [V] (左右に逆向きにかける)
+constexpr float SYSID_ANGULAR_VOLTAGE = 0.1f;
+// システム同定のステップ入力の長さ [s] (前半だけ電圧をかける)
+constexpr float SYSID_STEP_TIME = 0.5f;
+// システム同定のM系列の長さ [s]
+constexpr float SYSID_PRBS_TIME = 0.8f;
+// システム同定のM系列の1ビットの長さ [s]
+constexpr float SYSID_PRBS_BIT_TIME = 0.01f;
+// システム同定のチャープの長さ [s]
+constexpr float SYSID_CHIRP_TIME = 0.7f;
+// システム同定のチャープの開始・終了周波数 [Hz]
+constexpr float SYSID_CHIRP_FREQUENCY_MIN = 1.0f;
+constexpr float SYSID_CHIRP_FREQUENCY_MAX = 20.0f;
+// tools/sysidでゲインを決める時の閉ループの時定数 [s]
+constexpr float SYSID_CLOSED_LOOP_TIME_CONSTANT = 0.02f;
+// 自動調整のリレー実験の目標速度 [m/s]
+constexpr float AUTOTUNE_VELOCITY = 0.3f;
+// 自動調整の並進のリレーの振幅 [V]
+constexpr float AUTOTUNE_RELAY_VOLTAGE = 0.2f;
+// 自動調整の並進のリレーのヒステリシス幅 [m/s] (速度の雑音より少し大きく)
+constexpr float AUTOTUNE_VELOCITY_HYSTERESIS = 0.002f;
+// 自動調整のリレー実験の目標角速度 [rad/s]
+constexpr float AUTOTUNE_ANGULAR_VELOCITY = 2.0f * std::numbers::pi_v<float>;
+// 自動調整の旋回のリレーの振幅 [V]
+constexpr float AUTOTUNE_ANGULAR_RELAY_VOLTAGE = 0.05f;
+// 自動調整の旋回のリレーのヒステリシス幅 [rad/s]
+constexpr float AUTOTUNE_ANGULAR_VELOCITY_HYSTERESIS = 0.05f;
+// 自動調整で読み捨てる周期・平均する周期の数
+constexpr uint32_t AUTOTUNE_SETTLE_CYCLES = 10;
+constexpr uint32_t AUTOTUNE_MEASURE_CYCLES = 20;
+// 自動調整を打ち切る時間 [s]
+constexpr float AUTOTUNE_TIMEOUT = 1.5f;
+
+// 車輪速度オブザーバの帯域 [rad/s]
+constexpr float VELOCITY_OBSERVER_BANDWIDTH = 150.0f;
+// 車輪速度オブザーバの減衰比
+constexpr float VELOCITY_OBSERVER_DAMPING = 0.8f;
+// 速度推定の相補フィルタ時定数 [s]
+constexpr float VELOCITY_FUSION_TIME_CONSTANT = 0.05f;
+// スリップ中の速度推定の相補フィルタ時定数 [s]
+constexpr float VELOCITY_FUSION_SLIP_TIME_CONSTANT = 1.0f;
+// スリップ指標の平滑化時定数 [s]
+constexpr float SLIP_FILTER_TIME_CONSTANT = 0.01f;
+// スリップとみなす並進速度差 [mm/s]
+constexpr float SLIP_THRESHOLD_VELOCITY = 50.0f;
+// スリップとみなす角速度差 [rad/s]
+constexpr float SLIP_THRESHOLD_ANGULAR_VELOCITY = 1.0f;
 
 // 壁センサでの壁有無しきい値 (r90, r45, l45, l90)
 constexpr int WALL_THRESHOLD_EXIST[NUM_PARAMETER_WALL] = {0, 0, 0, 0};
+// 壁センサでの壁有無判定のヒステリシス幅 (r90, r45, l45, l90)
+constexpr int WALL_THRESHOLD_HYSTERESIS[NUM_PARAMETER_WALL] = {20, 20, 20, 20};
+// 壁センサの中央値フィルタの窓幅
+constexpr std::size_t WALL_FILTER_SIZE = 5;
+// 壁有無の確信度を計算する履歴数
+constexpr std::size_t WALL_HISTORY_SIZE = 16;
 // 壁センサの迷路中央基準値 (r90, r45, l45, l90)
 constexpr int WALL_REFERENCE_VALUE[NUM_PARAMETER_WALL] = {0, 0, 0, 0};
 // 横壁制御PIDゲイン
 constexpr float WALL_ADJUST_SIDE_PID_GAIN[NUM_PARAMETER_PID] = {0.0f, 0.0f, 0.0f};
+// 横壁制御で足す角速度の上限 [rad/s]
+constexpr float WALL_ADJUST_SIDE_LIMIT = 3.0f;
+// 横壁制御を行う最低速度 [m/s]
+constexpr float WALL_ADJUST_MIN_VELOCITY = 0.1f;
+// 壁の有無が切り替わった後・柱の後に横壁制御でその側を使わない距離 [mm]
+constexpr float WALL_ADJUST_MASK_LENGTH = 20.0f;
+// 柱とみなす1周期あたりの45度センサの変化量
+constexpr int WALL_ADJUST_POST_DELTA = 30;
+// 45度センサの壁切れ(立ち下がり)を検出した時の、区画境界に対する車体中心の位置 [mm]
+constexpr float WALL_EDGE_FALLING_OFFSET = -27.0f;
+// 45度センサの壁の始まり(立ち上がり)を検出した時の、区画境界に対する車体中心の位置 [mm]
+constexpr float WALL_EDGE_RISING_OFFSET = -33.0f;
+// 壁切れで位置を補正する範囲 [mm]
+constexpr float WALL_EDGE_SNAP_WINDOW = 20.0f;
+// 前壁センサ(90度)の左右の間隔 [mm]
+constexpr float WALL_FRONT_SENSOR_SPACING = 24.0f;
+// 前壁で位置・角度を補正する最大距離 [mm]
+constexpr float WALL_FRONT_CORRECTION_RANGE = 120.0f;
+// 前壁での補正の1周期あたりのゲイン
+constexpr float WALL_FRONT_CORRECTION_GAIN = 0.1f;
+// 前壁合わせの距離の差に対する速度のゲイン [(m/s)/mm]
+constexpr float WALL_ALIGN_DISTANCE_GAIN = 0.02f;
+// 前壁合わせの角度に対する角速度のゲイン [(rad/s)/rad]
+constexpr float WALL_ALIGN_ANGLE_GAIN = 10.0f;
+// 前壁合わせの最大速度 [m/s]
+constexpr float WALL_ALIGN_MAX_VELOCITY = 0.1f;
+// 前壁合わせの最大角速度 [rad/s]
+constexpr float WALL_ALIGN_MAX_ANGULAR_VELOCITY = 1.0f;
+// 前壁合わせで合ったとみなす距離の差 [mm]
+constexpr float WALL_ALIGN_DISTANCE_TOLERANCE = 1.0f;
+// 前壁合わせで合ったとみなす角度 [rad]
+constexpr float WALL_ALIGN_ANGLE_TOLERANCE = 0.01f;
+// 前壁合わせで合った状態が続けば終える周期の数
+constexpr uint32_t WALL_ALIGN_SETTLE_COUNT = 50;
+// 前壁合わせを打ち切る時間 [s]
+constexpr float WALL_ALIGN_TIMEOUT = 0.5f;
 
+// 迷路の区画の大きさ [mm]
+constexpr float MAZE_SECTION_SIZE = 90.0f;
+// 迷路の壁の厚さ [mm]
+constexpr float MAZE_WALL_THICKNESS = 6.0f;
 // 迷路の大きさ
 constexpr int MAZE_SIZE_X = 32;
 constexpr int MAZE_SIZE_Y = 32;
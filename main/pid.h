@@ -1,40 +1,212 @@
 #pragma once
 
-#include <cmath>
+// C++
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
-class Pid {
- private:
-  float gain_kp_{};
-  float gain_ki_{};
-  float gain_kd_{};
+// PIDゲイン
+template <std::floating_point T>
+struct PidGain {
+  T kp;
+  T ki;
+  T kd;
+};
 
-  // 前回の誤差量
-  float prev_error_{};
+// 制御器の構造
+enum class PidStructure : uint8_t {
+  // 比例・積分 (kdは使わない)
+  Pi,
+  // 比例・積分・微分
+  Pid,
+  // 2自由度 (比例・微分に入れる目標値に重みを掛ける)
+  TwoDof,
+};
 
-  // 誤差の積分値
-  float sum_error_{};
+// 積分の飽和 (ワインドアップ) 対策
+enum class AntiWindup : uint8_t {
+  // 対策しない
+  None,
+  // 出力が飽和していて、さらに飽和させる向きの場合は積分しない
+  Conditional,
+  // 飽和で削られた分を時定数で積分から差し引く
+  BackCalculation,
+};
 
+// 制御器の設定
+template <std::floating_point T>
+struct PidConfig {
+  // ゲイン
+  PidGain<T> gain;
+  // 出力の下限・上限
+  T output_min = -std::numeric_limits<T>::infinity();
+  T output_max = std::numeric_limits<T>::infinity();
+  // 積分の飽和対策
+  AntiWindup anti_windup = AntiWindup::None;
+  // 逆算の時定数 [s] (BackCalculationで使う)
+  T tracking_time_constant = static_cast<T>(0);
+  // 微分の1次フィルタの時定数 [s] (0の場合はフィルタしない)
+  T derivative_time_constant = static_cast<T>(0);
+  // 比例・微分に入れる目標値の重み (TwoDofで使う、1で通常のPID)
+  T setpoint_weight_p = static_cast<T>(1);
+  T setpoint_weight_d = static_cast<T>(1);
+};
+
+/**
+ * @brief PID制御器
+ * @details
+ * u = kp (b r - y) + ki ∫(r - y) dt + kd d(c r - y)/dt を出力の上限・下限で制限する。
+ * 積分は台形近似で、ゲインを掛けた後の値を持つため、ゲインを途中で変えても出力が跳ねない。
+ * 微分は1次フィルタを通し、初回は前回値がないので0とする (積分の前回の誤差は0から始める)。
+ * ヒープを使わず、すべてconstexprで計算できる。
+ * 参考:
+ * https://controlabo.com/pid-program/
+ */
+template <std::floating_point T, PidStructure S = PidStructure::Pid>
+class PidController {
  public:
-  explicit Pid(float kp, float ki, float kd) {
-    gain_kp_ = kp;
-    gain_ki_ = ki;
-    gain_kd_ = kd;
-    reset();
-  }
+  using Config = PidConfig<T>;
 
-  void reset() {
-    prev_error_ = 0.0f;
-    sum_error_ = 0.0f;
+  constexpr explicit PidController(const Config &config) : config_(config) { reset(); }
+  // 制限・フィルタなしのPID
+  constexpr explicit PidController(T kp, T ki, T kd) : PidController(Config{.gain = {kp, ki, kd}}) {}
+  constexpr ~PidController() = default;
+
+  constexpr void reset() {
+    integral_ = static_cast<T>(0);
+    derivative_ = static_cast<T>(0);
+    prev_error_ = static_cast<T>(0);
+    prev_input_ = static_cast<T>(0);
+    first_ = true;
   }
 
-  float update(float target, float current, float t) {
-    // 積分値は台形近似
-    // https://controlabo.com/pid-program/
+  /**
+   * @param target 目標値
+   * @param current 現在値
+   * @param dt 制御周期 [s]
+   * @return 操作量
+   */
+  constexpr T update(T target, T current, T dt) {
     auto error = target - current;
-    sum_error_ += (error + prev_error_) * t / 2.0f;
-    auto ret = gain_kp_ * error + gain_ki_ * sum_error_ + gain_kd_ * (error - prev_error_) / t;
+    auto input = (S == PidStructure::TwoDof ? config_.setpoint_weight_d : static_cast<T>(1)) * target - current;
+    if (first_) {
+      prev_input_ = input;
+      first_ = false;
+    }
+
+    // 比例
+    auto weight_p = S == PidStructure::TwoDof ? config_.setpoint_weight_p : static_cast<T>(1);
+    auto proportional = config_.gain.kp * (weight_p * target - current);
+
+    // 微分 (1次フィルタ)
+    if constexpr (S != PidStructure::Pi) {
+      auto raw = config_.gain.kd * (input - prev_input_) / dt;
+      auto alpha = config_.derivative_time_constant / (config_.derivative_time_constant + dt);
+      derivative_ = alpha * derivative_ + (static_cast<T>(1) - alpha) * raw;
+      prev_input_ = input;
+    }
+
+    // 積分 (台形近似)
+    auto increment = config_.gain.ki * (error + prev_error_) * dt / static_cast<T>(2);
     prev_error_ = error;
+    auto unsaturated = proportional + integral_ + increment + derivative_;
+    auto output = std::clamp(unsaturated, config_.output_min, config_.output_max);
+    switch (config_.anti_windup) {
+      case AntiWindup::None:
+        integral_ += increment;
+        break;
+      case AntiWindup::Conditional: {
+        auto upper = unsaturated > config_.output_max;
+        auto lower = unsaturated < config_.output_min;
+        if ((!upper && !lower) || (upper && increment < static_cast<T>(0)) ||
+            (lower && increment > static_cast<T>(0))) {
+          integral_ += increment;
+        }
+        break;
+      }
+      case AntiWindup::BackCalculation:
+        integral_ += increment + (output - unsaturated) * dt / config_.tracking_time_constant;
+        break;
+    }
+    return std::clamp(proportional + integral_ + derivative_, config_.output_min, config_.output_max);
+  }
+
+  // ゲインを変える (ゲインスケジュール用)
+  constexpr void gain(const PidGain<T> &gain) { config_.gain = gain; }
+  [[nodiscard]] constexpr const PidGain<T> &gain() const { return config_.gain; }
 
-    return ret;
+  // 出力の下限・上限を変える (前段の出力で残りの余裕が変わる場合)
+  // 余裕がなく下限が上限を超える場合は中間の値に固定する
+  constexpr void limit(T output_min, T output_max) {
+    if (output_min > output_max) {
+      output_min = output_max = (output_min + output_max) / static_cast<T>(2);
+    }
+    config_.output_min = output_min;
+    config_.output_max = output_max;
   }
+
+  [[nodiscard]] constexpr const Config &config() const { return config_; }
+  [[nodiscard]] constexpr T integral() const { return integral_; }
+  [[nodiscard]] constexpr T derivative() const { return derivative_; }
+
+ private:
+  //! 設定
+  Config config_;
+  //! 積分項 (ゲインを掛けた後の値)
+  T integral_;
+  //! フィルタ後の微分項
+  T derivative_;
+  //! 前回の誤差
+  T prev_error_;
+  //! 前回の微分の入力
+  T prev_input_;
+  //! 初回かどうか
+  bool first_;
+};
+
+// これまでのPID (制限・フィルタなし、以前と違い初回の微分は0)
+using Pid = PidController<float>;
+
+/**
+ * @brief 速度などの値に応じてゲインを線形補間する
+ * @details キーは昇順に並べる。範囲外は端のゲインを使う
+ */
+template <std::floating_point T, std::size_t N>
+class GainSchedule {
+  static_assert(N > 0, "GainSchedule needs at least one point.");
+
+ public:
+  /**
+   * @param keys キー (昇順)
+   * @param base 基準のゲイン
+   * @param scales キーごとに基準のゲインに掛ける倍率
+   */
+  constexpr explicit GainSchedule(const T (&keys)[N], const PidGain<T> &base, const T (&scales)[N])
+      : keys_(), gains_() {
+    for (std::size_t i = 0; i < N; i++) {
+      keys_[i] = keys[i];
+      gains_[i] = {base.kp * scales[i], base.ki * scales[i], base.kd * scales[i]};
+    }
+  }
+
+  [[nodiscard]] constexpr PidGain<T> at(T key) const {
+    if (key <= keys_[0]) return gains_[0];
+    for (std::size_t i = 1; i < N; i++) {
+      if (key < keys_[i]) {
+        auto ratio = (key - keys_[i - 1]) / (keys_[i] - keys_[i - 1]);
+        const auto &a = gains_[i - 1];
+        const auto &b = gains_[i];
+        return {a.kp + (b.kp - a.kp) * ratio, a.ki + (b.ki - a.ki) * ratio, a.kd + (b.kd - a.kd) * ratio};
+      }
+    }
+    return gains_[N - 1];
+  }
+
+ private:
+  //! キー
+  T keys_[N];
+  //! キーごとのゲイン
+  PidGain<T> gains_[N];
 };
@@ -0,0 +1,122 @@
+#pragma once
+
+// C++
+#include <cmath>
+#include <cstdint>
+
+// Project
+#include "dri/average.h"
+#include "fastmath.h"
+
+/**
+ * @brief 車体速度と角速度から走行距離・角度・位置を積分する
+ * @details
+ * 実際の更新周期で台形積分する。
+ * 位置は1周期の間を一定曲率の円弧とみなし、弦の長さと向きから求める。
+ * 車体角度のsin/cosは保持しておき、1周期の変化量だけ加法定理で回転させる。
+ * 丸め誤差が溜まらないよう、一定回数ごとに角度から計算し直す。
+ * 距離と角度は長時間の走行で積算値が大きくなるため、補償付きで積算する。
+ */
+class Pose {
+ public:
+  explicit Pose() { reset(); }
+  ~Pose() = default;
+
+  /**
+   * @brief リセット
+   */
+  void reset() {
+    velocity_ = 0.0f;
+    angular_velocity_ = 0.0f;
+    length_.reset();
+    angle_.reset();
+    x_ = 0.0f;
+    y_ = 0.0f;
+    heading_ = {0.0f, 1.0f};
+    counts_ = 0;
+  }
+
+  /**
+   * @brief 角速度から角度を積分して更新する
+   * @param velocity 車体速度 [mm/s]
+   * @param angular_velocity 車体角速度 [rad/s]
+   * @param dt 更新周期 [s]
+   */
+  void update(float velocity, float angular_velocity, float dt) {
+    update(velocity, angular_velocity, (angular_velocity_ + angular_velocity) / 2.0f * dt, dt);
+  }
+
+  /**
+   * @brief 別に積分した角度の変化量で更新する
+   * @param velocity 車体速度 [mm/s]
+   * @param angular_velocity 車体角速度 [rad/s]
+   * @param delta_angle 更新周期での角度の変化量 [rad]
+   * @param dt 更新周期 [s]
+   */
+  void update(float velocity, float angular_velocity, float delta_angle, float dt) {
+    // 台形積分
+    auto distance = (velocity_ + velocity) / 2.0f * dt;
+    // 弦の向きは角度変化の中間
+    auto half = delta_angle / 2.0f;
+    auto small = std::fabs(half) <= SMALL_ANGLE;
+    // 円弧近似 (弦の長さ = 弧の長さ * sin(θ/2) / (θ/2))
+    fastmath::SinCos rotation, direction;
+    float chord;
+    if (small) [[likely]] {
+      // 保持しているsin/cosを回転させる
+      rotation = fastmath::sincos_small(half);
+      direction = fastmath::rotate(heading_, rotation);
+      chord = distance * fastmath::sinc_small(half);
+    } else {
+      rotation = fastmath::sincos(half);
+      direction = fastmath::sincos(angle_.value() + half);
+      chord = distance * rotation.sin / half;
+    }
+    x_ += chord * direction.cos;
+    y_ += chord * direction.sin;
+    length_.update(distance);
+    angle_.update(delta_angle);
+
+    // 弦の向きから更に半分回転すると新しい車体角度になる
+    if (small && ++counts_ < RESYNC_COUNTS) [[likely]] {
+      heading_ = fastmath::rotate(direction, rotation);
+    } else {
+      heading_ = fastmath::sincos(angle_.value());
+      counts_ = 0;
+    }
+    velocity_ = velocity;
+    angular_velocity_ = angular_velocity;
+  }
+
+  [[nodiscard]] float length() const { return length_.value(); }
+  [[nodiscard]] float angle() const { return angle_.value(); }
+  [[nodiscard]] float x() const { return x_; }
+  [[nodiscard]] float y() const { return y_; }
+
+ private:
+  //! 加法定理で回転させる角度の変化量の半分の上限 [rad]
+  static constexpr float SMALL_ANGLE = 0.1f;
+  //! sin/cosを角度から計算し直す周期 [回]
+  static constexpr uint32_t RESYNC_COUNTS = 1024;
+
+  //! 前回の車体速度 [mm/s]
+  float velocity_;
+
+  //! 前回の車体角速度 [rad/s]
+  float angular_velocity_;
+
+  //! 車体並進距離 [mm]
+  data::KahanSum<float> length_;
+
+  //! 車体角度 [rad]
+  data::KahanSum<float> angle_;
+
+  //! 車体位置 [mm]
+  float x_, y_;
+
+  //! 車体角度のsin/cos
+  fastmath::SinCos heading_;
+
+  //! 前回計算し直してからの更新回数
+  uint32_t counts_;
+};
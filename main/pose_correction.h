@@ -0,0 +1,271 @@
+#pragma once
+
+// C++
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+// Project
+#include "fastmath.h"
+#include "map.h"
+#include "parameters.h"
+
+/**
+ * @brief 迷路の区画を基準にした車体の姿勢
+ */
+struct MazePose {
+  // 区画
+  Map::Coord coord;
+  // 最も近い方位
+  Map::Direction direction;
+  // 区画中心からの前後方向の位置 [mm] (directionの向きが正)
+  float offset;
+  // 区画中心からの左右方向の位置 [mm] (左が正)
+  float lateral;
+  // directionからの角度のずれ [rad] (左回りが正)
+  float heading;
+};
+
+/**
+ * @brief 壁センサで自己位置を迷路の区画に合わせて補正する
+ * @details
+ * オドメトリの変化量を迷路座標 (区画(0, 0)の中心が原点、東がx、北がy) で積算し、
+ * 以下の観測で前後方向の位置と角度を補正する。
+ * - 45度センサの壁切れ・柱: 壁の有無が切り替わった位置は区画境界からの距離が決まっている
+ * - 90度センサの前壁: 左右の距離の平均から前壁までの距離、差から壁に対する角度が分かる
+ * 横方向の位置は壁制御で合わせるため、ここでは補正しない。
+ */
+class PoseCorrection {
+ public:
+  // 壁センサの観測値
+  struct Observation {
+    // 左45度で壁あり
+    bool left;
+    // 右45度で壁あり
+    bool right;
+    // 左90度の値
+    int front_left;
+    // 右90度の値
+    int front_right;
+    // 前壁あり
+    bool front;
+  };
+
+  /**
+   * @param reference_left 区画中心での左90度の値
+   * @param reference_right 区画中心での右90度の値
+   */
+  explicit PoseCorrection(int reference_left = WALL_REFERENCE_VALUE[PARAMETER_WALL_LEFT90],
+                          int reference_right = WALL_REFERENCE_VALUE[PARAMETER_WALL_RIGHT90])
+      : reference_left_(reference_left), reference_right_(reference_right) {
+    reset({0, 0}, Map::DIRECTION_NORTH, 0.0f, 0.0f, 0.0f, 0.0f);
+  }
+  ~PoseCorrection() = default;
+
+  /**
+   * @brief 現在の姿勢を設定する
+   * @param coord 区画
+   * @param direction 方位
+   * @param offset 区画中心からの前後方向の位置 [mm]
+   * @param x オドメトリのx [mm]
+   * @param y オドメトリのy [mm]
+   * @param angle オドメトリの角度 [rad]
+   */
+  void reset(Map::Coord coord, Map::Direction direction, float offset, float x, float y, float angle) {
+    auto forward = unit(direction);
+    x_ = static_cast<float>(coord.x) * MAZE_SECTION_SIZE + forward.x * offset;
+    y_ = static_cast<float>(coord.y) * MAZE_SECTION_SIZE + forward.y * offset;
+    angle_offset_ = cardinal(direction) - angle;
+    odom_x_ = x;
+    odom_y_ = y;
+    angle_ = angle;
+    left_ = false;
+    right_ = false;
+    edges_ = false;
+    corrections_ = 0;
+    update_pose();
+  }
+
+  /**
+   * @brief オドメトリがリセットされた時に、迷路上の姿勢を保ったまま基準を合わせ直す
+   */
+  void rebase(float x, float y, float angle) {
+    angle_offset_ += angle_ - angle;
+    odom_x_ = x;
+    odom_y_ = y;
+    angle_ = angle;
+    update_pose();
+  }
+
+  /**
+   * @brief オドメトリと壁センサで姿勢を更新する
+   * @param x オドメトリのx [mm]
+   * @param y オドメトリのy [mm]
+   * @param angle オドメトリの角度 [rad]
+   * @param observation 壁センサの観測値
+   * @return 補正後の姿勢
+   */
+  const MazePose &update(float x, float y, float angle, const Observation &observation) {
+    // オドメトリの変化量を迷路座標に回転して積算
+    auto dx = x - odom_x_;
+    auto dy = y - odom_y_;
+    auto rotation = fastmath::sincos(angle_offset_);
+    auto mx = rotation.cos * dx - rotation.sin * dy;
+    auto my = rotation.sin * dx + rotation.cos * dy;
+    x_ += mx;
+    y_ += my;
+    odom_x_ = x;
+    odom_y_ = y;
+    angle_ = angle;
+    update_pose();
+
+    // 区画の方位に沿って前進している間だけ補正する
+    auto forward = unit(pose_.direction);
+    auto advance = forward.x * mx + forward.y * my;
+    auto straight = std::fabs(pose_.heading) < STRAIGHT_HEADING && advance > 0.0f;
+
+    // 45度センサの壁切れ・柱
+    if (straight && edges_) {
+      if (observation.left != left_) {
+        snap_edge(observation.left ? WALL_EDGE_RISING_OFFSET : WALL_EDGE_FALLING_OFFSET);
+      }
+      if (observation.right != right_) {
+        snap_edge(observation.right ? WALL_EDGE_RISING_OFFSET : WALL_EDGE_FALLING_OFFSET);
+      }
+    }
+    left_ = observation.left;
+    right_ = observation.right;
+    edges_ = straight;
+
+    // 90度センサの前壁
+    if (observation.front && std::fabs(pose_.heading) < STRAIGHT_HEADING) {
+      correct_front(observation.front_left, observation.front_right);
+    }
+    update_pose();
+    return pose_;
+  }
+
+  [[nodiscard]] const MazePose &pose() const { return pose_; }
+  // 迷路座標での位置 [mm]
+  [[nodiscard]] float x() const { return x_; }
+  [[nodiscard]] float y() const { return y_; }
+  // 迷路座標での角度 [rad] (東が0、左回りが正)
+  [[nodiscard]] float angle() const { return angle_ + angle_offset_; }
+  // 補正した回数
+  [[nodiscard]] uint32_t corrections() const { return corrections_; }
+
+ private:
+  //! 区画の方位に沿っているとみなす角度のずれ [rad]
+  static constexpr float STRAIGHT_HEADING = 0.1f;
+  //! 区画中心にいる時の、車体中心から前壁の表面までの距離 [mm]
+  static constexpr float FRONT_WALL_DISTANCE = (MAZE_SECTION_SIZE - MAZE_WALL_THICKNESS) / 2.0f;
+
+  struct Vector {
+    float x;
+    float y;
+  };
+
+  //! 区画中心での90度センサの値
+  const int reference_left_, reference_right_;
+  //! 迷路座標での位置 [mm]
+  float x_, y_;
+  //! 迷路座標での角度とオドメトリの角度の差 [rad]
+  float angle_offset_;
+  //! オドメトリの前回値
+  float odom_x_, odom_y_, angle_;
+  //! 45度センサの前回値
+  bool left_, right_;
+  //! 前回も壁切れを検出できる状態だったか
+  bool edges_;
+  //! 補正した回数
+  uint32_t corrections_;
+  //! 区画基準の姿勢
+  MazePose pose_;
+
+  // 方位の角度 (東が0、左回りが正)
+  static float cardinal(Map::Direction direction) {
+    return std::numbers::pi_v<float> / 2.0f * (1.0f - static_cast<float>(direction));
+  }
+
+  // 方位の単位ベクトル
+  static Vector unit(Map::Direction direction) {
+    switch (direction) {
+      default:
+      case Map::DIRECTION_NORTH:
+        return {0.0f, 1.0f};
+      case Map::DIRECTION_EAST:
+        return {1.0f, 0.0f};
+      case Map::DIRECTION_SOUTH:
+        return {0.0f, -1.0f};
+      case Map::DIRECTION_WEST:
+        return {-1.0f, 0.0f};
+    }
+  }
+
+  // 進行方向の座標で最も近い区画境界 (区画中心から半区画ずれた位置)
+  static float nearest_boundary(float position) {
+    return (std::round(position / MAZE_SECTION_SIZE - 0.5f) + 0.5f) * MAZE_SECTION_SIZE;
+  }
+
+  // 迷路座標から区画基準の姿勢を求める
+  void update_pose() {
+    auto angle = angle_ + angle_offset_;
+    // 最も近い方位 (北が0で右回り)
+    auto quarter = std::round((std::numbers::pi_v<float> / 2.0f - angle) / (std::numbers::pi_v<float> / 2.0f));
+    auto direction = static_cast<Map::Direction>(static_cast<int>(quarter) & 0x03);
+    pose_.direction = direction;
+    pose_.heading = std::remainder(angle - cardinal(direction), 2.0f * std::numbers::pi_v<float>);
+    pose_.coord.x = static_cast<int>(std::round(x_ / MAZE_SECTION_SIZE));
+    pose_.coord.y = static_cast<int>(std::round(y_ / MAZE_SECTION_SIZE));
+    auto forward = unit(direction);
+    auto rx = x_ - static_cast<float>(pose_.coord.x) * MAZE_SECTION_SIZE;
+    auto ry = y_ - static_cast<float>(pose_.coord.y) * MAZE_SECTION_SIZE;
+    pose_.offset = forward.x * rx + forward.y * ry;
+    pose_.lateral = -forward.y * rx + forward.x * ry;
+  }
+
+  // 進行方向の位置を移動する
+  void move_forward(float distance) {
+    auto forward = unit(pose_.direction);
+    x_ += forward.x * distance;
+    y_ += forward.y * distance;
+    corrections_++;
+  }
+
+  // 壁切れの位置に合わせる
+  void snap_edge(float edge_offset) {
+    auto forward = unit(pose_.direction);
+    auto position = forward.x * x_ + forward.y * y_;
+    auto expected = nearest_boundary(position - edge_offset) + edge_offset;
+    auto error = expected - position;
+    if (std::fabs(error) < WALL_EDGE_SNAP_WINDOW) {
+      move_forward(error);
+    }
+  }
+
+  // 前壁までの距離と角度に合わせる
+  void correct_front(int front_left, int front_right) {
+    // 未調整の場合は補正しない
+    if (reference_left_ <= 0 || reference_right_ <= 0 || front_left <= 0 || front_right <= 0) {
+      return;
+    }
+    // 反射光は距離の2乗に反比例するとみなす
+    auto left = FRONT_WALL_DISTANCE * std::sqrt(static_cast<float>(reference_left_) / static_cast<float>(front_left));
+    auto right =
+        FRONT_WALL_DISTANCE * std::sqrt(static_cast<float>(reference_right_) / static_cast<float>(front_right));
+    auto distance = (left + right) / 2.0f;
+    if (distance > WALL_FRONT_CORRECTION_RANGE) {
+      return;
+    }
+
+    // 前後方向の位置
+    auto forward = unit(pose_.direction);
+    auto position = forward.x * x_ + forward.y * y_;
+    auto wall = nearest_boundary(position + distance + MAZE_WALL_THICKNESS / 2.0f) - MAZE_WALL_THICKNESS / 2.0f;
+    move_forward(WALL_FRONT_CORRECTION_GAIN * (wall - distance - position));
+
+    // 壁に対する角度 (左に回ると左のセンサが遠くなる)
+    auto heading = std::atan2(left - right, WALL_FRONT_SENSOR_SPACING);
+    angle_offset_ += WALL_FRONT_CORRECTION_GAIN * (heading - pose_.heading);
+  }
+};
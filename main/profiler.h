@@ -0,0 +1,199 @@
+#pragma once
+
+// C++
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#ifdef ESP_PLATFORM
+// ESP-IDF
+#include <esp_cpu.h>
+#include <sdkconfig.h>
+#else
+// C++
+#include <chrono>
+#endif
+
+// Project
+#include "dri/histogram.h"
+
+// リリースビルド (NDEBUG) では計測を取り除く
+#ifndef PROFILER_ENABLED
+#ifdef NDEBUG
+#define PROFILER_ENABLED 0
+#else
+#define PROFILER_ENABLED 1
+#endif
+#endif
+
+namespace profiler {
+// 計測を有効にするか
+inline constexpr bool ENABLED = PROFILER_ENABLED != 0;
+
+// 計測区間
+enum Stage : uint8_t {
+  STAGE_BATTERY,
+  STAGE_PHOTO,
+  STAGE_IMU,
+  STAGE_PHOTO_WAIT,
+  STAGE_ODOMETRY,
+  STAGE_WALL,
+  STAGE_POSE_CORRECTION,
+  STAGE_MOTION,
+  NUM_STAGE,
+};
+
+// 計測区間の名前
+inline constexpr std::array<const char *, NUM_STAGE> STAGE_NAMES = {
+    "battery", "photo", "imu", "photo_wait", "odometry", "wall", "pose_correction", "motion",
+};
+
+#ifdef ESP_PLATFORM
+// 1 usあたりのカウント (CPUサイクル)
+inline constexpr uint32_t COUNTS_PER_US = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ;
+// 現在のカウント
+inline uint32_t now() { return esp_cpu_get_cycle_count(); }
+#else
+// 1 usあたりのカウント (ホストではナノ秒)
+inline constexpr uint32_t COUNTS_PER_US = 1'000;
+// 現在のカウント
+inline uint32_t now() {
+  return static_cast<uint32_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+#endif
+
+/**
+ * @brief 計測区間ごとの所要カウントの分布を保持する
+ * @details
+ * 分布は制御ループだけが読み書きする。他のコアからは次のように要求し、制御ループが次の記録で処理する。
+ * - リセット: requestReset()で要求し、記録の前に行う
+ * - 読み出し: requestSnapshot()で要求し、記録の後に分布を写す。snapshotTaken()になったら表示する
+ */
+class Profiler {
+ public:
+  // ビン数
+  static constexpr std::size_t HISTOGRAM_SIZE = 64;
+  // ビン幅 [us] (64 binで512 usまでを記録する)
+  static constexpr uint32_t HISTOGRAM_WIDTH_US = 8;
+
+  using Histogram = data::Histogram<uint32_t, HISTOGRAM_SIZE>;
+
+  using Histograms = std::array<Histogram, NUM_STAGE>;
+
+  explicit Profiler()
+      : histograms_{make_histograms(std::make_index_sequence<NUM_STAGE>())},
+        snapshot_{make_histograms(std::make_index_sequence<NUM_STAGE>())} {}
+  ~Profiler() = default;
+
+  void reset() {
+    for (auto &histogram : histograms_) {
+      histogram.reset();
+    }
+    last_.fill(0);
+  }
+
+  // リセットを要求 (他のコアから呼ぶ)
+  void requestReset() { reset_requested_.store(true, std::memory_order_release); }
+
+  /**
+   * @brief 分布の写しを要求する (他のコアから呼ぶ)
+   * @return 要求の番号 (snapshotTaken()に渡す)
+   */
+  uint32_t requestSnapshot() { return snapshot_requested_.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+  // 要求した写しが取られたかどうか
+  [[nodiscard]] bool snapshotTaken(uint32_t request) const {
+    return snapshot_taken_.load(std::memory_order_acquire) == request;
+  }
+
+  // 所要カウントを記録
+  void update(Stage stage, uint32_t counts) {
+    if (reset_requested_.load(std::memory_order_relaxed)) [[unlikely]] {
+      reset_requested_.store(false, std::memory_order_relaxed);
+      reset();
+    }
+    histograms_[stage].update(counts);
+    last_[stage] = counts;
+    if (auto request = snapshot_requested_.load(std::memory_order_acquire);
+        request != snapshot_taken_.load(std::memory_order_relaxed)) [[unlikely]] {
+      snapshot_ = histograms_;
+      snapshot_taken_.store(request, std::memory_order_release);
+    }
+  }
+
+  // 計測区間の分布 (制御ループから読む)
+  [[nodiscard]] const Histogram &histogram(Stage stage) const { return histograms_[stage]; }
+
+  // 計測区間の直近の所要カウント (制御ループから読む)
+  [[nodiscard]] uint32_t last(Stage stage) const { return last_[stage]; }
+
+  // 最後に写した計測区間の分布 (snapshotTaken()の後、次の要求までに読む)
+  [[nodiscard]] const Histogram &snapshot(Stage stage) const { return snapshot_[stage]; }
+
+  // カウントを時間 [us] に換算
+  static float to_us(float counts) { return counts / static_cast<float>(COUNTS_PER_US); }
+
+  // 最後に写した統計を表示
+  void print() const {
+    printf("%-16s %8s %8s %8s %8s %8s\n", "stage [us]", "count", "min", "mean", "p99", "max");
+    for (std::size_t i = 0; i < NUM_STAGE; i++) {
+      const auto &histogram = snapshot_[i];
+      printf("%-16s %8u %8.1f %8.1f %8.1f %8.1f\n", STAGE_NAMES[i], static_cast<unsigned>(histogram.count()),
+             static_cast<double>(to_us(static_cast<float>(histogram.min()))),
+             static_cast<double>(to_us(histogram.mean())),
+             static_cast<double>(to_us(static_cast<float>(histogram.percentile(0.99f)))),
+             static_cast<double>(to_us(static_cast<float>(histogram.max()))));
+    }
+  }
+
+ private:
+  //! 計測区間ごとの所要カウント
+  Histograms histograms_;
+  //! 計測区間ごとの直近の所要カウント
+  std::array<uint32_t, NUM_STAGE> last_{};
+  //! 他のコアに渡す分布の写し
+  Histograms snapshot_;
+  //! リセットの要求
+  std::atomic<bool> reset_requested_{false};
+  //! 写しを要求した回数
+  std::atomic<uint32_t> snapshot_requested_{0};
+  //! 写しを取った要求の番号
+  std::atomic<uint32_t> snapshot_taken_{0};
+
+  template <std::size_t... I>
+  static Histograms make_histograms(std::index_sequence<I...>) {
+    return {((void)I, Histogram(0, HISTOGRAM_WIDTH_US * COUNTS_PER_US))...};
+  }
+};
+
+// 制御ループの計測結果
+inline Profiler instance;
+
+/**
+ * @brief スコープを抜けるまでの所要カウントを記録する
+ * @details 計測を無効にした場合は何もしない (最適化で消える)
+ */
+class Scope {
+ public:
+  explicit Scope(Stage stage) : stage_(stage), start_() {
+    if constexpr (ENABLED) {
+      start_ = now();
+    }
+  }
+  ~Scope() {
+    if constexpr (ENABLED) {
+      instance.update(stage_, now() - start_);
+    }
+  }
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+ private:
+  Stage stage_;
+  uint32_t start_;
+};
+}  // namespace profiler
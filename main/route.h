@@ -0,0 +1,323 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+// Project
+#include "feedforward.h"
+#include "map.h"
+#include "motion_generator.h"
+#include "parameters.h"
+#include "slalom.h"
+#include "trajectory.h"
+
+// 区画ごとの動作 (区画の辺の中央から次の辺の中央へ)
+enum class RouteAction : uint8_t {
+  Straight,
+  Right,
+  Left,
+};
+
+// 走行の区間
+struct RouteSegment {
+  enum Kind : uint8_t {
+    // 直進
+    KIND_STRAIGHT,
+    // 斜めの直進
+    KIND_DIAGONAL,
+    // スラローム (前後の直線を含む)
+    KIND_SLALOM,
+  };
+
+  // 種類
+  Kind kind;
+  // スラロームの種類と向き
+  slalom::Type type;
+  MotionDirection direction;
+  // 直進の距離 [mm]
+  float length;
+  // スラロームのテーブル (planで決まる)
+  const slalom::Table *table;
+  // 最大・開始・終了速度 [m/s] (planで決まる)
+  float max_velocity;
+  float entry_velocity;
+  float exit_velocity;
+  // 予測時間 [s] (planで決まる)
+  float time;
+};
+
+/**
+ * @brief 最短経路を走行の区間に変換し、区間ごとの速度を決める
+ * @details
+ * compileで区画ごとの動作を直進・斜め・スラロームの区間にまとめ、planで全区間を通して速度を決める。
+ * 速度は、加速度の上限で前から順に求めた速度と、減速度の上限で後ろから順に求めた速度の小さい方にする。
+ * スラロームはテーブルの速度で曲がるため、前後の区間がその速度に届かない場合は遅いテーブルに下げてやり直す。
+ */
+class Route {
+ public:
+  explicit Route() : acceleration_(ROUTE_ACCELERATION), jerk_(ROUTE_JERK) {}
+  ~Route() = default;
+
+  // モーター電圧の上限から決まる最高速度 [m/s]
+  static constexpr float top_velocity() {
+    // 逆起電圧に使える電圧で出せる速度
+    return VOLTAGE_MOTOR_LIMIT * ROUTE_BACK_EMF_RATIO / Feedforward::VELOCITY_CONSTANT;
+  }
+
+  // 進行方向の変化を区画ごとの動作にする (最短経路にUターンはない)
+  static RouteAction relative(Map::Direction from, Map::Direction to) {
+    switch ((to - from) & 0x03) {
+      case 1:
+        return RouteAction::Right;
+      case 3:
+        return RouteAction::Left;
+      default:
+        return RouteAction::Straight;
+    }
+  }
+
+  /**
+   * @brief 区画ごとの動作を区間にまとめる
+   * @details
+   * 区画の辺の中央から始まり、最後の区画 (ゴール、直進) の辺の中央で終わる。
+   * 大回り・180度は区画の中央から区画の中央へ、斜めの出入り・V90は辺の中央から辺の中央へ曲がる。
+   * @return 斜めの途中に直進がある (並びが不正な) 場合はfalse
+   */
+  bool compile(const std::vector<RouteAction> &actions) {
+    segments_.clear();
+    actions_ = &actions;
+    // 辺の中央から数えた直進の距離 (大回りの後は区画の中央から始まるので半区画残る)
+    float straight = 0.0f;
+    float diagonal = 0.0f;
+    bool on_diagonal = false;
+    // 斜めで直前に通った区画の動作
+    RouteAction previous = RouteAction::Straight;
+    std::size_t i = 0;
+    while (i < actions.size()) {
+      auto current = actions[i];
+      auto next = at(i + 1);
+      auto after_next = at(i + 2);
+      // 止まった状態からは曲がれないので、最初のターンの前には直進を残す
+      auto fits = [&](float needed) { return segments_.empty() ? straight > needed : straight >= needed; };
+      if (!on_diagonal) {
+        if (current == RouteAction::Straight) {
+          straight += MAZE_SECTION_SIZE;
+          i++;
+        } else if (next == RouteAction::Straight && fits(HALF) && i + 1 < actions.size()) {
+          // 大回り90度: 前の区画の中央から次の区画の中央へ
+          flush(straight - HALF);
+          push(slalom::TURN_LARGE_90, current);
+          straight = HALF;
+          i += 2;
+        } else if (next == current && after_next == opposite(current) && fits(0.0f)) {
+          // 135度で斜めに入る: 次の区画から斜め
+          flush(straight);
+          push(slalom::TURN_135_IN, current);
+          straight = 0.0f;
+          on_diagonal = true;
+          previous = opposite(current);
+          i++;
+        } else if (next == current && after_next == RouteAction::Straight && fits(HALF) &&
+                   i + 2 < actions.size()) {
+          // 180度: 前の区画の中央から隣の列の区画の中央へ
+          flush(straight - HALF);
+          push(slalom::TURN_180, current);
+          straight = HALF;
+          i += 3;
+        } else if (next == opposite(current) && fits(MAZE_SECTION_SIZE)) {
+          // 45度で斜めに入る: 手前の1区画から曲がり始める
+          flush(straight - MAZE_SECTION_SIZE);
+          push(slalom::TURN_45_IN, current);
+          straight = 0.0f;
+          on_diagonal = true;
+          previous = current;
+          i++;
+        } else {
+          flush(straight);
+          push(slalom::TURN_90, current);
+          straight = 0.0f;
+          i++;
+        }
+        if (on_diagonal) diagonal = 0.0f;
+        continue;
+      }
+
+      // 斜め: 左右交互のターンが続く間は1区画ずつ斜めに進む
+      if (current == RouteAction::Straight) {
+        actions_ = nullptr;
+        return false;
+      }
+      if (current == previous) {
+        // 135度で直進に戻る
+        flush_diagonal(diagonal);
+        push(slalom::TURN_135_OUT, current);
+        on_diagonal = false;
+        i++;
+      } else if (next == RouteAction::Straight) {
+        // 45度で直進に戻る: 次の区画の終わりまで
+        flush_diagonal(diagonal);
+        push(slalom::TURN_45_OUT, current);
+        on_diagonal = false;
+        i += 2;
+      } else if (next == current && after_next == opposite(current)) {
+        // V90: 2区画で斜めのまま向きを変える
+        flush_diagonal(diagonal);
+        push(slalom::TURN_V90, current);
+        diagonal = 0.0f;
+        previous = current;
+        i += 2;
+      } else {
+        diagonal += DIAGONAL;
+        previous = current;
+        i++;
+      }
+    }
+    flush(straight);
+    actions_ = nullptr;
+    return true;
+  }
+
+  /**
+   * @brief 区間ごとの速度を決める
+   * @param max_velocity 直進の最高速度 [m/s] (top_velocity()を超えない)
+   * @param turn_velocity スラロームの最高速度 [m/s]
+   * @return この速度・加速度では曲がれないターンがある場合はfalse
+   */
+  bool plan(float max_velocity, float turn_velocity, float acceleration = ROUTE_ACCELERATION,
+            float jerk = ROUTE_JERK) {
+    acceleration_ = acceleration;
+    jerk_ = jerk;
+    max_velocity = std::min(max_velocity, top_velocity());
+    for (auto &segment : segments_) {
+      if (segment.kind == RouteSegment::KIND_SLALOM) {
+        segment.table = slalom::find(segment.type, turn_velocity);
+        if (segment.table == nullptr) return false;
+        segment.max_velocity = segment.table->velocity;
+      } else {
+        segment.max_velocity = max_velocity;
+      }
+    }
+
+    // 区間の境目の速度 (最初と最後は停止)
+    auto size = segments_.size();
+    velocities_.assign(size + 1, 0.0f);
+    // スラロームを遅いテーブルに下げた場合はやり直す (下げるたびに速度が減るので必ず終わる)
+    for (auto changed = true; changed;) {
+      for (std::size_t i = 1; i < size; i++) {
+        velocities_[i] = std::min(segments_[i - 1].max_velocity, segments_[i].max_velocity);
+      }
+      velocities_[0] = 0.0f;
+      velocities_[size] = 0.0f;
+      // 前から: 加速度の上限
+      for (std::size_t i = 0; i < size; i++) {
+        velocities_[i + 1] = std::min(velocities_[i + 1], reachable(segments_[i], velocities_[i]));
+      }
+      // 後ろから: 減速度の上限
+      for (std::size_t i = size; i-- > 0;) {
+        velocities_[i] = std::min(velocities_[i], reachable(segments_[i], velocities_[i + 1]));
+      }
+      changed = false;
+      for (std::size_t i = 0; i < size; i++) {
+        auto &segment = segments_[i];
+        if (segment.kind != RouteSegment::KIND_SLALOM) continue;
+        auto velocity = std::min(velocities_[i], velocities_[i + 1]);
+        if (velocity < segment.table->velocity - 1e-3f) {
+          auto table = slalom::find(segment.type, velocity);
+          if (table == nullptr) return false;
+          segment.table = table;
+          segment.max_velocity = table->velocity;
+          changed = true;
+        }
+      }
+    }
+
+    // 区間ごとの速度と時間
+    time_ = 0.0f;
+    Trajectory trajectory;
+    for (std::size_t i = 0; i < size; i++) {
+      auto &segment = segments_[i];
+      segment.entry_velocity = velocities_[i];
+      segment.exit_velocity = velocities_[i + 1];
+      if (segment.kind == RouteSegment::KIND_SLALOM) {
+        const auto &table = *segment.table;
+        segment.length = table.before + table.after;
+        segment.time = static_cast<float>(table.size) / static_cast<float>(CONTROL_FREQUENCY) +
+                       segment.length / 1000.0f / table.velocity;
+      } else {
+        trajectory.reset(segment.length / 1000.0f, segment.entry_velocity, segment.max_velocity,
+                         segment.exit_velocity, acceleration_, jerk_);
+        segment.time = trajectory.duration();
+      }
+      time_ += segment.time;
+    }
+    return true;
+  }
+
+  // 区間
+  [[nodiscard]] const std::vector<RouteSegment> &segments() const { return segments_; }
+  // 予測時間 [s]
+  [[nodiscard]] float time() const { return time_; }
+  // planで使った加速度 [m/s^2] と躍度 [m/s^3]
+  [[nodiscard]] float acceleration() const { return acceleration_; }
+  [[nodiscard]] float jerk() const { return jerk_; }
+
+ private:
+  // 半区画 [mm]
+  static constexpr float HALF = MAZE_SECTION_SIZE / 2.0f;
+  // 斜めの1区画 [mm]
+  static constexpr float DIAGONAL = MAZE_SECTION_SIZE / 2.0f * std::numbers::sqrt2_v<float>;
+
+  //! 区間
+  std::vector<RouteSegment> segments_;
+  //! 区間の境目の速度
+  std::vector<float> velocities_;
+  //! compile中の動作
+  const std::vector<RouteAction> *actions_ = nullptr;
+  //! 加速度・躍度
+  float acceleration_, jerk_;
+  //! 予測時間
+  float time_ = 0.0f;
+
+  // 範囲外は直進として扱う
+  [[nodiscard]] RouteAction at(std::size_t i) const {
+    return i < actions_->size() ? (*actions_)[i] : RouteAction::Straight;
+  }
+
+  static RouteAction opposite(RouteAction action) {
+    return action == RouteAction::Right ? RouteAction::Left : RouteAction::Right;
+  }
+
+  void flush(float length) {
+    if (length > 0.0f) {
+      segments_.push_back({RouteSegment::KIND_STRAIGHT, slalom::TURN_90, MotionDirection::Forward, length, nullptr,
+                           0.0f, 0.0f, 0.0f, 0.0f});
+    }
+  }
+
+  void flush_diagonal(float length) {
+    if (length > 0.0f) {
+      segments_.push_back({RouteSegment::KIND_DIAGONAL, slalom::TURN_90, MotionDirection::Forward, length, nullptr,
+                           0.0f, 0.0f, 0.0f, 0.0f});
+    }
+  }
+
+  void push(slalom::Type type, RouteAction action) {
+    auto direction = action == RouteAction::Right ? MotionDirection::Right : MotionDirection::Left;
+    segments_.push_back({RouteSegment::KIND_SLALOM, type, direction, 0.0f, nullptr, 0.0f, 0.0f, 0.0f, 0.0f});
+  }
+
+  // 区間の一方の端の速度から、もう一方の端で出せる最高速度
+  [[nodiscard]] float reachable(const RouteSegment &segment, float velocity) const {
+    if (segment.kind == RouteSegment::KIND_SLALOM) {
+      // スラロームは一定速度
+      return segment.max_velocity;
+    }
+    return Trajectory::reachable_velocity(segment.length / 1000.0f, velocity, segment.max_velocity, acceleration_,
+                                          jerk_);
+  }
+};
@@ -0,0 +1,123 @@
+#include "run.h"
+
+// C++
+#include <cmath>
+#include <numbers>
+
+// ESP-IDF
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// コンストラクタ
+Run::Run(Sensor *sensor, Motion *motion)
+    : sensor_(sensor), motion_(motion), issued_(motion->getCompleted()), velocity_(0.0f) {}
+// デストラクタ
+Run::~Run() = default;
+
+void Run::send(const MotionParameter &parameter) {
+  while (!motion_->getParameterQueue().send(&parameter)) {
+    vTaskDelay(1);
+  }
+  issued_++;
+}
+
+// 直進
+void Run::straight(MotionDirection direction, float distance, float acceleration, float max_velocity,
+                   float end_velocity, float jerk) {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Straight;
+  param.direction = direction;
+  param.distance = distance / 1000.0f;
+  param.max_velocity = max_velocity;
+  param.acceleration = acceleration;
+  param.end_velocity = end_velocity;
+  param.jerk = jerk;
+  send(param);
+  velocity_ = direction == MotionDirection::Forward ? end_velocity : 0.0f;
+}
+
+// 超信地旋回
+void Run::turn(float angle, float angular_acceleration, float angular_velocity, MotionDirection direction,
+               float angular_jerk) {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Turn;
+  param.direction = direction;
+  param.distance = angle * std::numbers::pi_v<float> / 180.0f;
+  param.max_angular_velocity = angular_velocity;
+  param.angular_acceleration = angular_acceleration;
+  param.angular_jerk = angular_jerk;
+  send(param);
+  velocity_ = 0.0f;
+}
+
+// スラローム
+bool Run::slalom(slalom::Type type, MotionDirection direction, float velocity) {
+  auto table = slalom::find(type, velocity);
+  if (table == nullptr) return false;
+  // 入る速度がテーブルと違うと、スラロームの開始で速度が跳ぶ
+  if (std::abs(velocity_ - table->velocity) > 1e-3f) return false;
+  slalom(*table, direction);
+  return true;
+}
+
+void Run::slalom(const slalom::Table &table, MotionDirection direction) {
+  // 前後の直線はテーブルの速度のまま進む
+  if (table.before > 0.0f) {
+    straight(MotionDirection::Forward, table.before, ACCELERATION_DEFAULT, table.velocity, table.velocity);
+  }
+  MotionParameter param{};
+  param.pattern = MotionPattern::Slalom;
+  param.direction = direction;
+  param.slalom = &table;
+  send(param);
+  if (table.after > 0.0f) {
+    straight(MotionDirection::Forward, table.after, ACCELERATION_DEFAULT, table.velocity, table.velocity);
+  }
+  velocity_ = table.velocity;
+}
+
+// 経路を走る
+void Run::follow(const Route &route) {
+  for (const auto &segment : route.segments()) {
+    if (segment.kind == RouteSegment::KIND_SLALOM) {
+      slalom(*segment.table, segment.direction);
+    } else {
+      straight(MotionDirection::Forward, segment.length, route.acceleration(), segment.max_velocity,
+               segment.exit_velocity, route.jerk());
+    }
+  }
+}
+
+// 前壁合わせ
+void Run::align(float timeout) {
+  MotionParameter param{};
+  param.pattern = MotionPattern::FrontAlign;
+  param.timeout = timeout;
+  send(param);
+  velocity_ = 0.0f;
+}
+
+// 速度0を保つ
+void Run::hold() {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Stop;
+  send(param);
+  velocity_ = 0.0f;
+}
+
+// 送った指令がすべて終わるまで待つ
+void Run::wait() {
+  // 完了数は折り返すので差で比べる
+  while (static_cast<int32_t>(issued_ - motion_->getCompleted()) > 0) {
+    vTaskDelay(1);
+  }
+}
+
+// モーターを解放する (解放されるまで待つ)
+void Run::stop() {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Idle;
+  send(param);
+  velocity_ = 0.0f;
+  wait();
+}
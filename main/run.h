@@ -0,0 +1,95 @@
+#pragma once
+
+// C++
+#include <cstdint>
+
+// Project
+#include "motion.h"
+#include "parameters.h"
+#include "route.h"
+#include "slalom.h"
+#include "sensor.h"
+
+/**
+ * 走行の指令をMotionに送るクラス (Core 1から使う)
+ * @details
+ * 指令はキューに積むだけですぐに戻る。終わるまで待つ場合はwait()を呼ぶ。
+ * 同じ向きの直進・スラロームを続けて送ると、間で止まらずにつながる (終端速度は次の指令に合わせて上がる)。
+ */
+class Run {
+ public:
+  explicit Run(Sensor *sensor, Motion *motion);
+  ~Run();
+
+  /**
+   * @brief 直進
+   * @param direction 向き (Forward/Backward)
+   * @param distance 距離 [mm]
+   * @param acceleration 加速度 [m/s^2]
+   * @param max_velocity 最大速度 [m/s]
+   * @param end_velocity 終端速度 [m/s]
+   * @param jerk 躍度 [m/s^3] (0の場合は台形加速)
+   */
+  void straight(MotionDirection direction, float distance, float acceleration, float max_velocity, float end_velocity,
+                float jerk = JERK_DEFAULT);
+
+  /**
+   * @brief 超信地旋回
+   * @param angle 角度 [deg]
+   * @param angular_acceleration 角加速度 [rad/s^2]
+   * @param angular_velocity 最大角速度 [rad/s]
+   * @param direction 向き (Right/Left)
+   * @param angular_jerk 角躍度 [rad/s^3] (0の場合は台形加速)
+   */
+  void turn(float angle, float angular_acceleration, float angular_velocity, MotionDirection direction,
+            float angular_jerk = ANGULAR_JERK_DEFAULT);
+
+  /**
+   * @brief スラローム (前後の直線を含む)
+   * @param type ターンの種類
+   * @param direction 向き (Right/Left)
+   * @param velocity 速度 [m/s] (これ以下で曲がれる最も速いテーブルを使う)
+   * @return 曲がれる速度がない場合、直前の指令がテーブルの速度で終わらない場合はfalse
+   * @details スラロームは速度を変えられないので、直前の直進の終端速度をテーブルの速度に合わせておくこと
+   */
+  bool slalom(slalom::Type type, MotionDirection direction, float velocity);
+
+  /**
+   * @brief planした経路を走る (最後は停止)
+   * @details 区間ごとの速度はRoute::planで決めたものを使う。キューが空くのを待ちながら送る
+   */
+  void follow(const Route &route);
+
+  /**
+   * @brief 前壁合わせ (90度センサで前壁との距離と角度を区画中心に合わせる)
+   * @param timeout 打ち切る時間 [s]
+   * @details 前壁がない場合はすぐに終わる。ターンの後に向きを揃えるのに使う
+   */
+  void align(float timeout = WALL_ALIGN_TIMEOUT);
+
+  // 速度0を保つ
+  void hold();
+
+  // 送った指令がすべて終わるまで待つ
+  void wait();
+
+  // モーターを解放する (解放されるまで待つ)
+  void stop();
+
+ private:
+  // センサ
+  Sensor *sensor_;
+  // モーション
+  Motion *motion_;
+
+  // 送った指令の数
+  uint32_t issued_;
+  // 最後に送った指令の終端速度 [m/s]
+  float velocity_;
+
+  // 指令を送る (キューが満杯の場合は空くまで待つ)
+  void send(const MotionParameter &parameter);
+
+  // テーブルのスラローム (前後の直線を含む)
+  void slalom(const slalom::Table &table, MotionDirection direction);
+};
@@ -7,7 +7,13 @@
 #include <esp_timer.h>
 
 // コンストラクタ
-Sensor::Sensor(Driver *dri) : driver_(dri), odom_(dri) {}
+Sensor::Sensor(Driver *dri)
+    : driver_(dri),
+      odom_(dri),
+      wall_detectors_{WallDetector(WALL_THRESHOLD_EXIST[0], WALL_THRESHOLD_HYSTERESIS[0]),
+                      WallDetector(WALL_THRESHOLD_EXIST[1], WALL_THRESHOLD_HYSTERESIS[1]),
+                      WallDetector(WALL_THRESHOLD_EXIST[2], WALL_THRESHOLD_HYSTERESIS[2]),
+                      WallDetector(WALL_THRESHOLD_EXIST[3], WALL_THRESHOLD_HYSTERESIS[3])} {}
 // コンストラクタ
 Sensor::~Sensor() = default;
 
@@ -16,50 +22,101 @@ void Sensor::setup() {
   for (auto i = 0; i < WARM_UP_COUNTS; i++) {
     update();
   }
-  reset();
+  // 制御ループの開始前なので直接処理する
+  handle({Request::Kind::Reset, {0, 0}, Map::DIRECTION_NORTH, 0.0f});
+  for (auto &detector : wall_detectors_) {
+    detector.reset();
+  }
 }
 
-void Sensor::updateWallSensor(Sensed &sensed) {
-  auto &right90 = driver_->photo->right90();
-  auto &right45 = driver_->photo->right45();
-  auto &left45 = driver_->photo->left45();
-  auto &left90 = driver_->photo->left90();
+void Sensor::updateWall(Sensed::Wall &wall, const Photo::Result &result, int index) {
+  auto &detector = wall_detectors_[index];
+  wall.raw = result.flash - result.ambient;
+  // 中央値フィルタとヒステリシスを通して判定
+  wall.exist = detector.update(wall.raw);
+  wall.confidence = detector.confidence();
+  wall.error = wall.exist ? wall.raw - WALL_REFERENCE_VALUE[index] : 0;
+}
 
+void Sensor::updateWallSensor(Sensed &sensed) {
   // 右90度 (前壁)
-  sensed.wall_right90.raw = right90.flash - right90.ambient;
-  sensed.wall_right90.exist = sensed.wall_right90.raw > WALL_THRESHOLD_EXIST[PARAMETER_WALL_RIGHT90];
-  sensed.wall_right90.error =
-      sensed.wall_right90.exist ? sensed.wall_right90.raw - WALL_REFERENCE_VALUE[PARAMETER_WALL_RIGHT90] : 0;
+  updateWall(sensed.wall_right90, driver_->photo->right90(), PARAMETER_WALL_RIGHT90);
   // 右45度 (右壁)
-  sensed.wall_right45.raw = right45.flash - right45.ambient;
-  sensed.wall_right45.exist = sensed.wall_right45.raw > WALL_THRESHOLD_EXIST[PARAMETER_WALL_RIGHT45];
-  sensed.wall_right45.error =
-      sensed.wall_right45.exist ? sensed.wall_right45.raw - WALL_REFERENCE_VALUE[PARAMETER_WALL_RIGHT45] : 0;
+  updateWall(sensed.wall_right45, driver_->photo->right45(), PARAMETER_WALL_RIGHT45);
   // 左45度 (左壁)
-  sensed.wall_left45.raw = left45.flash - left45.ambient;
-  sensed.wall_left45.exist = sensed.wall_left45.raw > WALL_THRESHOLD_EXIST[PARAMETER_WALL_LEFT45];
-  sensed.wall_left45.error =
-      sensed.wall_left45.exist ? sensed.wall_left45.raw - WALL_REFERENCE_VALUE[PARAMETER_WALL_LEFT45] : 0;
+  updateWall(sensed.wall_left45, driver_->photo->left45(), PARAMETER_WALL_LEFT45);
   // 左90度 (前壁)
-  sensed.wall_left90.raw = left90.flash - left90.ambient;
-  sensed.wall_left90.exist = sensed.wall_left90.raw > WALL_THRESHOLD_EXIST[PARAMETER_WALL_LEFT90];
-  sensed.wall_left90.error =
-      sensed.wall_left90.exist ? sensed.wall_left90.raw - WALL_REFERENCE_VALUE[PARAMETER_WALL_LEFT90] : 0;
+  updateWall(sensed.wall_left90, driver_->photo->left90(), PARAMETER_WALL_LEFT90);
+}
+
+// 要求を送り、処理されるまで待つ
+void Sensor::request(const Request &request) {
+  request_.store(request);
+  auto version = request_.version();
+  while (handled_.load(std::memory_order_acquire) != version) {
+    vTaskDelay(1);
+  }
+}
+
+// 要求を処理する
+void Sensor::handle(const Request &request) {
+  switch (request.kind) {
+    case Request::Kind::Reset:
+      odom_.reset();
+      period_.reset();
+      correction_.rebase(odom_.x(), odom_.y(), odom_.angle());
+      break;
+    case Request::Kind::MazePose:
+      correction_.reset(request.coord, request.direction, request.offset, odom_.x(), odom_.y(), odom_.angle());
+      break;
+  }
+}
+
+// IMUのキャリブレーション
+bool Sensor::calibrate() {
+  auto saved = driver_->imu->calibration();
+  odom_.reset_gyro_bias();
+  odom_.reset();
+  correction_.rebase(odom_.x(), odom_.y(), odom_.angle());
+  // 止めていた間を1周期として積算しない
+  timestamp_ = esp_timer_get_time();
+  return saved;
 }
 
 // 更新
 void Sensor::update() {
+  // Core 1からの要求を処理する
+  if (auto version = request_.version(); version != handled_.load(std::memory_order_relaxed)) [[unlikely]] {
+    handle(request_.load());
+    handled_.store(version, std::memory_order_release);
+  }
+
   // 最新のセンサー値を取得
-  driver_->battery->update();
-  driver_->photo->update();
-  driver_->imu->update();
-  driver_->encoder_right->update();
-  driver_->encoder_left->update();
-  driver_->photo->wait();
+  {
+    profiler::Scope scope(profiler::STAGE_BATTERY);
+    driver_->battery->update();
+  }
+  {
+    profiler::Scope scope(profiler::STAGE_PHOTO);
+    driver_->photo->update();
+  }
+  {
+    profiler::Scope scope(profiler::STAGE_IMU);
+    driver_->imu->update();
+  }
+  {
+    profiler::Scope scope(profiler::STAGE_PHOTO_WAIT);
+    driver_->photo->wait();
+  }
 
   // オドメトリを計算
   auto timestamp = esp_timer_get_time();
-  odom_.update(timestamp - timestamp_);
+  auto delta_us = static_cast<uint32_t>(timestamp - timestamp_);
+  {
+    profiler::Scope scope(profiler::STAGE_ODOMETRY);
+    odom_.update(delta_us);
+  }
+  period_.update(delta_us);
   timestamp_ = timestamp;
 
   // 値を設定
@@ -69,7 +126,27 @@ void Sensor::update() {
   sensed_.length = odom_.length();
   sensed_.x = odom_.x();
   sensed_.y = odom_.y();
+  sensed_.slip = odom_.slip();
   sensed_.battery_voltage = driver_->battery->voltage();
   sensed_.battery_voltage_average = driver_->battery->average();
-  updateWallSensor(sensed_);
+  {
+    profiler::Scope scope(profiler::STAGE_WALL);
+    updateWallSensor(sensed_);
+  }
+
+  // 壁で迷路上の姿勢を補正
+  {
+    profiler::Scope scope(profiler::STAGE_POSE_CORRECTION);
+    PoseCorrection::Observation observation{
+        .left = sensed_.wall_left45.exist,
+        .right = sensed_.wall_right45.exist,
+        .front_left = sensed_.wall_left90.raw,
+        .front_right = sensed_.wall_right90.raw,
+        .front = sensed_.wall_left90.exist && sensed_.wall_right90.exist,
+    };
+    sensed_.maze = correction_.update(odom_.x(), odom_.y(), odom_.angle(), observation);
+  }
+
+  // 公開
+  published_.store(sensed_);
 }
@@ -1,8 +1,17 @@
 #pragma once
 
+// C++
+#include <array>
+#include <atomic>
+
 // Project
 #include "dri/driver.h"
+#include "dri/filter.h"
+#include "dri/histogram.h"
+#include "dri/seqlock.h"
 #include "odometry.h"
+#include "pose_correction.h"
+#include "profiler.h"
 #include "rtos.h"
 
 // 現在の車体情報を保持する構造体
@@ -19,6 +28,10 @@ struct Sensed {
   float x;
   // y座標 [mm]
   float y;
+  // スリップ指標 (1を超えるとスリップ)
+  float slip;
+  // 壁で補正した迷路上の姿勢
+  MazePose maze;
   // バッテリー電圧 [mV]
   int battery_voltage;
   // バッテリー移動平均電圧 [mV]
@@ -28,6 +41,8 @@ struct Sensed {
     int raw;
     int error;
     bool exist;
+    // 壁有無の確信度 [0, 1]
+    float confidence;
   } wall_left90, wall_left45, wall_right45, wall_right90;
 };
 
@@ -38,6 +53,12 @@ class Sensor {
  public:
   // 初回センサー読み捨て回数
   static constexpr uint32_t WARM_UP_COUNTS = 10;
+  // 更新周期の分布のビン数
+  static constexpr std::size_t PERIOD_HISTOGRAM_SIZE = 64;
+  // 更新周期の分布のビン幅 [us]
+  static constexpr uint32_t PERIOD_HISTOGRAM_WIDTH = 50;
+
+  using PeriodHistogram = data::Histogram<uint32_t, PERIOD_HISTOGRAM_SIZE>;
 
   explicit Sensor(Driver *dri);
   ~Sensor();
@@ -48,11 +69,26 @@ class Sensor {
   // 更新
   void update();
 
-  // センサ値を取得
-  const Sensed &getSensed() { return sensed_; }
+  // センサ値を取得 (別のコアからも一貫した値を読める)
+  Sensed getSensed() const { return published_.load(); }
+
+  // 更新周期の分布を取得
+  const PeriodHistogram &getPeriodHistogram() { return period_; }
+
+  // リセット (Core 1から呼ぶ、次の更新の最初に処理されるまで待つ)
+  void reset() { request({Request::Kind::Reset, {0, 0}, Map::DIRECTION_NORTH, 0.0f}); }
+
+  // 迷路上の姿勢を設定 (区画、方位、区画中心からの前後方向の位置 [mm]、resetと同じく処理されるまで待つ)
+  void setMazePose(Map::Coord coord, Map::Direction direction, float offset = 0.0f) {
+    request({Request::Kind::MazePose, coord, direction, offset});
+  }
 
-  // リセット
-  void reset() { odom_.reset(); }
+  /**
+   * @brief IMUをキャリブレーションしてNVSに保存する (静止している前提)
+   * @details 数秒かかるので、制御ループを止めてから呼ぶ (update()と同時に呼ばない)
+   * @return 保存できた場合はtrue
+   */
+  bool calibrate();
 
  private:
   // ドライバ
@@ -61,12 +97,41 @@ class Sensor {
   // 内部計算値
   Odometry odom_;
 
+  // 壁による姿勢補正
+  PoseCorrection correction_;
+
+  // Core 1からの要求 (更新中に姿勢を書き換えないよう、更新の最初に処理する)
+  struct Request {
+    enum class Kind : uint8_t { Reset, MazePose } kind;
+    Map::Coord coord;
+    Map::Direction direction;
+    float offset;
+  };
+  data::SeqLock<Request> request_;
+  // 処理した要求の版
+  std::atomic<uint32_t> handled_{request_.version()};
+
   // 最新のセンサー値
   Sensed sensed_{};
+  // 公開中のセンサー値
+  data::SeqLock<Sensed> published_;
 
   // タイムスタンプ
   int64_t timestamp_{};
 
+  // 更新周期の分布 [us]
+  PeriodHistogram period_{0, PERIOD_HISTOGRAM_WIDTH};
+
+  // 壁有無判定器
+  using WallDetector = data::ThresholdDetector<int, WALL_FILTER_SIZE, WALL_HISTORY_SIZE>;
+  std::array<WallDetector, NUM_PARAMETER_WALL> wall_detectors_;
+
+  // 要求を送り、処理されるまで待つ
+  void request(const Request &request);
+  // 要求を処理する
+  void handle(const Request &request);
+
   // 壁ADC値を更新
   void updateWallSensor(Sensed &sensed);
+  void updateWall(Sensed::Wall &wall, const Photo::Result &result, int index);
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+// C++
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+// Project
+#include "parameters.h"
+
+namespace slalom {
+/**
+ * @brief スラロームの軌跡
+ * @details
+ * 一定の速度で進みながら、制御周期ごとの角速度を先頭から順に出す。角速度は右ターンで正の値なので、
+ * 左右は呼び出し側で符号を付ける。ターンの前後に直線がある場合はbefore/afterに入っている。
+ */
+struct Table {
+  // 速度 [m/s]
+  float velocity;
+  // ターン前の直線 [mm]
+  float before;
+  // ターン後の直線 [mm]
+  float after;
+  // 角度 [rad]
+  float angle;
+  // 角速度の数 (制御周期の数)
+  std::size_t size;
+  // 制御周期ごとの角速度 [rad/s] (この速度では曲がれない場合はnullptr)
+  const float *angular_velocity;
+};
+}  // namespace slalom
+
+// tools/slalomで生成したテーブル
+#include "slalom_table.h"
+
+namespace slalom {
+static_assert(GENERATED_FREQUENCY == CONTROL_FREQUENCY, "regenerate slalom_table.h with tools/slalom");
+
+/**
+ * @brief 指定した速度以下で最も速いテーブルを探す
+ * @return 曲がれる速度がない場合はnullptr
+ */
+inline const Table *find(Type type, float velocity) {
+  const Table *found = nullptr;
+  for (const auto &table : TABLES[type]) {
+    if (table.angular_velocity != nullptr && table.velocity <= velocity + 1e-3f) {
+      found = &table;
+    }
+  }
+  return found;
+}
+}  // namespace slalom
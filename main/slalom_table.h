@@ -0,0 +1,709 @@
+#pragma once
+
+// tools/slalomで生成 (手で編集しないこと)
+// 制御周波数 1000 Hz, トレッド 33 mm, 遠心加速度 6 m/s^2, 接線加速度 5 m/s^2
+
+namespace slalom {
+// 生成した時の制御周波数 [Hz]
+inline constexpr uint32_t GENERATED_FREQUENCY = 1000;
+
+// ターンの種類
+enum Type : uint8_t {
+  TURN_90,
+  TURN_LARGE_90,
+  TURN_180,
+  TURN_45_IN,
+  TURN_45_OUT,
+  TURN_135_IN,
+  TURN_135_OUT,
+  TURN_V90,
+  NUM_TYPES,
+};
+
+// 速度の数
+inline constexpr std::size_t NUM_VELOCITIES = 4;
+
+// 半径 41.4 mm, クロソイド 7.2 mm, 円弧 57.8 mm, 遠心加速度 2.18 m/s^2
+inline constexpr float TURN_90_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.81818182f, 7.12061263f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f, 7.25366616f,
+    7.22326417f, 6.96641064f, 6.66338034f, 6.36035004f, 6.05731973f, 5.75428943f, 5.45125913f, 5.14822883f,
+    4.84519852f, 4.54216822f, 4.23913792f, 3.93610761f, 3.63307731f, 3.33004701f, 3.0270167f, 2.7239864f,
+    2.4209561f, 2.11792579f, 1.81489549f, 1.51186519f, 1.20883489f, 0.905804583f, 0.60277428f, 0.299743977f,
+    0.0362534447f,
+};
+
+// 半径 88.3 mm, クロソイド 3.4 mm, 円弧 135.4 mm, 遠心加速度 1.02 m/s^2
+inline constexpr float TURN_LARGE_90_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.39031342f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f,
+    3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.39700203f, 3.34365879f, 3.06568355f,
+    2.76265325f, 2.45962294f, 2.15659264f, 1.85356234f, 1.55053204f, 1.24750173f, 0.94447143f, 0.641441127f,
+    0.338410824f, 0.0576344872f,
+};
+
+// 半径 85.1 mm, クロソイド 9.7 mm, 円弧 124.0 mm, 遠心加速度 2.94 m/s^2
+inline constexpr float TURN_LARGE_90_500[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.85219219f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f, 5.87490719f,
+    5.87490719f, 5.87490719f, 5.87490719f, 5.81549624f, 5.53363789f, 5.23060759f, 4.92757728f, 4.62454698f,
+    4.32151668f, 4.01848637f, 3.71545607f, 3.41242577f, 3.10939546f, 2.80636516f, 2.50333486f, 2.20030456f,
+    1.89727425f, 1.59424395f, 1.29121365f, 0.988183344f, 0.685153041f, 0.382122738f, 0.087746767f,
+};
+
+// 半径 45.0 mm, クロソイド 6.6 mm, 円弧 134.6 mm, 遠心加速度 2.00 m/s^2
+inline constexpr float TURN_180_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.67260329f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f,
+    6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.67266261f, 6.66750223f, 6.4652234f,
+    6.1621931f, 5.85916279f, 5.55613249f, 5.25310219f, 4.95007188f, 4.64704158f, 4.34401128f, 4.04098098f,
+    3.73795067f, 3.43492037f, 3.13189007f, 2.82885976f, 2.52582946f, 2.22279916f, 1.91976885f, 1.61673855f,
+    1.31370825f, 1.01067795f, 0.707647642f, 0.404617339f, 0.105700184f,
+};
+
+// 半径 44.7 mm, クロソイド 18.5 mm, 円弧 121.9 mm, 遠心加速度 5.60 m/s^2
+inline constexpr float TURN_180_500[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.81818182f, 7.12121212f,
+    7.42424242f, 7.72727273f, 8.03030303f, 8.33333333f, 8.63636364f, 8.93939394f, 9.24242424f, 9.54545455f,
+    9.84848485f, 10.1515152f, 10.4545455f, 10.7575758f, 11.0598016f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f, 11.1900405f,
+    11.1804947f, 10.962464f, 10.6594337f, 10.3564034f, 10.0533731f, 9.75034278f, 9.44731248f, 9.14428217f,
+    8.84125187f, 8.53822157f, 8.23519127f, 7.93216096f, 7.62913066f, 7.32610036f, 7.02307005f, 6.72003975f,
+    6.41700945f, 6.11397914f, 5.81094884f, 5.50791854f, 5.20488823f, 4.90185793f, 4.59882763f, 4.29579733f,
+    3.99276702f, 3.68973672f, 3.38670642f, 3.08367611f, 2.78064581f, 2.47761551f, 2.1745852f, 1.8715549f,
+    1.5685246f, 1.2654943f, 0.962463992f, 0.659433689f, 0.356403386f, 0.0692656614f,
+};
+
+// 半径 151.3 mm, クロソイド 2.0 mm, 円弧 116.8 mm, 遠心加速度 0.59 m/s^2
+inline constexpr float TURN_45_IN_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.93828173f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.83772846f, 1.53475908f, 1.23172878f, 0.928698473f,
+    0.62566817f, 0.322637867f, 0.048316923f,
+};
+
+// 半径 146.8 mm, クロソイド 5.6 mm, 円弧 109.7 mm, 遠心加速度 1.70 m/s^2
+inline constexpr float TURN_45_IN_500[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.39641342f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.3883721f, 3.153395f,
+    2.85036469f, 2.54733439f, 2.24430409f, 1.94127378f, 1.63824348f, 1.33521318f, 1.03218287f, 0.729152571f,
+    0.426122268f, 0.124424963f,
+};
+
+// 半径 139.6 mm, クロソイド 11.6 mm, 円弧 98.1 mm, 遠心加速度 3.51 m/s^2
+inline constexpr float TURN_45_IN_700[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    4.9686133f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 4.99542611f, 4.75714628f, 4.45411597f, 4.15108567f,
+    3.84805537f, 3.54502506f, 3.24199476f, 2.93896446f, 2.63593415f, 2.33290385f, 2.02987355f, 1.72684325f,
+    1.42381294f, 1.12078264f, 0.817752336f, 0.514722033f, 0.21169173f, 0.00597501402f,
+};
+
+// 半径 151.3 mm, クロソイド 2.0 mm, 円弧 116.8 mm, 遠心加速度 0.59 m/s^2
+inline constexpr float TURN_45_OUT_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.93828173f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f,
+    1.98322827f, 1.98322827f, 1.98322827f, 1.98322827f, 1.83772846f, 1.53475908f, 1.23172878f, 0.928698473f,
+    0.62566817f, 0.322637867f, 0.048316923f,
+};
+
+// 半径 146.8 mm, クロソイド 5.6 mm, 円弧 109.7 mm, 遠心加速度 1.70 m/s^2
+inline constexpr float TURN_45_OUT_500[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.39641342f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f,
+    3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.40485336f, 3.3883721f, 3.153395f,
+    2.85036469f, 2.54733439f, 2.24430409f, 1.94127378f, 1.63824348f, 1.33521318f, 1.03218287f, 0.729152571f,
+    0.426122268f, 0.124424963f,
+};
+
+// 半径 139.6 mm, クロソイド 11.6 mm, 円弧 98.1 mm, 遠心加速度 3.51 m/s^2
+inline constexpr float TURN_45_OUT_700[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    4.9686133f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f, 5.013594f,
+    5.013594f, 5.013594f, 5.013594f, 5.013594f, 4.99542611f, 4.75714628f, 4.45411597f, 4.15108567f,
+    3.84805537f, 3.54502506f, 3.24199476f, 2.93896446f, 2.63593415f, 2.33290385f, 2.02987355f, 1.72684325f,
+    1.42381294f, 1.12078264f, 0.817752336f, 0.514722033f, 0.21169173f, 0.00597501402f,
+};
+
+// 半径 23.5 mm, クロソイド 12.7 mm, 円弧 42.6 mm, 遠心加速度 3.84 m/s^2
+inline constexpr float TURN_135_IN_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.81818182f, 7.12121212f,
+    7.42424242f, 7.72727273f, 8.03030303f, 8.33333333f, 8.63636364f, 8.93939394f, 9.24242424f, 9.54545455f,
+    9.84848485f, 10.1515152f, 10.4545455f, 10.7575758f, 11.0606061f, 11.3636364f, 11.6666667f, 11.969697f,
+    12.2727273f, 12.5757576f, 12.7812421f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.704758f, 12.412171f, 12.1091407f, 11.8061103f, 11.50308f, 11.2000497f, 10.8970194f, 10.5939891f,
+    10.2909588f, 9.98792853f, 9.68489823f, 9.38186792f, 9.07883762f, 8.77580732f, 8.47277702f, 8.16974671f,
+    7.86671641f, 7.56368611f, 7.2606558f, 6.9576255f, 6.6545952f, 6.35156489f, 6.04853459f, 5.74550429f,
+    5.44247399f, 5.13944368f, 4.83641338f, 4.53338308f, 4.23035277f, 3.92732247f, 3.62429217f, 3.32126186f,
+    3.01823156f, 2.71520126f, 2.41217096f, 2.10914065f, 1.80611035f, 1.50308005f, 1.20004974f, 0.89701944f,
+    0.593989137f, 0.290958834f, 0.032083492f,
+};
+
+// 半径 23.5 mm, クロソイド 12.7 mm, 円弧 42.6 mm, 遠心加速度 3.84 m/s^2
+inline constexpr float TURN_135_OUT_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.81818182f, 7.12121212f,
+    7.42424242f, 7.72727273f, 8.03030303f, 8.33333333f, 8.63636364f, 8.93939394f, 9.24242424f, 9.54545455f,
+    9.84848485f, 10.1515152f, 10.4545455f, 10.7575758f, 11.0606061f, 11.3636364f, 11.6666667f, 11.969697f,
+    12.2727273f, 12.5757576f, 12.7812421f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f, 12.7871597f,
+    12.704758f, 12.412171f, 12.1091407f, 11.8061103f, 11.50308f, 11.2000497f, 10.8970194f, 10.5939891f,
+    10.2909588f, 9.98792853f, 9.68489823f, 9.38186792f, 9.07883762f, 8.77580732f, 8.47277702f, 8.16974671f,
+    7.86671641f, 7.56368611f, 7.2606558f, 6.9576255f, 6.6545952f, 6.35156489f, 6.04853459f, 5.74550429f,
+    5.44247399f, 5.13944368f, 4.83641338f, 4.53338308f, 4.23035277f, 3.92732247f, 3.62429217f, 3.32126186f,
+    3.01823156f, 2.71520126f, 2.41217096f, 2.10914065f, 1.80611035f, 1.50308005f, 1.20004974f, 0.89701944f,
+    0.593989137f, 0.290958834f, 0.032083492f,
+};
+
+// 半径 61.2 mm, クロソイド 4.9 mm, 円弧 91.3 mm, 遠心加速度 1.47 m/s^2
+inline constexpr float TURN_V90_300[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    4.89743258f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f, 4.90219193f,
+    4.8525044f, 4.57714391f, 4.27411361f, 3.97108331f, 3.668053f, 3.3650227f, 3.0619924f, 2.7589621f,
+    2.45593179f, 2.15290149f, 1.84987119f, 1.54684088f, 1.24381058f, 0.940780278f, 0.637749974f, 0.334719671f,
+    0.0553804286f,
+};
+
+// 半径 56.1 mm, クロソイド 14.7 mm, 円弧 73.5 mm, 遠心加速度 4.45 m/s^2
+inline constexpr float TURN_V90_500[] = {
+    0.151515152f, 0.454545455f, 0.757575758f, 1.06060606f, 1.36363636f, 1.66666667f, 1.96969697f, 2.27272727f,
+    2.57575758f, 2.87878788f, 3.18181818f, 3.48484848f, 3.78787879f, 4.09090909f, 4.39393939f, 4.6969697f,
+    5.0f, 5.3030303f, 5.60606061f, 5.90909091f, 6.21212121f, 6.51515152f, 6.81818182f, 7.12121212f,
+    7.42424242f, 7.72727273f, 8.03030303f, 8.33333333f, 8.63636364f, 8.88362169f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f, 8.90705762f,
+    8.84385182f, 8.55982189f, 8.25679159f, 7.95376129f, 7.65073098f, 7.34770068f, 7.04467038f, 6.74164007f,
+    6.43860977f, 6.13557947f, 5.83254917f, 5.52951886f, 5.22648856f, 4.92345826f, 4.62042795f, 4.31739765f,
+    4.01436735f, 3.71133704f, 3.40830674f, 3.10527644f, 2.80224614f, 2.49921583f, 2.19618553f, 1.89315523f,
+    1.59012492f, 1.28709462f, 0.984064317f, 0.681034014f, 0.378003711f, 0.0846401617f,
+};
+
+// ターンの種類と速度ごとのテーブル
+inline constexpr Table TABLES[NUM_TYPES][NUM_VELOCITIES] = {
+    // TURN_90
+    {
+        {0.3f, 0.0f, 0.0f, 1.57079633f, std::size(TURN_90_300), TURN_90_300},
+        {0.5f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+        {0.7f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+    },
+    // TURN_LARGE_90
+    {
+        {0.3f, 0.0f, 0.0f, 1.57079633f, std::size(TURN_LARGE_90_300), TURN_LARGE_90_300},
+        {0.5f, 0.0f, 0.0f, 1.57079633f, std::size(TURN_LARGE_90_500), TURN_LARGE_90_500},
+        {0.7f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+    },
+    // TURN_180
+    {
+        {0.3f, 0.0f, 0.0f, 3.14159265f, std::size(TURN_180_300), TURN_180_300},
+        {0.5f, 0.0f, 0.0f, 3.14159265f, std::size(TURN_180_500), TURN_180_500},
+        {0.7f, 0.0f, 0.0f, 3.14159265f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 3.14159265f, 0, nullptr},
+    },
+    // TURN_45_IN
+    {
+        {0.3f, 26.3603897f, 0.0f, 0.785398163f, std::size(TURN_45_IN_300), TURN_45_IN_300},
+        {0.5f, 26.3603897f, 0.0f, 0.785398163f, std::size(TURN_45_IN_500), TURN_45_IN_500},
+        {0.7f, 26.3603897f, 0.0f, 0.785398163f, std::size(TURN_45_IN_700), TURN_45_IN_700},
+        {1.0f, 0.0f, 0.0f, 0.785398163f, 0, nullptr},
+    },
+    // TURN_45_OUT
+    {
+        {0.3f, 0.0f, 26.2298012f, 0.785398163f, std::size(TURN_45_OUT_300), TURN_45_OUT_300},
+        {0.5f, 0.0f, 26.3134914f, 0.785398163f, std::size(TURN_45_OUT_500), TURN_45_OUT_500},
+        {0.7f, 0.0f, 25.7993976f, 0.785398163f, std::size(TURN_45_OUT_700), TURN_45_OUT_700},
+        {1.0f, 0.0f, 0.0f, 0.785398163f, 0, nullptr},
+    },
+    // TURN_135_IN
+    {
+        {0.3f, 26.3603897f, 0.0f, 2.35619449f, std::size(TURN_135_IN_300), TURN_135_IN_300},
+        {0.5f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+        {0.7f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+    },
+    // TURN_135_OUT
+    {
+        {0.3f, 0.0f, 26.1984389f, 2.35619449f, std::size(TURN_135_OUT_300), TURN_135_OUT_300},
+        {0.5f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+        {0.7f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 2.35619449f, 0, nullptr},
+    },
+    // TURN_V90
+    {
+        {0.3f, 0.0f, 0.0f, 1.57079633f, std::size(TURN_V90_300), TURN_V90_300},
+        {0.5f, 0.0f, 0.0f, 1.57079633f, std::size(TURN_V90_500), TURN_V90_500},
+        {0.7f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+        {1.0f, 0.0f, 0.0f, 1.57079633f, 0, nullptr},
+    },
+};
+}  // namespace slalom
@@ -0,0 +1,209 @@
+#pragma once
+
+// C++
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+
+/**
+ * システム同定用の入力信号と記録
+ * @details
+ * 制御周期ごとにモーター電圧を直接与え、速度・角速度の応答をRAMに記録する。
+ * 記録はコンソールから取り出し、tools/sysidで伝達関数を当てはめてゲインを求める。
+ */
+namespace sysid {
+// 入力信号
+enum class Signal : uint8_t {
+  // ステップ (前半だけ電圧をかけ、後半は0に戻す)
+  Step,
+  // M系列 (疑似ランダムな±振幅)
+  Prbs,
+  // 周波数を線形に上げる正弦波
+  Chirp,
+};
+
+// 動かす軸
+enum class Axis : uint8_t {
+  // 並進 (左右に同じ電圧)
+  Translation,
+  // 旋回 (左右に逆の電圧、左回りが正)
+  Rotation,
+};
+
+// 入力信号の設定
+struct Config {
+  // 入力信号
+  Signal signal;
+  // 動かす軸
+  Axis axis;
+  // 振幅 [V]
+  float amplitude;
+  // 長さ [周期]
+  uint32_t ticks;
+  // M系列の1ビットの長さ [周期]
+  uint32_t bit_ticks;
+  // チャープの開始・終了周波数 [Hz]
+  float frequency_min, frequency_max;
+};
+
+// 左右のモーター電圧 [V]
+struct Voltage {
+  float right;
+  float left;
+};
+
+// 記録する値
+struct Sample {
+  // 与えた電圧 [V]
+  float right, left;
+  // 速度 [m/s]
+  float velocity;
+  // 角速度 [rad/s]
+  float angular_velocity;
+};
+
+static_assert(sizeof(Sample) == 16);
+
+/**
+ * @brief 入力信号を制御周期ごとに出す
+ */
+class Excitation {
+ public:
+  // M系列のシフトレジスタの初期値 (9ビット)
+  static constexpr uint16_t PRBS_SEED = 0x1FF;
+
+  explicit Excitation() : config_(), dt_(0.0f), tick_(0), register_(PRBS_SEED), level_(0.0f) {}
+  ~Excitation() = default;
+
+  /**
+   * @brief 信号を最初から出す
+   * @param dt 制御周期 [s]
+   */
+  void start(const Config &config, float dt) {
+    config_ = config;
+    dt_ = dt;
+    tick_ = 0;
+    register_ = PRBS_SEED;
+    level_ = config_.amplitude;
+  }
+
+  // 1周期分の電圧 (終わった後は0)
+  Voltage update() {
+    if (finished()) return {0.0f, 0.0f};
+    auto value = sample();
+    tick_++;
+    if (config_.axis == Axis::Translation) return {value, value};
+    return {value, -value};
+  }
+
+  [[nodiscard]] bool finished() const { return tick_ >= config_.ticks; }
+  [[nodiscard]] const Config &config() const { return config_; }
+
+ private:
+  //! 設定
+  Config config_;
+  //! 制御周期 [s]
+  float dt_;
+  //! 経過周期
+  uint32_t tick_;
+  //! M系列のシフトレジスタ
+  uint16_t register_;
+  //! M系列の現在の出力
+  float level_;
+
+  float sample() {
+    switch (config_.signal) {
+      case Signal::Step:
+        return tick_ < config_.ticks / 2 ? config_.amplitude : 0.0f;
+      case Signal::Prbs:
+        // x^9 + x^5 + 1 (周期511ビット)
+        if (tick_ % config_.bit_ticks == 0) {
+          auto bit = ((register_ >> 8) ^ (register_ >> 4)) & 0x01;
+          register_ = static_cast<uint16_t>(((register_ << 1) | bit) & 0x1FF);
+          level_ = bit != 0 ? config_.amplitude : -config_.amplitude;
+        }
+        return level_;
+      case Signal::Chirp: {
+        auto t = static_cast<float>(tick_) * dt_;
+        auto duration = static_cast<float>(config_.ticks) * dt_;
+        auto rate = (config_.frequency_max - config_.frequency_min) / duration;
+        auto phase = 2.0f * std::numbers::pi_v<float> * (config_.frequency_min + rate * t / 2.0f) * t;
+        return config_.amplitude * std::sin(phase);
+      }
+    }
+    return 0.0f;
+  }
+};
+
+/**
+ * @brief 記録用の固定長バッファ
+ * @tparam N 記録できる周期の数
+ * @tparam R 記録できる信号の数
+ */
+template <std::size_t N, std::size_t R>
+class Log {
+ public:
+  // 1つの信号の記録
+  struct Run {
+    // 入力信号
+    Config config;
+    // 先頭の位置と周期の数
+    std::size_t begin, size;
+  };
+
+  explicit Log() : samples_(), runs_(), size_(0), count_(0) {}
+  ~Log() = default;
+
+  void clear() {
+    size_ = 0;
+    count_ = 0;
+  }
+
+  // 信号の記録を始める (入り切らない場合はfalse)
+  bool begin(const Config &config) {
+    if (count_ >= R || size_ + config.ticks > N) return false;
+    runs_[count_++] = {config, size_, 0};
+    return true;
+  }
+
+  // 1周期分を記録する (満杯の場合はfalse)
+  bool push(const Sample &sample) {
+    if (count_ == 0 || size_ >= N) return false;
+    samples_[size_++] = sample;
+    runs_[count_ - 1].size++;
+    return true;
+  }
+
+  [[nodiscard]] std::size_t runs() const { return count_; }
+  [[nodiscard]] const Run &run(std::size_t index) const { return runs_[index]; }
+  [[nodiscard]] const Sample &sample(std::size_t index) const { return samples_[index]; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  static constexpr std::size_t capacity() { return N; }
+
+ private:
+  //! 記録
+  std::array<Sample, N> samples_;
+  //! 信号ごとの範囲
+  std::array<Run, R> runs_;
+  //! 記録した周期の数
+  std::size_t size_;
+  //! 記録した信号の数
+  std::size_t count_;
+};
+
+// 名前 (ダンプ用)
+inline const char *name(Signal signal) {
+  switch (signal) {
+    case Signal::Step:
+      return "step";
+    case Signal::Prbs:
+      return "prbs";
+    case Signal::Chirp:
+      return "chirp";
+  }
+  return "?";
+}
+inline const char *name(Axis axis) { return axis == Axis::Translation ? "translation" : "rotation"; }
+}  // namespace sysid
@@ -0,0 +1,216 @@
+#pragma once
+
+// C++
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Project
+#include "dri/cobs.h"
+#include "dri/spsc_queue.h"
+#include "profiler.h"
+
+/**
+ * @brief テレメトリの1周期分のフレーム
+ * @details
+ * リトルエンディアンの固定レイアウトで送る。レイアウトを変えた場合はVERSIONを上げること。
+ * 送信時は末尾にCRC-16を付けてCOBSで符号化し、0x00で区切る。
+ */
+struct TelemetryFrame {
+  static constexpr uint16_t VERSION = 2;
+
+  // フラグ
+  enum Flag : uint16_t {
+    FLAG_WALL_RIGHT90 = 1 << 0,
+    FLAG_WALL_RIGHT45 = 1 << 1,
+    FLAG_WALL_LEFT45 = 1 << 2,
+    FLAG_WALL_LEFT90 = 1 << 3,
+  };
+
+  // フォーマットのバージョン
+  uint16_t version;
+  // フラグ
+  uint16_t flags;
+  // 通し番号
+  uint32_t sequence;
+  // 時刻 [us]
+  uint32_t timestamp;
+  // 車体速度 [m/s]
+  float velocity;
+  // 車体角速度 [rad/s]
+  float angular_velocity;
+  // 車体角度 [deg]
+  float angle;
+  // 移動距離 [mm]
+  float length;
+  // x座標 [mm]
+  float x;
+  // y座標 [mm]
+  float y;
+  // スリップ指標
+  float slip;
+  // 目標速度 [m/s]
+  float target_velocity;
+  // 目標角速度 [rad/s]
+  float target_angular_velocity;
+  // 壁センサの値 (右90, 右45, 左45, 左90)
+  int16_t wall[4];
+  // バッテリー電圧 [mV]
+  int16_t battery_voltage;
+  // モーター電圧 [mV]
+  int16_t motor_voltage_right;
+  int16_t motor_voltage_left;
+  // 予約
+  int16_t reserved;
+  // 計測区間ごとの直近の所要時間 [0.1 us] (profiler::Stageの順、計測を無効にしたビルドでは0)
+  uint16_t profile[profiler::NUM_STAGE];
+};
+static_assert(sizeof(TelemetryFrame) == 80, "TelemetryFrame layout changed");
+
+namespace telemetry {
+// CRCを含むフレームの長さ
+inline constexpr std::size_t PAYLOAD_SIZE = sizeof(TelemetryFrame) + sizeof(uint16_t);
+// 符号化後の最大長 (区切りの0x00を含む)
+inline constexpr std::size_t MAX_ENCODED_SIZE = data::cobs_max_encoded_size(PAYLOAD_SIZE) + 1;
+
+/**
+ * @brief フレームを符号化する
+ * @param frame フレーム
+ * @param dst 出力先 (MAX_ENCODED_SIZE以上)
+ * @return 符号化後の長さ (区切りの0x00を含む)
+ */
+inline std::size_t encode(const TelemetryFrame &frame, uint8_t *dst) {
+  uint8_t payload[PAYLOAD_SIZE];
+  std::memcpy(payload, &frame, sizeof(TelemetryFrame));
+  auto crc = data::crc16(payload, sizeof(TelemetryFrame));
+  payload[sizeof(TelemetryFrame)] = static_cast<uint8_t>(crc & 0xFF);
+  payload[sizeof(TelemetryFrame) + 1] = static_cast<uint8_t>(crc >> 8);
+  auto size = data::cobs_encode(payload, PAYLOAD_SIZE, dst);
+  dst[size++] = 0;
+  return size;
+}
+
+/**
+ * @brief 受信したバイト列からフレームを取り出す
+ */
+class Decoder {
+ public:
+  explicit Decoder() : frames_(0), crc_errors_(0), lost_(0), sequence_(0) {}
+  ~Decoder() = default;
+
+  /**
+   * @brief 1バイト受け取る
+   * @return フレームを取り出せた場合はtrue
+   */
+  bool update(uint8_t byte, TelemetryFrame &frame) {
+    auto size = reader_.update(byte);
+    if (size == 0) return false;
+    // 長さ・CRC・バージョンが合わないものは捨てる
+    if (size != PAYLOAD_SIZE) {
+      crc_errors_++;
+      return false;
+    }
+    auto payload = reader_.data();
+    auto crc = static_cast<uint16_t>(payload[sizeof(TelemetryFrame)] | (payload[sizeof(TelemetryFrame) + 1] << 8));
+    if (crc != data::crc16(payload, sizeof(TelemetryFrame))) {
+      crc_errors_++;
+      return false;
+    }
+    std::memcpy(&frame, payload, sizeof(TelemetryFrame));
+    if (frame.version != TelemetryFrame::VERSION) {
+      crc_errors_++;
+      return false;
+    }
+    // 通し番号の飛びから取りこぼしを数える
+    if (frames_ > 0 && frame.sequence != sequence_ + 1) {
+      lost_ += frame.sequence - sequence_ - 1;
+    }
+    sequence_ = frame.sequence;
+    frames_++;
+    return true;
+  }
+
+  // 取り出したフレームの数
+  [[nodiscard]] uint32_t frames() const { return frames_; }
+  // 壊れていたフレームの数
+  [[nodiscard]] uint32_t errors() const { return crc_errors_ + reader_.errors(); }
+  // 通し番号から推定した取りこぼしの数
+  [[nodiscard]] uint32_t lost() const { return lost_; }
+
+ private:
+  data::CobsReader<PAYLOAD_SIZE> reader_;
+  uint32_t frames_;
+  uint32_t crc_errors_;
+  uint32_t lost_;
+  uint32_t sequence_;
+};
+
+/**
+ * @brief 制御ループ (Core 0) から送信タスク (Core 1) へフレームを渡す
+ * @details 有効な間だけ制御ループでフレームを作り、満杯の場合は捨てて数える
+ */
+class Channel {
+ public:
+  // 溜めておけるフレームの数
+  static constexpr std::size_t QUEUE_SIZE = 128;
+
+  explicit Channel() : enabled_(false), sequence_(0), dropped_(0) {}
+  ~Channel() = default;
+
+  void enable() { enabled_.store(true, std::memory_order_release); }
+  void disable() { enabled_.store(false, std::memory_order_release); }
+  [[nodiscard]] bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+  // フレームを送る (制御ループから呼ぶ)。通し番号はここで付ける
+  void publish(TelemetryFrame &frame) {
+    frame.version = TelemetryFrame::VERSION;
+    frame.sequence = sequence_++;
+    if (!queue_.send(&frame)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // フレームを受け取る (送信タスクから呼ぶ)
+  bool receive(TelemetryFrame &frame) { return queue_.receive(&frame); }
+
+  // 満杯で捨てたフレームの数
+  [[nodiscard]] uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<bool> enabled_;
+  uint32_t sequence_;
+  std::atomic<uint32_t> dropped_;
+  data::SpscQueue<TelemetryFrame, QUEUE_SIZE> queue_;
+};
+
+// CSVのヘッダーを出力
+inline void print_csv_header(FILE *file) {
+  fprintf(file,
+          "sequence,timestamp,velo,ang_velo,ang,len,x,y,slip,tvelo,tang_velo,r90,r45,l45,l90,"
+          "r90_exist,r45_exist,l45_exist,l90_exist,vbatt,vmotor_r,vmotor_l");
+  for (const auto name : profiler::STAGE_NAMES) {
+    fprintf(file, ",prof_%s", name);
+  }
+  fprintf(file, "\n");
+}
+
+// CSVの1行を出力
+inline void print_csv(FILE *file, const TelemetryFrame &frame) {
+  fprintf(file, "%u,%u,%g,%g,%g,%g,%g,%g,%g,%g,%g,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+          static_cast<unsigned>(frame.sequence), static_cast<unsigned>(frame.timestamp),
+          static_cast<double>(frame.velocity), static_cast<double>(frame.angular_velocity),
+          static_cast<double>(frame.angle), static_cast<double>(frame.length), static_cast<double>(frame.x),
+          static_cast<double>(frame.y), static_cast<double>(frame.slip), static_cast<double>(frame.target_velocity),
+          static_cast<double>(frame.target_angular_velocity), frame.wall[0], frame.wall[1], frame.wall[2],
+          frame.wall[3], (frame.flags & TelemetryFrame::FLAG_WALL_RIGHT90) != 0,
+          (frame.flags & TelemetryFrame::FLAG_WALL_RIGHT45) != 0, (frame.flags & TelemetryFrame::FLAG_WALL_LEFT45) != 0,
+          (frame.flags & TelemetryFrame::FLAG_WALL_LEFT90) != 0, frame.battery_voltage, frame.motor_voltage_right,
+          frame.motor_voltage_left);
+  for (const auto time : frame.profile) {
+    fprintf(file, ",%.1f", static_cast<double>(time) / 10.0);
+  }
+  fprintf(file, "\n");
+}
+}  // namespace telemetry
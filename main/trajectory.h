@@ -0,0 +1,245 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief 躍度 (jerk) を制限した速度プロファイル (S字加減速)
+ * @details
+ * 加速・等速・減速を7区間 (躍度+, 等加速, 躍度-, 等速, 躍度-, 等減速, 躍度+) に分け、
+ * 開始時に各区間の開始時刻と位置・速度・加速度を表にしておく。各周期では区間を探して3次式を計算するだけ。
+ * 躍度に0を指定すると躍度の区間がなくなり、台形加速になる。
+ * 距離が足りない場合は最高速度を下げ、終端速度に届かない場合は加速 (減速) しきった速度で終わる。
+ * 距離・速度は正の値で扱い、向きは呼び出し側で付ける。
+ */
+class Trajectory {
+ public:
+  // 目標値
+  struct State {
+    // 位置
+    float position;
+    // 速度
+    float velocity;
+    // 加速度
+    float acceleration;
+  };
+
+  // 区間の数
+  static constexpr std::size_t NUM_SEGMENTS = 7;
+
+  explicit Trajectory() { reset(0.0f, 0.0f, 0.0f, 0.0f, 1.0f); }
+  ~Trajectory() = default;
+
+  /**
+   * @brief プロファイルを計算する
+   * @param distance 距離 (0以上)
+   * @param start_velocity 開始速度 (0以上)
+   * @param max_velocity 最大速度 (0より大きい)
+   * @param end_velocity 終端速度 (0以上、最大速度を超える場合は最大速度)
+   * @param acceleration 加速度 (0より大きい)
+   * @param jerk 躍度 (0の場合は制限しない)
+   */
+  void reset(float distance, float start_velocity, float max_velocity, float end_velocity, float acceleration,
+             float jerk = 0.0f) {
+    distance_ = std::max(distance, 0.0f);
+    acceleration_ = acceleration;
+    jerk_ = jerk;
+    max_velocity = std::max(max_velocity, start_velocity);
+    end_velocity = std::min(end_velocity, max_velocity);
+
+    auto lower = std::max(start_velocity, end_velocity);
+    if (ramp_distance(start_velocity, lower) + ramp_distance(end_velocity, lower) > distance_) {
+      // 終端速度まで加速 (減速) しきれない: 全区間で加速 (減速) する
+      end_velocity = solve(end_velocity, start_velocity, [&](float v) { return ramp_distance(start_velocity, v); });
+      lower = std::max(start_velocity, end_velocity);
+    }
+    // 最高速度 (距離が足りなければ等速区間なし)
+    auto peak = max_velocity;
+    if (ramp_distance(start_velocity, peak) + ramp_distance(end_velocity, peak) > distance_) {
+      peak = solve(lower, max_velocity,
+                   [&](float v) { return ramp_distance(start_velocity, v) + ramp_distance(end_velocity, v); });
+    }
+    start_velocity_ = start_velocity;
+    end_velocity_ = end_velocity;
+
+    // 区間の表を作る
+    auto cruise_distance =
+        std::max(distance_ - ramp_distance(start_velocity, peak) - ramp_distance(end_velocity, peak), 0.0f);
+    auto cruise_time = peak > 0.0f ? cruise_distance / peak : 0.0f;
+    float ramp_jerk, ramp_time, ramp_constant;
+    ramp(start_velocity, peak, ramp_jerk, ramp_time, ramp_constant);
+    std::size_t index = 0;
+    set(index++, ramp_jerk, ramp_time);
+    set(index++, 0.0f, ramp_constant);
+    set(index++, -ramp_jerk, ramp_time);
+    set(index++, 0.0f, cruise_time);
+    ramp(end_velocity, peak, ramp_jerk, ramp_time, ramp_constant);
+    set(index++, -ramp_jerk, ramp_time);
+    set(index++, 0.0f, ramp_constant);
+    set(index++, ramp_jerk, ramp_time);
+    propagate();
+  }
+
+  /**
+   * @brief 経過時間での目標値
+   * @param time 開始からの経過時間 [s]
+   */
+  [[nodiscard]] State state(float time) const {
+    if (time <= 0.0f) {
+      return {0.0f, start_velocity_, 0.0f};
+    }
+    if (time >= duration_) {
+      return {distance_, end_velocity_, 0.0f};
+    }
+    // 区間を探す (長さ0の区間は飛ばされる)
+    std::size_t index = NUM_SEGMENTS - 1;
+    while (time < segments_[index].time) index--;
+    const auto &s = segments_[index];
+    auto t = time - s.time;
+    auto acceleration = s.acceleration + s.jerk * t;
+    auto velocity = s.velocity + (s.acceleration + s.jerk * t / 2.0f) * t;
+    auto position = s.position + (s.velocity + (s.acceleration / 2.0f + s.jerk * t / 6.0f) * t) * t;
+    return {position, velocity, acceleration};
+  }
+
+  // 全体の時間 [s]
+  [[nodiscard]] float duration() const { return duration_; }
+  // 距離
+  [[nodiscard]] float distance() const { return distance_; }
+  // 終端速度 (届かない場合は実際に終わる速度)
+  [[nodiscard]] float end_velocity() const { return end_velocity_; }
+
+  /**
+   * @brief 速度をfromからtoへ変える間に進む距離
+   * @details 加速度の変化が対称なので平均速度は中間の値になる
+   */
+  [[nodiscard]] static float ramp_distance(float from, float to, float acceleration, float jerk = 0.0f) {
+    float ramp_jerk, jerk_time, constant_time;
+    ramp(from, to, acceleration, jerk, ramp_jerk, jerk_time, constant_time);
+    return (from + to) / 2.0f * (2.0f * jerk_time + constant_time);
+  }
+
+  /**
+   * @brief 距離distanceの間に速度toへ変えられる最も速い速度 (limit以下)
+   * @details 加速も減速も同じ上限なので、開始速度の上限にも終端速度の上限にも使える
+   */
+  [[nodiscard]] static float reachable_velocity(float distance, float to, float limit, float acceleration,
+                                                float jerk = 0.0f) {
+    if (limit <= to || ramp_distance(to, limit, acceleration, jerk) <= distance) return limit;
+    auto low = to, high = limit;
+    for (int i = 0; i < 24; i++) {
+      auto mid = (low + high) / 2.0f;
+      if (ramp_distance(to, mid, acceleration, jerk) > distance) {
+        high = mid;
+      } else {
+        low = mid;
+      }
+    }
+    return low;
+  }
+
+ private:
+  // 区間の開始時の値
+  struct Segment {
+    // 開始時刻
+    float time;
+    // 位置・速度・加速度
+    float position, velocity, acceleration;
+    // 躍度
+    float jerk;
+  };
+
+  //! 距離
+  float distance_;
+  //! 加速度・躍度の制限
+  float acceleration_, jerk_;
+  //! 開始・終端速度
+  float start_velocity_, end_velocity_;
+  //! 全体の時間
+  float duration_;
+  //! 区間の表 (timeには先に区間の長さを入れ、propagateで開始時刻に置き換える)
+  std::array<Segment, NUM_SEGMENTS> segments_;
+
+  /**
+   * @brief 速度をfromからtoへ変える (加速・減速) 区間
+   * @param jerk 躍度の区間の躍度 (加速側の符号)
+   * @param jerk_time 躍度の区間の長さ
+   * @param constant_time 等加速の区間の長さ
+   */
+  static void ramp(float from, float to, float acceleration_limit, float jerk_limit, float &jerk, float &jerk_time,
+                   float &constant_time) {
+    auto dv = std::abs(to - from);
+    if (jerk_limit <= 0.0f) {
+      // 台形
+      jerk = 0.0f;
+      jerk_time = 0.0f;
+      constant_time = dv / acceleration_limit;
+    } else if (dv >= acceleration_limit * acceleration_limit / jerk_limit) {
+      // 最大加速度に届く
+      jerk = jerk_limit;
+      jerk_time = acceleration_limit / jerk_limit;
+      constant_time = dv / acceleration_limit - jerk_time;
+    } else {
+      // 最大加速度に届かない
+      jerk = jerk_limit;
+      jerk_time = std::sqrt(dv / jerk_limit);
+      constant_time = 0.0f;
+    }
+  }
+
+  void ramp(float from, float to, float &jerk, float &jerk_time, float &constant_time) const {
+    ramp(from, to, acceleration_, jerk_, jerk, jerk_time, constant_time);
+  }
+
+  [[nodiscard]] float ramp_distance(float from, float to) const {
+    return ramp_distance(from, to, acceleration_, jerk_);
+  }
+
+  /**
+   * @brief 距離がdistance_になる速度をlowからhighの間で探す (二分法)
+   * @details fは速度に対して単調であること。距離がdistance_を超えない側の値を返す
+   */
+  template <typename F>
+  [[nodiscard]] float solve(float low, float high, F f) const {
+    auto increasing = f(high) >= f(low);
+    for (int i = 0; i < 32; i++) {
+      auto mid = (low + high) / 2.0f;
+      if ((f(mid) > distance_) == increasing) {
+        high = mid;
+      } else {
+        low = mid;
+      }
+    }
+    return increasing ? low : high;
+  }
+
+  void set(std::size_t index, float jerk, float time) { segments_[index] = {time, 0.0f, 0.0f, 0.0f, jerk}; }
+
+  // 区間の長さから各区間の開始時の値を計算する
+  void propagate() {
+    float time = 0.0f, position = 0.0f, velocity = start_velocity_, acceleration = 0.0f;
+    for (std::size_t i = 0; i < NUM_SEGMENTS; i++) {
+      auto &s = segments_[i];
+      auto t = s.time;
+      if (jerk_ <= 0.0f) {
+        // 台形: 躍度の区間がないので加速度は区間ごとに決める
+        acceleration = i == 1 ? acceleration_ : (i == 5 ? -acceleration_ : 0.0f);
+      } else if (i == 3) {
+        // 等速区間では誤差を持ち越さない
+        acceleration = 0.0f;
+      }
+      s.time = time;
+      s.position = position;
+      s.velocity = velocity;
+      s.acceleration = acceleration;
+      position += (velocity + (acceleration / 2.0f + s.jerk * t / 6.0f) * t) * t;
+      velocity += (acceleration + s.jerk * t / 2.0f) * t;
+      acceleration += s.jerk * t;
+      time += t;
+    }
+    duration_ = time;
+  }
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+// C++
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief エンコーダーのカウントから車輪の角度と角速度を推定するトラッキングオブザーバ
+ * @details
+ * 角加速度を入力として角度・角速度を予測し、エンコーダーのカウントとの差で補正する (PLL)。
+ * 観測角度はカウントの区間 [n, n+1) のどこかにあるため、
+ * 推定角度が区間内にある間は補正せず、区間からはみ出した分だけ補正する。
+ * これによりカウントが変化しない間も角度が滑らかに進み、1カウント未満の動きを補間できる。
+ */
+class VelocityObserver {
+ public:
+  /**
+   * @param angle_per_count 1カウントあたりの角度 [rad]
+   * @param bandwidth 帯域 [rad/s]
+   * @param damping 減衰比
+   */
+  explicit VelocityObserver(float angle_per_count, float bandwidth, float damping)
+      : angle_per_count_(angle_per_count), bandwidth_(bandwidth), damping_(damping) {
+    reset();
+  }
+  ~VelocityObserver() = default;
+
+  /**
+   * @brief リセット
+   */
+  void reset() {
+    counts_ = 0;
+    angle_ = angle_per_count_ / 2.0f;
+    angular_velocity_ = 0.0f;
+  }
+
+  /**
+   * @brief 推定値を更新する
+   * @param delta_counts 前回からのカウント変化量
+   * @param angular_acceleration 角加速度の予測値 [rad/s^2]
+   * @param dt 更新周期 [s]
+   * @return 推定角速度 [rad/s]
+   */
+  float update(int32_t delta_counts, float angular_acceleration, float dt) {
+    // 予測
+    angle_ += (angular_velocity_ + angular_acceleration * dt / 2.0f) * dt;
+    angular_velocity_ += angular_acceleration * dt;
+
+    // カウントの区間からはみ出した量 (原点をカウントに合わせて桁落ちを防ぐ)
+    counts_ += delta_counts;
+    angle_ -= static_cast<float>(delta_counts) * angle_per_count_;
+    float error = 0.0f;
+    if (angle_ < 0.0f) {
+      error = -angle_;
+    } else if (angle_ > angle_per_count_) {
+      error = angle_per_count_ - angle_;
+    }
+
+    // 補正
+    const float wn = bandwidth_ * dt;
+    angle_ += 2.0f * damping_ * wn * error;
+    angular_velocity_ += wn * wn * error / dt;
+    return angular_velocity_;
+  }
+
+  // 推定角度 [rad] (リセットからの累積)
+  [[nodiscard]] float angle() const { return static_cast<float>(counts_) * angle_per_count_ + angle_; }
+  // 推定角速度 [rad/s]
+  [[nodiscard]] float angular_velocity() const { return angular_velocity_; }
+
+ private:
+  //! 1カウントあたりの角度 [rad]
+  const float angle_per_count_;
+
+  //! 帯域 [rad/s]
+  const float bandwidth_;
+
+  //! 減衰比
+  const float damping_;
+
+  //! リセットからのカウント
+  int32_t counts_;
+
+  //! 現在のカウントの区間の下端からの推定角度 [rad]
+  float angle_;
+
+  //! 推定角速度 [rad/s]
+  float angular_velocity_;
+};
@@ -0,0 +1,225 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Project
+#include "parameters.h"
+#include "pid.h"
+
+/**
+ * @brief 横壁制御 (45度センサの偏差を角速度の目標値に足す)
+ * @details
+ * 壁がある側のセンサだけを使い、両側にある場合は左右の偏差の平均、片側だけの場合はその側の偏差で、
+ * 区画中心からの横ずれを表す。壁の有無が切り替わった直後と、柱で値が跳ねた後はその側を一定距離使わない。
+ * 偏差は基準値からの差 (近いほど正) のまま使うので、ゲインは [(rad/s)/カウント] になる。
+ */
+class SideWallControl {
+ public:
+  // 45度センサの観測値
+  struct Observation {
+    // 左45度の偏差 (基準値からの差)
+    int left;
+    // 右45度の偏差
+    int right;
+    // 左45度で壁あり
+    bool left_exist;
+    // 右45度で壁あり
+    bool right_exist;
+  };
+
+  /**
+   * @param gain 偏差から角速度へのPIDゲイン
+   * @param calibrated 基準値を調整済みかどうか (未調整の場合は何もしない)
+   */
+  explicit SideWallControl(const PidGain<float> &gain = {WALL_ADJUST_SIDE_PID_GAIN[PARAMETER_PID_KP],
+                                                          WALL_ADJUST_SIDE_PID_GAIN[PARAMETER_PID_KI],
+                                                          WALL_ADJUST_SIDE_PID_GAIN[PARAMETER_PID_KD]},
+                           bool calibrated = WALL_REFERENCE_VALUE[PARAMETER_WALL_LEFT45] > 0 &&
+                                             WALL_REFERENCE_VALUE[PARAMETER_WALL_RIGHT45] > 0)
+      : pid_({
+            .gain = gain,
+            .output_min = -WALL_ADJUST_SIDE_LIMIT,
+            .output_max = WALL_ADJUST_SIDE_LIMIT,
+            .anti_windup = AntiWindup::BackCalculation,
+            .tracking_time_constant = PID_TRACKING_TIME_CONSTANT,
+            .derivative_time_constant = PID_DERIVATIVE_TIME_CONSTANT,
+        }),
+        calibrated_(calibrated) {
+    reset();
+  }
+  ~SideWallControl() = default;
+
+  void reset() {
+    pid_.reset();
+    left_ = {};
+    right_ = {};
+    error_ = 0.0f;
+    active_ = false;
+  }
+
+  /**
+   * @param observation 45度センサの観測値
+   * @param velocity 並進速度の目標値 [m/s]
+   * @param dt 制御周期 [s]
+   * @return 角速度の補正量 [rad/s] (左回りが正)
+   */
+  float update(const Observation &observation, float velocity, float dt) {
+    // 進んだ距離で使わない区間を減らす
+    auto advance = std::max(velocity, 0.0f) * dt * 1000.0f;
+    auto left = left_.update(observation.left, observation.left_exist, advance);
+    auto right = right_.update(observation.right, observation.right_exist, advance);
+
+    // 遅い間・後退中は曲げない
+    if (!calibrated_ || velocity < WALL_ADJUST_MIN_VELOCITY || (!left && !right)) {
+      if (active_) pid_.reset();
+      active_ = false;
+      error_ = 0.0f;
+      return 0.0f;
+    }
+    // 左に寄ると左の偏差が増え右が減る (右に回して戻す)
+    if (left && right) {
+      error_ = static_cast<float>(observation.right - observation.left) / 2.0f;
+    } else if (left) {
+      error_ = -static_cast<float>(observation.left);
+    } else {
+      error_ = static_cast<float>(observation.right);
+    }
+    active_ = true;
+    return pid_.update(error_, 0.0f, dt);
+  }
+
+  // 横ずれを表す偏差 (正なら右に寄っている)
+  [[nodiscard]] float error() const { return error_; }
+  // 前回の更新で補正したかどうか
+  [[nodiscard]] bool active() const { return active_; }
+
+ private:
+  // 片側のセンサの状態
+  struct Side {
+    // 前回の偏差
+    int previous;
+    // 前回の壁の有無
+    bool exist;
+    // 使わない残りの距離 [mm]
+    float masked;
+
+    // 今回この側を使えるかどうか
+    bool update(int error, bool wall, float advance) {
+      masked = std::max(masked - advance, 0.0f);
+      // 壁の切れ目・柱の前後は値が壁の位置を表さない
+      if (wall != exist || (wall && std::abs(error - previous) > WALL_ADJUST_POST_DELTA)) {
+        masked = WALL_ADJUST_MASK_LENGTH;
+      }
+      previous = error;
+      exist = wall;
+      return wall && masked <= 0.0f;
+    }
+  };
+
+  //! 偏差から角速度へのPID
+  PidController<float> pid_;
+  //! 基準値を調整済みかどうか
+  const bool calibrated_;
+  //! 左右のセンサの状態
+  Side left_, right_;
+  //! 前回の偏差
+  float error_;
+  //! 前回の更新で補正したかどうか
+  bool active_;
+};
+
+/**
+ * @brief 前壁合わせ (90度センサで前壁との距離と角度を区画中心に合わせる)
+ * @details
+ * 左右の値を反射光が距離の2乗に反比例するとして距離に直し、平均を区画中心での距離に、
+ * 差から求めた壁に対する角度を0に近づける並進速度・角速度を出す。
+ * 両方が許容範囲に入った状態が続くか、前壁が見えない場合に終わる。
+ */
+class FrontWallAlignment {
+ public:
+  // 速度・角速度の目標値
+  struct Command {
+    // 並進速度 [m/s]
+    float velocity;
+    // 角速度 [rad/s] (左回りが正)
+    float angular_velocity;
+  };
+
+  /**
+   * @param reference_left 区画中心での左90度の値
+   * @param reference_right 区画中心での右90度の値
+   */
+  explicit FrontWallAlignment(int reference_left = WALL_REFERENCE_VALUE[PARAMETER_WALL_LEFT90],
+                              int reference_right = WALL_REFERENCE_VALUE[PARAMETER_WALL_RIGHT90])
+      : reference_left_(reference_left), reference_right_(reference_right) {
+    reset();
+  }
+  ~FrontWallAlignment() = default;
+
+  void reset() {
+    distance_error_ = 0.0f;
+    angle_error_ = 0.0f;
+    settled_ = 0;
+    finished_ = false;
+  }
+
+  /**
+   * @param front_left 左90度の値
+   * @param front_right 右90度の値
+   * @param exist 前壁あり
+   * @return 速度・角速度の目標値
+   */
+  Command update(int front_left, int front_right, bool exist) {
+    if (finished_) return {0.0f, 0.0f};
+    // 未調整・前壁がない場合は合わせられない
+    if (reference_left_ <= 0 || reference_right_ <= 0 || !exist || front_left <= 0 || front_right <= 0) {
+      finished_ = true;
+      return {0.0f, 0.0f};
+    }
+    auto left = FRONT_WALL_DISTANCE * std::sqrt(static_cast<float>(reference_left_) / static_cast<float>(front_left));
+    auto right =
+        FRONT_WALL_DISTANCE * std::sqrt(static_cast<float>(reference_right_) / static_cast<float>(front_right));
+    // 遠いほど正、左に回っているほど正
+    distance_error_ = (left + right) / 2.0f - FRONT_WALL_DISTANCE;
+    angle_error_ = std::atan2(left - right, WALL_FRONT_SENSOR_SPACING);
+
+    if (std::abs(distance_error_) < WALL_ALIGN_DISTANCE_TOLERANCE &&
+        std::abs(angle_error_) < WALL_ALIGN_ANGLE_TOLERANCE) {
+      if (++settled_ >= WALL_ALIGN_SETTLE_COUNT) {
+        finished_ = true;
+        return {0.0f, 0.0f};
+      }
+    } else {
+      settled_ = 0;
+    }
+    auto velocity = std::clamp(WALL_ALIGN_DISTANCE_GAIN * distance_error_, -WALL_ALIGN_MAX_VELOCITY,
+                               WALL_ALIGN_MAX_VELOCITY);
+    auto angular_velocity = std::clamp(-WALL_ALIGN_ANGLE_GAIN * angle_error_, -WALL_ALIGN_MAX_ANGULAR_VELOCITY,
+                                       WALL_ALIGN_MAX_ANGULAR_VELOCITY);
+    return {velocity, angular_velocity};
+  }
+
+  [[nodiscard]] bool finished() const { return finished_; }
+  // 区画中心での距離との差 [mm] (遠いほど正)
+  [[nodiscard]] float distance_error() const { return distance_error_; }
+  // 前壁に対する角度 [rad] (左回りが正)
+  [[nodiscard]] float angle_error() const { return angle_error_; }
+
+ private:
+  //! 区画中心にいる時の、車体中心から前壁の表面までの距離 [mm]
+  static constexpr float FRONT_WALL_DISTANCE = (MAZE_SECTION_SIZE - MAZE_WALL_THICKNESS) / 2.0f;
+
+  //! 区画中心での90度センサの値
+  const int reference_left_, reference_right_;
+  //! 区画中心での距離との差 [mm]
+  float distance_error_;
+  //! 前壁に対する角度 [rad]
+  float angle_error_;
+  //! 許容範囲に入り続けた周期の数
+  uint32_t settled_;
+  //! 終わったかどうか
+  bool finished_;
+};
@@ -0,0 +1,156 @@
+#pragma once
+
+// C++
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+// Project
+#include "parameters.h"
+#include "velocity_observer.h"
+
+/**
+ * @berif 左右車輪の値
+ */
+struct WheelsPair {
+  float right;
+  float left;
+};
+
+/**
+ * @brief 車輪から得られる車体情報を管理する
+ * @details 速度はエンコーダーのカウントと角加速度の予測値からオブザーバで推定する。
+ */
+class Wheel {
+ public:
+  /**
+   * @param resolution エンコーダーの分解能
+   * @param tire_diameter 車輪の直径 [mm]
+   * @param invert エンコーダーの回転方向を反転する
+   */
+  explicit Wheel(uint16_t resolution, float tire_diameter, bool invert)
+      : tire_diameter_(tire_diameter),
+        invert_(invert),
+        resolution_(resolution),
+        resolution_half_(resolution / 2),
+        angle_per_resolution_((2.0f * std::numbers::pi_v<float>) / static_cast<float>(resolution)),
+        observer_(angle_per_resolution_, VELOCITY_OBSERVER_BANDWIDTH, VELOCITY_OBSERVER_DAMPING) {}
+  ~Wheel() = default;
+
+  /**
+   * @brief 車輪情報を更新する
+   * @param current 最新の観測角度
+   * @param delta_us 更新周期 [us]
+   * @param angular_acceleration 車輪の角加速度の予測値 [rad/s^2]
+   */
+  void update(uint16_t current, uint32_t delta_us, float angular_acceleration = 0.0f) {
+    // 回転方向を反転
+    if (invert_) {
+      current = resolution_ - current;
+    }
+    if (reset_) [[unlikely]] {
+      previous_ = current;
+      observer_.reset();
+      reset_ = false;
+    }
+
+    auto counts = calculate_delta_counts(current);
+    previous_ = current;
+    integrate(counts, delta_us, angular_acceleration);
+  }
+
+  /**
+   * @brief 周回をまたいで積算したカウントで車輪情報を更新する
+   * @param total 積算カウント
+   * @param delta_us 更新周期 [us]
+   * @param angular_acceleration 車輪の角加速度の予測値 [rad/s^2]
+   */
+  void update_total(int32_t total, uint32_t delta_us, float angular_acceleration = 0.0f) {
+    // 回転方向を反転
+    if (invert_) {
+      total = -total;
+    }
+    if (reset_) [[unlikely]] {
+      previous_total_ = total;
+      observer_.reset();
+      reset_ = false;
+    }
+
+    auto counts = total - previous_total_;
+    previous_total_ = total;
+    integrate(counts, delta_us, angular_acceleration);
+  }
+
+  /**
+   * @brief リセット
+   */
+  void reset() {
+    reset_ = true;
+    angular_velocity_ = 0.0f;
+    velocity_ = 0.0f;
+  }
+
+  [[nodiscard]] float angular_velocity() const { return angular_velocity_; }
+  [[nodiscard]] float velocity() const { return velocity_; }
+
+ private:
+  //! 車輪の直径 [mm]
+  const float tire_diameter_;
+
+  //! エンコーダーの回転方向を反転するか
+  const bool invert_;
+
+  //! 初期化後かどうか
+  bool reset_{true};
+
+  //! エンコーダーの分解能
+  uint16_t resolution_{0};
+
+  //! エンコーダーの分解能の半分
+  uint16_t resolution_half_{0};
+
+  //! 分解能あたりの角度 [rad]
+  float angle_per_resolution_{0};
+
+  //! 一つ前の観測角度
+  uint16_t previous_{0};
+
+  //! 一つ前の積算カウント
+  int32_t previous_total_{0};
+
+  //! 角速度の推定
+  VelocityObserver observer_;
+
+  //! 車輪の角速度 [rad/s]
+  float angular_velocity_{0.0f};
+
+  //! 車輪位置の移動速度 [mm/s]
+  float velocity_{0.0f};
+
+  /**
+   * @brief カウントの変化量から角速度・速度を推定する
+   */
+  void integrate(int32_t counts, uint32_t delta_us, float angular_acceleration) {
+    auto dt = static_cast<float>(delta_us) / 1000'000.0f;
+    angular_velocity_ = observer_.update(counts, angular_acceleration, dt);
+    velocity_ = angular_velocity_ * (tire_diameter_ / 2.0f);
+  }
+
+  /**
+   * @brief 前回の観測角度からの変化量を計算する。
+   * @param current 最新の観測角度
+   * @return 変化量 [カウント]
+   */
+  [[nodiscard]] int32_t calculate_delta_counts(uint16_t current) const {
+    // 更新周期での観測値の変化量を計算
+    auto delta = current - previous_;
+    if (std::abs(delta) >= resolution_half_) {
+      if (previous_ >= resolution_half_) {
+        delta += resolution_;
+      } else {
+        delta -= resolution_;
+      }
+    }
+    return delta;
+  }
+};
@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+
+#include "../../main/autotune.h"
+#include "../../main/pid.h"
+
+// 制御周期 [s]
+static constexpr float DT = 0.001f;
+
+/**
+ * @brief 摩擦と遅れのあるモーターのプラント
+ * @details T y' = K (u - Vf sgn(y)) - y を1周期ごとに厳密に離散化し、計測値はDELAY周期遅れて届く
+ */
+struct Plant {
+  double gain, time_constant, friction;
+  std::size_t delay;
+  double output = 0.0;
+  std::deque<double> measured;
+
+  float measure() const { return static_cast<float>(measured.size() < delay ? 0.0 : measured.front()); }
+
+  void update(float input) {
+    auto u = static_cast<double>(input);
+    if (output > 0.0) {
+      u -= friction;
+    } else if (output < 0.0) {
+      u += friction;
+    } else if (std::abs(u) <= friction) {
+      u = 0.0;
+    } else {
+      u -= std::copysign(friction, u);
+    }
+    auto a = std::exp(-static_cast<double>(DT) / time_constant);
+    output = a * output + gain * (1.0 - a) * u;
+    measured.push_back(output);
+    if (measured.size() > delay) measured.pop_front();
+  }
+};
+
+// 並進の速度ループ相当 (K [(m/s)/V], T [s], 摩擦 [V], 計測の遅れ [周期])
+static Plant velocityPlant() { return {2.56, 0.05, 0.04, 2, 0.0, {}}; }
+// 旋回の角速度ループ相当
+static Plant angularPlant() { return {155.0, 0.03, 0.04, 2, 0.0, {}}; }
+
+/**
+ * @brief 比例制御のゲインを上げて持続振動する限界ゲインと周期を探す (二分法)
+ * @details リレーの記述関数による近似と比べるための基準
+ */
+static autotune::Result reference(Plant initial, float setpoint) {
+  auto oscillates = [&](float kp, float &period) {
+    auto plant = initial;
+    float previous = 0.0f, first = -1.0f, last = -1.0f;
+    int crossings = 0;
+    double early = 0.0, late = 0.0;
+    for (int i = 0; i < 4000; i++) {
+      auto error = setpoint - plant.measure();
+      // 定常偏差のぶんは中心の電圧で補う
+      auto u = kp * error + setpoint / static_cast<float>(plant.gain) + static_cast<float>(plant.friction);
+      plant.update(std::clamp(u, -2.5f, 2.5f));
+      auto deviation = plant.measure() - setpoint;
+      if (i >= 1000 && i < 2000) early = std::max(early, std::abs(static_cast<double>(deviation)));
+      if (i >= 3000) late = std::max(late, std::abs(static_cast<double>(deviation)));
+      if (i >= 2000 && previous < 0.0f && deviation >= 0.0f) {
+        if (first < 0.0f) first = static_cast<float>(i) * DT;
+        last = static_cast<float>(i) * DT;
+        crossings++;
+      }
+      previous = deviation;
+    }
+    if (crossings > 1) period = (last - first) / static_cast<float>(crossings - 1);
+    return late >= early * 0.5 && late > 1e-4;
+  };
+  float low = 0.0f, high = 100.0f / static_cast<float>(initial.gain), period = 0.0f;
+  for (int i = 0; i < 30; i++) {
+    auto mid = (low + high) / 2.0f;
+    if (oscillates(mid, period)) {
+      high = mid;
+    } else {
+      low = mid;
+    }
+  }
+  oscillates(high, period);
+  return {high, period, 0.0f, true};
+}
+
+static autotune::Result relay(Plant plant, const autotune::Config &config, float &bias) {
+  autotune::RelayTuner tuner;
+  tuner.start(config);
+  while (!tuner.finished()) {
+    plant.update(tuner.update(plant.measure(), DT));
+  }
+  bias = tuner.bias();
+  return tuner.result();
+}
+
+// ステップ応答の行き過ぎ量 [%] と最後の誤差
+static void step(Plant plant, float target, const PidGain<float> &gain, double &overshoot, double &error) {
+  PidController<float> pid({
+      .gain = gain,
+      .output_min = -2.5f,
+      .output_max = 2.5f,
+      .anti_windup = AntiWindup::BackCalculation,
+      .tracking_time_constant = 0.02f,
+      .derivative_time_constant = 0.002f,
+  });
+  double peak = 0.0;
+  for (int i = 0; i < 3000; i++) {
+    plant.update(pid.update(target, plant.measure(), DT));
+    peak = std::max(peak, plant.output);
+  }
+  overshoot = 100.0 * (peak / static_cast<double>(target) - 1.0);
+  error = std::abs(plant.output / static_cast<double>(target) - 1.0);
+}
+
+// リレーで求めた限界ゲイン・周期が比例制御で探した値に近い
+static void testUltimate(const char *name, const Plant &plant, const autotune::Config &config) {
+  float bias = 0.0f;
+  auto result = relay(plant, config, bias);
+  auto expected = reference(plant, config.setpoint);
+  printf("%s: Ku %.4f (%.4f), Pu %.4f (%.4f) s, amplitude %.4f, bias %.4f V\n", name,
+         static_cast<double>(result.ultimate_gain), static_cast<double>(expected.ultimate_gain),
+         static_cast<double>(result.ultimate_period), static_cast<double>(expected.ultimate_period),
+         static_cast<double>(result.amplitude), static_cast<double>(bias));
+  assert(result.valid);
+  // 記述関数は基本波だけの近似なので、ゲインは2割、周期は1割程度ずれる
+  assert(std::abs(result.ultimate_gain / expected.ultimate_gain - 1.0f) < 0.25f);
+  assert(std::abs(result.ultimate_period / expected.ultimate_period - 1.0f) < 0.15f);
+  // 中心の電圧は目標値を保つ電圧に寄る
+  auto hold = config.setpoint / static_cast<float>(plant.gain) + static_cast<float>(plant.friction);
+  assert(std::abs(bias - hold) < std::abs(config.bias - hold));
+}
+
+// 調整則によるゲインで閉ループが安定し、Tyreus-LuybenはZiegler-Nicholsより行き過ぎが小さい
+static void testRules(const char *name, const Plant &plant, const autotune::Config &config) {
+  float bias = 0.0f;
+  auto result = relay(plant, config, bias);
+  assert(result.valid);
+  double overshoot[4], error[4];
+  const autotune::Rule rules[] = {autotune::Rule::ZieglerNicholsPi, autotune::Rule::ZieglerNicholsPid,
+                                  autotune::Rule::TyreusLuybenPi, autotune::Rule::TyreusLuybenPid};
+  for (int i = 0; i < 4; i++) {
+    auto gain = autotune::RelayTuner::gain(result, rules[i]);
+    step(plant, config.setpoint, gain, overshoot[i], error[i]);
+    printf("%s rule %d: kp %.4f, ki %.4f, kd %.5f, overshoot %.1f %%, error %.2e\n", name, i,
+           static_cast<double>(gain.kp), static_cast<double>(gain.ki), static_cast<double>(gain.kd), overshoot[i],
+           error[i]);
+    assert(error[i] < 0.01);
+  }
+  assert(overshoot[2] < overshoot[0]);
+  assert(overshoot[3] < overshoot[1]);
+}
+
+// 調整則の表
+static void testTable() {
+  constexpr autotune::Result RESULT{2.0f, 0.1f, 0.0f, true};
+  constexpr auto ZN = autotune::RelayTuner::gain(RESULT, autotune::Rule::ZieglerNicholsPid);
+  static_assert(std::abs(ZN.kp - 1.2f) < 1e-6f && std::abs(ZN.ki - 24.0f) < 1e-4f && std::abs(ZN.kd - 0.015f) < 1e-6f);
+  constexpr auto TL = autotune::RelayTuner::gain(RESULT, autotune::Rule::TyreusLuybenPi);
+  static_assert(std::abs(TL.kp - 0.625f) < 1e-6f && std::abs(TL.ki - 0.625f / 0.22f) < 1e-4f &&
+                std::abs(TL.kd) < 1e-9f);
+}
+
+// 応答しないプラントでは打ち切って無効な結果を返す
+static void testTimeout() {
+  Plant plant{0.0, 0.05, 0.0, 2, 0.0, {}};
+  autotune::RelayTuner tuner;
+  tuner.start({0.3f, 0.1f, 0.2f, 0.005f, 5, 5, 0.5f});
+  int ticks = 0;
+  while (!tuner.finished()) {
+    plant.update(tuner.update(plant.measure(), DT));
+    ticks++;
+  }
+  assert(!tuner.result().valid);
+  assert(ticks <= 501);
+}
+
+int main() {
+  // 中心の電圧はわざと2割ずらしておく
+  const autotune::Config velocity{0.3f, 0.3f / 2.56f * 0.8f, 0.2f, 0.001f, 5, 5, 2.0f};
+  const autotune::Config angular{6.0f, 6.0f / 155.0f * 0.8f, 0.05f, 0.02f, 5, 5, 2.0f};
+  testUltimate("velocity", velocityPlant(), velocity);
+  testUltimate("angular", angularPlant(), angular);
+  testRules("velocity", velocityPlant(), velocity);
+  testRules("angular", angularPlant(), angular);
+  testTable();
+  testTimeout();
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,212 @@
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "../../main/dri/seqlock.h"
+#include "../../main/dri/spsc_queue.h"
+
+// Sensed程度の大きさのフレーム (全フィールドが同じ通し番号なら一貫している)
+struct Frame {
+  uint32_t sequence;
+  float values[30];
+  int32_t counts[8];
+  bool flags[6];
+};
+
+static Frame makeFrame(uint32_t sequence) {
+  Frame frame{};
+  frame.sequence = sequence;
+  for (auto &value : frame.values) value = static_cast<float>(sequence);
+  for (auto &count : frame.counts) count = static_cast<int32_t>(sequence);
+  for (auto &flag : frame.flags) flag = (sequence & 1) != 0;
+  return frame;
+}
+
+static bool consistent(const Frame &frame) {
+  for (const auto value : frame.values) {
+    if (static_cast<uint32_t>(value) != frame.sequence) return false;
+  }
+  for (const auto count : frame.counts) {
+    if (static_cast<uint32_t>(count) != frame.sequence) return false;
+  }
+  for (const auto flag : frame.flags) {
+    if (flag != ((frame.sequence & 1) != 0)) return false;
+  }
+  return true;
+}
+
+// 書き込み1・読み出し1のスレッドで、読み出した値が途中で書き換わっていないことを確かめる
+static void testSeqLockStress() {
+  // floatで正確に表せる範囲
+  constexpr uint32_t FRAMES = 2'000'000;
+  data::SeqLock<Frame> lock;
+  std::atomic<bool> done{false};
+
+  uint64_t reads = 0, retries = 0, torn = 0, backwards = 0;
+  std::thread reader([&] {
+    uint32_t previous = 0;
+    while (!done.load(std::memory_order_acquire)) {
+      Frame frame;
+      if (!lock.try_load(frame)) {
+        retries++;
+        continue;
+      }
+      reads++;
+      if (!consistent(frame)) torn++;
+      if (frame.sequence < previous) backwards++;
+      previous = frame.sequence;
+    }
+  });
+
+  std::thread writer([&] {
+    for (uint32_t i = 1; i <= FRAMES; i++) {
+      lock.store(makeFrame(i));
+    }
+    done.store(true, std::memory_order_release);
+  });
+
+  writer.join();
+  reader.join();
+
+  const auto last = lock.load();
+  printf("seqlock: %llu reads, %llu retries, %llu torn, %llu backwards, last %u\n",
+         static_cast<unsigned long long>(reads), static_cast<unsigned long long>(retries),
+         static_cast<unsigned long long>(torn), static_cast<unsigned long long>(backwards), last.sequence);
+  assert(torn == 0);
+  assert(backwards == 0);
+  assert(reads > 0);
+  assert(last.sequence == FRAMES && consistent(last));
+  // コンストラクタでの初期化 + 書き込み回数
+  assert(lock.version() == FRAMES + 1);
+}
+
+// 公開前は初期値が読める
+static void testSeqLockInitial() {
+  data::SeqLock<Frame> lock(makeFrame(42));
+  auto frame = lock.load();
+  assert(frame.sequence == 42 && consistent(frame));
+  assert(lock.version() == 1);
+}
+
+// 空・満杯・先読み・破棄
+static void testSpscQueueBasics() {
+  data::SpscQueue<int, 4> queue;
+  int item = 0;
+  assert(!queue.receive(&item));
+  assert(!queue.peek(&item));
+  for (int i = 0; i < 4; i++) {
+    assert(queue.send(&i));
+  }
+  assert(!queue.send(&item));
+  assert(queue.waiting() == 4 && queue.available() == 0);
+  assert(queue.peek(&item) && item == 0);
+  assert(queue.peek(3, &item) && item == 3);
+  assert(!queue.peek(4, &item));
+  assert(queue.receive(&item) && item == 0);
+  assert(queue.receive(&item) && item == 1);
+  // 折り返し
+  int next = 4;
+  assert(queue.send(&next));
+  assert(queue.waiting() == 3);
+  assert(queue.peek(2, &item) && item == 4);
+  queue.reset();
+  assert(queue.waiting() == 0);
+  assert(!queue.receive(&item));
+  assert(queue.send(&next) && queue.receive(&item) && item == 4);
+}
+
+// 送信1・受信1のスレッドで、取りこぼし・重複・順序の入れ替わりがないことを確かめる
+static void testSpscQueueStress() {
+  constexpr uint32_t ITEMS = 2'000'000;
+  struct Command {
+    uint32_t sequence;
+    uint32_t check;
+  };
+  static data::SpscQueue<Command, 16> queue;
+
+  uint64_t full = 0, empty = 0, errors = 0;
+  std::thread consumer([&] {
+    uint32_t expected = 0;
+    Command command{};
+    while (expected < ITEMS) {
+      if (!queue.receive(&command)) {
+        empty++;
+        std::this_thread::yield();
+        continue;
+      }
+      if (command.sequence != expected || command.check != ~expected) errors++;
+      expected++;
+    }
+  });
+  std::thread producer([&] {
+    for (uint32_t i = 0; i < ITEMS;) {
+      Command command{i, ~i};
+      if (!queue.send(&command)) {
+        full++;
+        std::this_thread::yield();
+        continue;
+      }
+      i++;
+    }
+  });
+  producer.join();
+  consumer.join();
+
+  printf("spsc: %u items, %llu full, %llu empty, %llu errors\n", ITEMS, static_cast<unsigned long long>(full),
+         static_cast<unsigned long long>(empty), static_cast<unsigned long long>(errors));
+  assert(errors == 0);
+  assert(queue.waiting() == 0);
+}
+
+// 送信と受信の組の所要時間 (ホストでは排他制御付きのリングと比べる)
+static void benchmarkSpscQueue() {
+  constexpr uint32_t COUNTS = 1'000'000;
+  static data::SpscQueue<uint32_t, 16> queue;
+  uint32_t item = 0, sum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    queue.send(&i);
+    queue.receive(&item);
+    sum += item;
+  }
+  const auto spsc = std::chrono::steady_clock::now() - start;
+
+  // カーネルのクリティカルセクションの代わりにmutexを使う
+  std::mutex mutex;
+  std::array<uint32_t, 16> buffer{};
+  std::size_t head = 0, tail = 0;
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < COUNTS; i++) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      buffer[tail++ & 15] = i;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      item = buffer[head++ & 15];
+    }
+    sum += item;
+  }
+  const auto locked = std::chrono::steady_clock::now() - start;
+
+  auto ns = [](auto elapsed) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / COUNTS;
+  };
+  printf("spsc: send + receive %f ns, mutex %f ns (checksum %u)\n", ns(spsc), ns(locked), sum);
+}
+
+int main() {
+  testSeqLockInitial();
+  testSeqLockStress();
+  testSpscQueueBasics();
+  testSpscQueueStress();
+  benchmarkSpscQueue();
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <type_traits>
+
+#include "../../main/pid.h"
+
+// 1次遅れのプラント K / (T s + 1) の定数
+static constexpr double PLANT_GAIN = 2.0;
+static constexpr double PLANT_TIME_CONSTANT = 0.05;
+// 参照応答と比べるための細かい周期 [s]
+static constexpr double DT = 1e-5;
+
+static bool near(double a, double b, double tolerance) { return std::abs(a - b) <= tolerance; }
+
+// 1次遅れのプラント (入力の飽和あり)
+struct Plant {
+  double output = 0.0;
+  double limit = 1e9;
+
+  double update(double input) {
+    input = std::clamp(input, -limit, limit);
+    output += (PLANT_GAIN * input - output) * DT / PLANT_TIME_CONSTANT;
+    return output;
+  }
+};
+
+// 比例制御のステップ応答は、定常値 K kp / (1 + K kp)・時定数 T / (1 + K kp) の1次遅れになる
+static void testProportional() {
+  constexpr double KP = 3.0;
+  PidController<double, PidStructure::Pi> controller({.gain = {KP, 0.0, 0.0}});
+  Plant plant;
+  double max_error = 0.0;
+  for (int i = 1; i <= 20'000; i++) {
+    plant.update(controller.update(1.0, plant.output, DT));
+    auto t = i * DT;
+    auto reference = PLANT_GAIN * KP / (1.0 + PLANT_GAIN * KP) *
+                     (1.0 - std::exp(-t * (1.0 + PLANT_GAIN * KP) / PLANT_TIME_CONSTANT));
+    max_error = std::max(max_error, std::abs(plant.output - reference));
+  }
+  printf("proportional: max error %.2e\n", max_error);
+  assert(max_error < 1e-3);
+}
+
+// 積分時間をプラントの時定数に合わせたPI制御のステップ応答は、時定数 T / (K kp) の1次遅れになる
+static void testPiCancellation() {
+  constexpr double KP = 2.0;
+  PidController<double, PidStructure::Pi> controller({.gain = {KP, KP / PLANT_TIME_CONSTANT, 0.0}});
+  Plant plant;
+  double max_error = 0.0;
+  for (int i = 1; i <= 20'000; i++) {
+    plant.update(controller.update(1.0, plant.output, DT));
+    auto t = i * DT;
+    auto reference = 1.0 - std::exp(-t * PLANT_GAIN * KP / PLANT_TIME_CONSTANT);
+    max_error = std::max(max_error, std::abs(plant.output - reference));
+  }
+  printf("pi cancellation: max error %.2e\n", max_error);
+  assert(max_error < 1e-3);
+}
+
+// ランプ入力に対するフィルタ付き微分は kd a (1 - alpha^n) になり、ノイズは小さくなる
+static void testDerivativeFilter() {
+  constexpr double KD = 0.5, SLOPE = 2.0, TF = 0.01, STEP = 1e-3;
+  PidController<double> filtered({.gain = {0.0, 0.0, KD}, .derivative_time_constant = TF});
+  const auto alpha = TF / (TF + STEP);
+  for (int i = 0; i < 100; i++) {
+    auto output = filtered.update(0.0, -SLOPE * i * STEP, STEP);
+    // 初回は前回値がないので0
+    auto reference = KD * SLOPE * (1.0 - std::pow(alpha, i));
+    assert(near(output, reference, 1e-9));
+  }
+
+  // 計測値のノイズ
+  std::mt19937 random(1);
+  std::normal_distribution<double> noise(0.0, 0.01);
+  PidController<double> raw({.gain = {0.0, 0.0, KD}});
+  filtered.reset();
+  double raw_sum = 0.0, filtered_sum = 0.0;
+  for (int i = 0; i < 10'000; i++) {
+    auto measurement = noise(random);
+    auto a = raw.update(0.0, measurement, STEP);
+    auto b = filtered.update(0.0, measurement, STEP);
+    raw_sum += a * a;
+    filtered_sum += b * b;
+  }
+  printf("derivative noise: raw %.3f, filtered %.3f\n", std::sqrt(raw_sum / 10'000), std::sqrt(filtered_sum / 10'000));
+  assert(filtered_sum < raw_sum / 10.0);
+}
+
+/**
+ * 入力が飽和する大きなステップで、積分の飽和対策があれば行き過ぎが小さい
+ * @return 行き過ぎ量
+ */
+static double overshoot(AntiWindup anti_windup) {
+  PidController<double, PidStructure::Pi> controller({
+      .gain = {1.0, 200.0, 0.0},
+      .output_min = -1.0,
+      .output_max = 1.0,
+      .anti_windup = anti_windup,
+      .tracking_time_constant = 0.01,
+  });
+  Plant plant;
+  plant.limit = 1.0;
+  // 定常で入力0.8が必要な目標
+  constexpr double TARGET = 1.6;
+  double peak = 0.0;
+  for (int i = 0; i < 100'000; i++) {
+    auto input = controller.update(TARGET, plant.output, DT);
+    assert(-1.0 <= input && input <= 1.0);
+    peak = std::max(peak, plant.update(input));
+  }
+  // 最後は目標に落ち着く
+  assert(near(plant.output, TARGET, 1e-3));
+  return peak - TARGET;
+}
+
+static void testAntiWindup() {
+  auto none = overshoot(AntiWindup::None);
+  auto conditional = overshoot(AntiWindup::Conditional);
+  auto back_calculation = overshoot(AntiWindup::BackCalculation);
+  printf("overshoot: none %.4f, conditional %.4f, back calculation %.4f\n", none, conditional, back_calculation);
+  assert(conditional < none / 2.0);
+  assert(back_calculation < none / 2.0);
+}
+
+// 2自由度: 目標値の段差で比例・微分が跳ねない
+static void testTwoDof() {
+  constexpr double STEP = 1e-3;
+  PidController<double> pid({.gain = {1.0, 0.0, 0.1}});
+  PidController<double, PidStructure::TwoDof> two_dof(
+      {.gain = {1.0, 0.0, 0.1}, .setpoint_weight_p = 0.0, .setpoint_weight_d = 0.0});
+  pid.update(0.0, 0.0, STEP);
+  two_dof.update(0.0, 0.0, STEP);
+  // 目標値だけが1変わる
+  auto a = pid.update(1.0, 0.0, STEP);
+  auto b = two_dof.update(1.0, 0.0, STEP);
+  assert(near(a, 1.0 + 0.1 / STEP, 1e-9));
+  assert(near(b, 0.0, 1e-12));
+  // 計測値の変化には同じように応じる
+  a = pid.update(1.0, 0.5, STEP);
+  b = two_dof.update(1.0, 0.5, STEP);
+  assert(near(a - 0.5, -0.1 * 0.5 / STEP, 1e-9));
+  assert(near(b + 0.5, -0.1 * 0.5 / STEP, 1e-9));
+}
+
+// ゲインを途中で変えても出力が跳ねない (積分はゲインを掛けた後の値を持つ)
+static void testBumpless() {
+  constexpr double STEP = 1e-3;
+  PidController<double, PidStructure::Pi> controller({.gain = {0.0, 10.0, 0.0}});
+  for (int i = 0; i < 100; i++) controller.update(1.0, 0.0, STEP);
+  auto before = controller.update(1.0, 1.0, STEP);
+  controller.gain({0.0, 100.0, 0.0});
+  auto after = controller.update(1.0, 1.0, STEP);
+  assert(near(before, after, 1e-12));
+}
+
+// ゲインスケジュールは線形補間し、範囲外は端の値
+static void testSchedule() {
+  constexpr double KEYS[] = {0.0, 1.0, 3.0};
+  constexpr double SCALES[] = {1.0, 1.0, 2.0};
+  constexpr GainSchedule<double, 3> schedule(KEYS, {1.0, 10.0, 0.1}, SCALES);
+  static_assert(schedule.at(-1.0).kp < 1.0 + 1e-12 && schedule.at(-1.0).kp > 1.0 - 1e-12);
+  assert(near(schedule.at(0.5).ki, 10.0, 1e-12));
+  assert(near(schedule.at(2.0).kp, 1.5, 1e-12));
+  assert(near(schedule.at(2.0).kd, 0.15, 1e-12));
+  assert(near(schedule.at(5.0).ki, 20.0, 1e-12));
+}
+
+// コンパイル時に計算できる (比例制御の1ステップ目)
+static constexpr float constantStep() {
+  PidController<float> controller({.gain = {2.0f, 0.0f, 0.0f}, .output_min = -1.0f, .output_max = 1.0f});
+  return controller.update(1.0f, 0.75f, 1e-3f);
+}
+static_assert(constantStep() > 0.5f - 1e-6f && constantStep() < 0.5f + 1e-6f);
+// ヒープを使わず、そのままコピーできる
+static_assert(std::is_trivially_copyable_v<PidController<float, PidStructure::TwoDof>>);
+
+int main() {
+  testProportional();
+  testPiCancellation();
+  testDerivativeFilter();
+  testAntiWindup();
+  testTwoDof();
+  testBumpless();
+  testSchedule();
+
+  printf("ok\n");
+  return 0;
+}
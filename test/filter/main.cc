@@ -0,0 +1,101 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+#include "../../main/dri/filter.h"
+#include "data/wall_trace.inc"
+
+// トレースのしきい値とヒステリシス幅
+constexpr int THRESHOLD = 500;
+constexpr int HYSTERESIS = 20;
+
+// 判定が切り替わった回数を数える
+template <typename F>
+int countTransitions(F &&judge) {
+  int transitions = 0;
+  bool prev = false;
+  for (const auto raw : WALL_TRACE) {
+    bool exist = judge(raw);
+    if (exist != prev) transitions++;
+    prev = exist;
+  }
+  return transitions;
+}
+
+int main() {
+  // 中央値フィルタ: 単発のスパイクを除去する
+  {
+    data::MedianFilter<int, 5> median;
+    assert(median.update(100) == 100);
+    assert(median.update(100) == 100);
+    assert(median.update(1000) == 100);
+    assert(median.update(100) == 100);
+    assert(median.update(-1000) == 100);
+  }
+
+  // シュミットトリガ: 不感帯の中では状態を保持する
+  {
+    data::SchmittTrigger<int> trigger(480, 520);
+    assert(!trigger.update(510));
+    assert(trigger.update(521));
+    assert(trigger.update(490));
+    assert(!trigger.update(479));
+  }
+
+  // トレース: 単純比較はばたつくが、フィルタ後は壁あり/なしで1回ずつしか切り替わらない
+  {
+    int raw_transitions = countTransitions([](int raw) { return raw > THRESHOLD; });
+    data::ThresholdDetector<int, 5, 16> detector(THRESHOLD, HYSTERESIS);
+    int filtered_transitions = countTransitions([&](int raw) { return detector.update(raw); });
+    printf("transitions raw: %d, filtered: %d\n", raw_transitions, filtered_transitions);
+    assert(raw_transitions > 2);
+    assert(filtered_transitions == 2);
+  }
+
+  // 確信度: 安定区間では高く、しきい値付近では下がる
+  {
+    data::ThresholdDetector<int, 5, 16> detector(THRESHOLD, HYSTERESIS);
+    float stable = 1.0f, marginal = 1.0f;
+    for (std::size_t i = 0; i < std::size(WALL_TRACE); i++) {
+      detector.update(WALL_TRACE[i]);
+      auto confidence = detector.confidence();
+      assert(0.0f <= confidence && confidence <= 1.0f);
+      if (i >= 320 && i < 400) stable = std::min(stable, confidence);
+      if (i >= 195 && i < 215) marginal = std::min(marginal, confidence);
+    }
+    printf("confidence stable: %f, marginal: %f\n", static_cast<double>(stable), static_cast<double>(marginal));
+    assert(stable > 0.8f);
+    assert(marginal < stable);
+  }
+
+  // 直線近似: 温度の範囲が狭くても、IMUのキャリブレーションと同じ1万サンプルで傾きを求められる
+  {
+    constexpr int n = 10'000;
+    constexpr float slope = 3.0f;
+    for (const float span : {1.0f, 0.5f}) {
+      data::LinearRegression<float> fit;
+      float sum_t = 0.0f, sum_t_2 = 0.0f, sum_ty = 0.0f, sum_y = 0.0f;
+      for (int i = 0; i < n; i++) {
+        // 温度センサの分解能 (1/256 degC) で量子化した、ゆっくり上がる温度
+        const float t = std::round((25.0f + span * static_cast<float>(i) / n) * 256.0f) / 256.0f;
+        const float y = slope * (t - 25.0f) + 150.0f + static_cast<float>(i % 7 - 3) * 0.5f;
+        fit.update(t, y);
+        sum_t += t;
+        sum_t_2 += t * t;
+        sum_ty += t * y;
+        sum_y += y;
+      }
+      // 平均回りで積算しない従来の式
+      const float count = static_cast<float>(n);
+      const float naive = (count * sum_ty - sum_t * sum_y) / (count * sum_t_2 - sum_t * sum_t);
+      printf("regression over %.1f degC: slope %f (naive %f)\n", static_cast<double>(span),
+             static_cast<double>(fit.slope()), static_cast<double>(naive));
+      assert(std::fabs(fit.slope() - slope) < 0.05f);
+      assert(std::fabs(fit.mean_y() - (slope * (fit.mean_x() - 25.0f) + 150.0f)) < 0.01f);
+    }
+  }
+
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+#include "../../main/dri/imu_fifo.h"
+#include "data/fifo_capture.inc"
+
+int main() {
+  ImuFifo fifo;
+  std::vector<ImuFifo::Sample> samples;
+
+  auto read = [&](const uint8_t *data, std::size_t length) {
+    auto n = fifo.parse(data, length);
+    for (const auto &sample : fifo.samples()) samples.push_back(sample);
+    return n;
+  };
+
+  // 読み出し毎に確定するサンプル数 (途切れたバッチは次の読み出しで確定する)
+  assert(read(FIFO_READ0, sizeof(FIFO_READ0)) == 2);
+  assert(read(FIFO_READ1, sizeof(FIFO_READ1)) == 2);
+  assert(read(FIFO_READ2, sizeof(FIFO_READ2)) == 4);
+  // 途中に挟まった温度ワード (+2degC)
+  assert(fifo.temperature() == 512);
+  // 空読み出しでは前回の結果が残らない
+  assert(read(FIFO_READ0, 0) == 0);
+  assert(fifo.samples().empty());
+
+  assert(samples.size() == 8);
+  for (std::size_t i = 0; i < samples.size(); i++) {
+    const auto &sample = samples[i];
+    printf("%lld: gyro(%d, %d, %d) accel(%d, %d, %d)\n", static_cast<long long>(sample.timestamp), sample.gyro[0],
+           sample.gyro[1], sample.gyro[2], sample.accel[0], sample.accel[1], sample.accel[2]);
+    // タイムスタンプは25us/LSB、1.667kHzで600us間隔
+    assert(sample.timestamp == 25'000 + static_cast<int64_t>(i) * 600);
+    // GYRO/ACCELの順序によらず同じバッチに入る
+    assert(sample.gyro[0] == static_cast<int16_t>(i * 10));
+    assert(sample.gyro[1] == -static_cast<int16_t>(i * 10));
+    assert(sample.gyro[2] == static_cast<int16_t>(100 + i));
+    assert(sample.accel[1] == -740);
+    assert(sample.accel[2] == static_cast<int16_t>(16400 + i));
+  }
+
+  // 容量を超えた分は捨てて数える
+  {
+    ImuFifo small;
+    std::vector<uint8_t> stream;
+    for (std::size_t i = 0; i < ImuFifo::MAX_SAMPLES + 3; i++) {
+      const uint8_t words[3][ImuFifo::WORD_SIZE] = {
+          {ImuFifo::TAG_TIMESTAMP << 3, static_cast<uint8_t>(i), 0, 0, 0, 0, 0},
+          {ImuFifo::TAG_GYRO << 3, 0, 0, 0, 0, 0, 0},
+          {ImuFifo::TAG_ACCEL << 3, 0, 0, 0, 0, 0, 0},
+      };
+      for (const auto &word : words) stream.insert(stream.end(), word, word + ImuFifo::WORD_SIZE);
+    }
+    assert(small.parse(stream.data(), stream.size()) == ImuFifo::MAX_SAMPLES);
+    assert(small.dropped() == 3);
+  }
+
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,440 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <vector>
+
+#include "../../main/dri/spsc_queue.h"
+#include "../../main/motion_generator.h"
+#include "../../main/parameters.h"
+#include "../../main/pid.h"
+#include "../../main/slalom.h"
+#include "../../main/trajectory.h"
+
+// 制御周期 [s]
+static constexpr float DT = 1.0f / static_cast<float>(CONTROL_FREQUENCY);
+
+static bool near(float a, float b, float tolerance) { return std::abs(a - b) <= tolerance; }
+
+// プロファイルを周期ごとに積分した距離と、解析的な距離が一致する
+static void testTrajectory(float distance, float start, float max, float end, float acceleration, float jerk = 0.0f) {
+  Trajectory trajectory;
+  trajectory.reset(distance, start, max, end, acceleration, jerk);
+
+  float position = 0.0f;
+  float peak = 0.0f;
+  auto prev = trajectory.state(0.0f);
+  float prev_time = 0.0f;
+  for (int i = 1; prev_time < trajectory.duration(); i++) {
+    auto time = std::min(static_cast<float>(i) * DT, trajectory.duration());
+    auto state = trajectory.state(time);
+    // 台形近似で積分
+    position += (state.velocity + prev.velocity) * (time - prev_time) / 2.0f;
+    prev_time = time;
+    peak = std::max(peak, state.velocity);
+    // 速度・加速度・躍度は制限を超えない
+    assert(state.velocity <= std::max(max, start) + 1e-4f);
+    assert(std::abs(state.velocity - prev.velocity) <= acceleration * DT + 1e-4f);
+    assert(std::abs(state.acceleration) <= acceleration + 1e-3f);
+    if (jerk > 0.0f) {
+      assert(std::abs(state.acceleration - prev.acceleration) <= jerk * DT + 1e-3f);
+    }
+    prev = state;
+  }
+  auto last = trajectory.state(trajectory.duration());
+  // 終わる直前の値が終端の値とつながる
+  auto before = trajectory.state(trajectory.duration() - 1e-6f);
+  printf("trajectory: d %g v0 %g vmax %g ve %g j %g -> T %g, peak %g, end %g, integrated %g, gap %g\n",
+         static_cast<double>(distance), static_cast<double>(start), static_cast<double>(max),
+         static_cast<double>(end), static_cast<double>(jerk), static_cast<double>(trajectory.duration()),
+         static_cast<double>(peak), static_cast<double>(trajectory.end_velocity()), static_cast<double>(position),
+         static_cast<double>(last.position - before.position));
+  assert(near(last.position, distance, 1e-6f));
+  assert(near(last.velocity, trajectory.end_velocity(), 1e-6f));
+  assert(near(before.position, distance, 1e-5f));
+  assert(near(before.velocity, last.velocity, 1e-3f));
+  assert(near(position, distance, distance * 1e-3f + 1e-5f));
+}
+
+// 1周期あたりの計算時間
+static void benchmarkTrajectory() {
+  constexpr int REPEAT = 1000;
+  Trajectory trajectory;
+  volatile float sink = 0.0f;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REPEAT; i++) {
+    trajectory.reset(0.18f + static_cast<float>(i) * 1e-5f, 0.0f, 1.0f, 0.0f, ACCELERATION_DEFAULT * 5.0f,
+                     JERK_DEFAULT);
+    sink = trajectory.duration();
+  }
+  auto reset_ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count() / REPEAT;
+
+  int ticks = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < REPEAT; i++) {
+    for (float time = 0.0f; time < trajectory.duration(); time += DT) {
+      sink = trajectory.state(time).velocity;
+      ticks++;
+    }
+  }
+  auto state_ns = std::chrono::duration<float, std::nano>(std::chrono::steady_clock::now() - start).count() / ticks;
+  (void)sink;
+  printf("trajectory: reset %g ns, state %g ns/tick\n", static_cast<double>(reset_ns), static_cast<double>(state_ns));
+}
+
+// 指令の順に目標値が作られ、直進の終端速度が次の直進に引き継がれる
+static void testGenerator() {
+  MotionGenerator generator;
+  assert(generator.finished());
+  assert(generator.target().pattern == MotionPattern::Idle);
+
+  MotionParameter straight{};
+  straight.pattern = MotionPattern::Straight;
+  straight.direction = MotionDirection::Forward;
+  straight.distance = 0.09f;
+  straight.max_velocity = 0.5f;
+  straight.acceleration = 2.0f;
+  straight.end_velocity = 0.3f;
+  generator.start(straight);
+  assert(!generator.continued());
+  int ticks = 0;
+  while (!generator.update(DT)) ticks++;
+  assert(near(generator.target().length, 0.09f, 1e-6f));
+  assert(near(generator.target().velocity, 0.3f, 1e-6f));
+
+  // 0.3 m/sから始めて止まる (前の直進から続く)
+  straight.end_velocity = 0.0f;
+  generator.start(straight);
+  assert(generator.continued());
+  assert(near(generator.target().velocity, 0.3f, 1e-6f));
+  while (!generator.update(DT)) ticks++;
+  assert(near(generator.target().velocity, 0.0f, 1e-6f));
+
+  // 右旋回は角速度が負
+  MotionParameter turn{};
+  turn.pattern = MotionPattern::Turn;
+  turn.direction = MotionDirection::Right;
+  turn.distance = std::numbers::pi_v<float> / 2.0f;
+  turn.max_angular_velocity = ANGULAR_VELOCITY_DEFAULT;
+  turn.angular_acceleration = ANGULAR_ACCELERATION_DEFAULT;
+  generator.start(turn);
+  assert(!generator.continued());
+  float min_angular_velocity = 0.0f;
+  while (!generator.update(DT)) {
+    min_angular_velocity = std::min(min_angular_velocity, generator.target().angular_velocity);
+  }
+  assert(near(min_angular_velocity, -ANGULAR_VELOCITY_DEFAULT, 1e-4f));
+  assert(near(generator.target().angle, -std::numbers::pi_v<float> / 2.0f, 1e-6f));
+  assert(near(generator.target().velocity, 0.0f, 1e-6f));
+
+  // 停止・解放はすぐに終わる
+  MotionParameter stop{};
+  stop.pattern = MotionPattern::Stop;
+  generator.start(stop);
+  assert(generator.finished());
+  assert(!generator.update(DT));
+  assert(generator.target().pattern == MotionPattern::Stop);
+
+  // 前壁合わせは目標値0のまま、外から終えるか時間で打ち切る
+  MotionParameter align{};
+  align.pattern = MotionPattern::FrontAlign;
+  align.timeout = 0.1f;
+  generator.start(align);
+  assert(!generator.finished());
+  for (int i = 0; i < 50; i++) assert(!generator.update(DT));
+  assert(near(generator.target().velocity, 0.0f, 1e-6f));
+  assert(generator.finish());
+  assert(generator.finished() && !generator.finish());
+  generator.start(align);
+  int align_ticks = 1;
+  while (!generator.update(DT)) align_ticks++;
+  assert(align_ticks >= 99 && align_ticks <= 101);
+  assert(!generator.finish());
+  printf("generator: ok (%d ticks)\n", ticks);
+}
+
+// 一次遅れのモーターモデルに対して、PIDで目標速度に追従できる
+static void testClosedLoop() {
+  // 電圧から定常速度へのゲイン [m/s/V] と時定数 [s] (モーターの定格から見積もった値)
+  constexpr float PLANT_GAIN = 1.3f;
+  constexpr float PLANT_TIME_CONSTANT = 0.02f;
+  // 車体の角速度は左右の速度差から決まる
+  constexpr float TREAD = TREAD_WIDTH / 1000.0f;
+
+  MotionGenerator generator;
+  Pid velocity_pid(VELOCITY_PID_GAIN[PARAMETER_PID_KP], VELOCITY_PID_GAIN[PARAMETER_PID_KI],
+                   VELOCITY_PID_GAIN[PARAMETER_PID_KD]);
+  Pid angular_velocity_pid(ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KP], ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KI],
+                           ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KD]);
+  float right = 0.0f, left = 0.0f;
+  float length = 0.0f, angle = 0.0f;
+  float max_error = 0.0f, max_angular_error = 0.0f;
+
+  auto run = [&](const MotionParameter &parameter) {
+    generator.start(parameter);
+    do {
+      const auto &target = generator.target();
+      auto velocity = (right + left) / 2.0f;
+      auto angular_velocity = (right - left) / TREAD;
+      max_error = std::max(max_error, std::abs(target.velocity - velocity));
+      max_angular_error = std::max(max_angular_error, std::abs(target.angular_velocity - angular_velocity));
+
+      auto v = velocity_pid.update(target.velocity, velocity, DT);
+      auto w = angular_velocity_pid.update(target.angular_velocity, angular_velocity, DT);
+      auto right_voltage = std::clamp(v + w, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+      auto left_voltage = std::clamp(v - w, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+      right += (PLANT_GAIN * right_voltage - right) * DT / PLANT_TIME_CONSTANT;
+      left += (PLANT_GAIN * left_voltage - left) * DT / PLANT_TIME_CONSTANT;
+      length += (right + left) / 2.0f * DT;
+      angle += (right - left) / TREAD * DT;
+      generator.update(DT);
+    } while (!generator.finished());
+  };
+
+  MotionParameter straight{};
+  straight.pattern = MotionPattern::Straight;
+  straight.direction = MotionDirection::Forward;
+  straight.distance = 0.18f;
+  straight.max_velocity = VELOCITY_DEFAULT;
+  straight.acceleration = ACCELERATION_DEFAULT;
+  straight.jerk = JERK_DEFAULT;
+  run(straight);
+  MotionParameter turn{};
+  turn.pattern = MotionPattern::Turn;
+  turn.direction = MotionDirection::Left;
+  turn.distance = std::numbers::pi_v<float> / 2.0f;
+  turn.max_angular_velocity = ANGULAR_VELOCITY_DEFAULT;
+  turn.angular_acceleration = ANGULAR_ACCELERATION_DEFAULT;
+  turn.angular_jerk = ANGULAR_JERK_DEFAULT;
+  run(turn);
+  // 止まるまで速度0を保つ (Stopは1周期で終わる)
+  MotionParameter stop{};
+  stop.pattern = MotionPattern::Stop;
+  for (int i = 0; i < 200; i++) run(stop);
+
+  printf("closed loop: length %g m, angle %g rad, max error %g m/s, %g rad/s\n", static_cast<double>(length),
+         static_cast<double>(angle), static_cast<double>(max_error), static_cast<double>(max_angular_error));
+  assert(near(length, 0.18f, 0.01f));
+  assert(near(angle, std::numbers::pi_v<float> / 2.0f, 0.1f));
+  assert(max_error < 0.1f);
+  assert(max_angular_error < 1.5f);
+  assert(std::abs(right) < 0.01f && std::abs(left) < 0.01f);
+}
+
+// スラロームのテーブルを再生すると、区画の辺の中央から区画の辺の中央へ移る
+static void testSlalom() {
+  constexpr float SECTION = MAZE_SECTION_SIZE;
+  constexpr float DIAGONAL = MAZE_SECTION_SIZE / 2.0f * std::numbers::sqrt2_v<float>;
+  // 開始時と終了時の進行方向の直線が交わる点までの距離と、そこから終了位置までの距離 [mm]
+  constexpr float CORNERS[slalom::NUM_TYPES][2] = {
+      {SECTION / 2.0f, SECTION / 2.0f},  // TURN_90
+      {SECTION, SECTION},                // TURN_LARGE_90
+      {0.0f, 0.0f},                      // TURN_180
+      {SECTION, DIAGONAL},               // TURN_45_IN
+      {DIAGONAL, SECTION},               // TURN_45_OUT
+      {SECTION, DIAGONAL},               // TURN_135_IN
+      {DIAGONAL, SECTION},               // TURN_135_OUT
+      {DIAGONAL, DIAGONAL},              // TURN_V90
+  };
+
+  int count = 0;
+  for (std::size_t type = 0; type < slalom::NUM_TYPES; type++) {
+    for (const auto &table : slalom::TABLES[type]) {
+      if (table.angular_velocity == nullptr) continue;
+      // 右ターン: 向きは+yから時計回り
+      float expected_x, expected_y;
+      if (type == slalom::TURN_180) {
+        expected_x = SECTION;
+        expected_y = 0.0f;
+      } else {
+        expected_x = CORNERS[type][1] * std::sin(table.angle);
+        expected_y = CORNERS[type][0] + CORNERS[type][1] * std::cos(table.angle);
+      }
+
+      MotionGenerator generator;
+      MotionParameter parameter{};
+      parameter.pattern = MotionPattern::Slalom;
+      parameter.direction = MotionDirection::Right;
+      parameter.slalom = &table;
+      generator.start(parameter);
+      float x = 0.0f, y = table.before, heading = 0.0f;
+      float max_angular_velocity = 0.0f;
+      int ticks = 0;
+      do {
+        const auto &target = generator.target();
+        assert(near(target.velocity, table.velocity, 1e-6f));
+        // 右ターンは角速度が負
+        auto angular_velocity = -target.angular_velocity;
+        max_angular_velocity = std::max(max_angular_velocity, angular_velocity);
+        auto mid = heading + angular_velocity * DT / 2.0f;
+        x += target.velocity * 1000.0f * DT * std::sin(mid);
+        y += target.velocity * 1000.0f * DT * std::cos(mid);
+        heading += angular_velocity * DT;
+        ticks++;
+      } while (!generator.update(DT));
+      assert(static_cast<std::size_t>(ticks) == table.size);
+      assert(near(-generator.target().angle, table.angle, 1e-3f));
+      assert(near(generator.target().angular_velocity, 0.0f, 1e-6f));
+      x += table.after * std::sin(heading);
+      y += table.after * std::cos(heading);
+      printf("slalom %zu at %g m/s: end (%g, %g) expected (%g, %g), heading %g, max %g rad/s\n", type,
+             static_cast<double>(table.velocity), static_cast<double>(x), static_cast<double>(y),
+             static_cast<double>(expected_x), static_cast<double>(expected_y), static_cast<double>(heading),
+             static_cast<double>(max_angular_velocity));
+      assert(near(heading, table.angle, 1e-3f));
+      assert(near(x, expected_x, 1.0f) && near(y, expected_y, 1.0f));
+      // 遠心加速度は上限を超えない
+      assert(table.velocity * max_angular_velocity <= SLALOM_LATERAL_ACCELERATION_LIMIT + 1e-3f);
+      count++;
+    }
+  }
+  // 見つからない速度はより遅いテーブルで代用する
+  assert(slalom::find(slalom::TURN_LARGE_90, 0.6f) == &slalom::TABLES[slalom::TURN_LARGE_90][1]);
+  assert(slalom::find(slalom::TURN_90, 0.1f) == nullptr);
+  assert(count > 0);
+}
+
+// 直進の指令
+static MotionParameter straightParameter(float distance, float max_velocity, float end_velocity,
+                                         MotionDirection direction = MotionDirection::Forward) {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Straight;
+  param.direction = direction;
+  param.distance = distance;
+  param.max_velocity = max_velocity;
+  param.acceleration = 5.0f;
+  param.jerk = JERK_DEFAULT;
+  param.end_velocity = end_velocity;
+  return param;
+}
+
+/**
+ * キューに積んだ指令をMotion::update()と同じ順で実行し、速度の変化を調べる
+ * @param late 実行中に後から積む指令 (先に積んだ指令を始めてからdelay周期後)
+ * @return 指令の境目 (最後の指令を除く) の最低速度
+ */
+static float runQueue(const std::vector<MotionParameter> &commands, const std::vector<MotionParameter> &late = {},
+                      int delay = 0) {
+  data::SpscQueue<MotionParameter, 8> queue;
+  for (const auto &command : commands) assert(queue.send(&command));
+  MotionGenerator generator;
+  auto total = commands.size() + late.size();
+  std::size_t completed = 0;
+  float lowest = 1e3f, previous = 0.0f, previous_acceleration = 0.0f;
+  for (int tick = 0; completed < total; tick++) {
+    assert(tick < 100000);
+    if (tick == delay) {
+      for (const auto &command : late) assert(queue.send(&command));
+    }
+    auto boundary = false;
+    if (generator.finished()) {
+      if (generator.next(queue) && generator.finished()) completed++;
+    } else {
+      generator.lookahead(queue);
+      boundary = generator.update(DT);
+      if (boundary) completed++;
+    }
+    const auto &target = generator.target();
+    // 速度は連続で、加速度の上限を超えて変わらない
+    assert(std::abs(target.velocity - previous) <= 5.0f * DT + 1e-3f);
+    // 加速度も躍度の上限を超えて変わらない
+    assert(std::abs(target.acceleration - previous_acceleration) <= JERK_DEFAULT * DT + 1e-3f);
+    previous = target.velocity;
+    previous_acceleration = target.acceleration;
+    if (boundary && completed < total) lowest = std::min(lowest, std::abs(target.velocity));
+  }
+  // 最後は止まる
+  assert(near(generator.target().velocity, 0.0f, 1e-3f));
+  return lowest;
+}
+
+// 先読みで直進・スラロームをつなぐ
+static void testLookahead() {
+  // 終端速度0の直進が3つ続いても止まらない
+  auto lowest = runQueue({straightParameter(0.18f, 1.0f, 0.0f), straightParameter(0.09f, 1.0f, 0.0f),
+                          straightParameter(0.18f, 1.0f, 0.0f)});
+  printf("lookahead straight x3: lowest %.3f m/s\n", static_cast<double>(lowest));
+  assert(lowest > 0.3f);
+
+  // 直進・スラローム・直進はテーブルの速度でつながる
+  MotionParameter slalom{};
+  slalom.pattern = MotionPattern::Slalom;
+  slalom.direction = MotionDirection::Right;
+  slalom.slalom = slalom::find(slalom::TURN_LARGE_90, 0.5f);
+  assert(slalom.slalom != nullptr);
+  lowest = runQueue({straightParameter(0.18f, 1.0f, 0.0f), slalom, straightParameter(0.18f, 1.0f, 0.0f)});
+  printf("lookahead slalom: lowest %.3f m/s\n", static_cast<double>(lowest));
+  assert(near(lowest, slalom.slalom->velocity, 1e-3f));
+
+  // 先読みできる数より多く続いても止まらない
+  std::vector<MotionParameter> many(7, straightParameter(0.09f, 0.5f, 0.0f));
+  lowest = runQueue(many);
+  assert(lowest > 0.3f);
+
+  // 直進の途中で届いた指令にもつながる
+  lowest = runQueue({straightParameter(0.36f, 0.5f, 0.0f)}, {straightParameter(0.18f, 0.5f, 0.0f)}, 300);
+  printf("lookahead late: lowest %.3f m/s\n", static_cast<double>(lowest));
+  assert(lowest > 0.3f);
+  // 減速中に届いた指令では計算し直さない (加速度が跳ぶ)
+  lowest = runQueue({straightParameter(0.18f, 0.5f, 0.0f)}, {straightParameter(0.18f, 0.5f, 0.0f)}, 380);
+  printf("lookahead decelerating: lowest %.3f m/s\n", static_cast<double>(lowest));
+
+  // 向きが変わる指令の前では止まる
+  lowest = runQueue(
+      {straightParameter(0.09f, 0.5f, 0.0f), straightParameter(0.09f, 0.5f, 0.0f, MotionDirection::Backward)});
+  assert(near(lowest, 0.0f, 1e-3f));
+
+  // 短い直線の後の減速に間に合う速度で終わる
+  bool open = false;
+  auto first = straightParameter(0.18f, 2.0f, 0.0f);
+  auto second = straightParameter(0.01f, 2.0f, 0.0f);
+  auto end_velocity = MotionGenerator::blend(first, &second, 1, open);
+  assert(open);
+  assert(near(Trajectory::ramp_distance(end_velocity, 0.0f, second.acceleration, second.jerk), second.distance, 1e-4f));
+}
+
+int main() {
+  // 台形
+  testTrajectory(0.18f, 0.0f, 0.5f, 0.0f, 2.0f);
+  // 三角形
+  testTrajectory(0.045f, 0.0f, 2.0f, 0.0f, 2.0f);
+  // 開始・終端速度あり
+  testTrajectory(0.09f, 0.3f, 0.5f, 0.3f, 2.0f);
+  // 終端速度まで減速しきれない
+  testTrajectory(0.01f, 0.5f, 0.5f, 0.0f, 2.0f);
+  // 終端速度まで加速しきれない
+  testTrajectory(0.01f, 0.0f, 1.0f, 1.0f, 2.0f);
+  // 距離0
+  testTrajectory(0.0f, 0.0f, 0.5f, 0.0f, 2.0f);
+  // 終端速度が最大速度を超える
+  testTrajectory(0.18f, 0.0f, 0.3f, 0.5f, 2.0f);
+
+  // S字: 最大加速度に届く
+  testTrajectory(0.18f, 0.0f, 0.5f, 0.0f, 2.0f, 100.0f);
+  // S字: 最大加速度に届かない
+  testTrajectory(0.18f, 0.0f, 0.5f, 0.0f, 10.0f, 100.0f);
+  // S字: 最高速度に届かない
+  testTrajectory(0.045f, 0.0f, 2.0f, 0.0f, 5.0f, 100.0f);
+  // S字: 開始・終端速度あり
+  testTrajectory(0.09f, 0.3f, 1.0f, 0.5f, 5.0f, 100.0f);
+  // S字: 終端速度まで減速しきれない
+  testTrajectory(0.01f, 0.5f, 0.5f, 0.0f, 2.0f, 100.0f);
+  // S字: 終端速度まで加速しきれない
+  testTrajectory(0.01f, 0.0f, 1.0f, 1.0f, 2.0f, 100.0f);
+  // S字: 終端速度が最大速度を超える
+  testTrajectory(0.18f, 0.0f, 0.3f, 0.5f, 2.0f, 100.0f);
+  // S字: 長い直線
+  testTrajectory(2.7f, 0.0f, 3.0f, 0.0f, 10.0f, 200.0f);
+  benchmarkTrajectory();
+
+  testGenerator();
+  testSlalom();
+  testLookahead();
+  testClosedLoop();
+
+  printf("ok\n");
+  return 0;
+}
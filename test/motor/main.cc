@@ -0,0 +1,230 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../../main/dri/average.h"
+#include "../../main/feedforward.h"
+#include "../../main/motion_generator.h"
+#include "../../main/parameters.h"
+#include "../../main/pid.h"
+#include "../../main/slalom.h"
+
+// 制御周期 [s]
+static constexpr float DT = 1.0f / static_cast<float>(CONTROL_FREQUENCY);
+// トレッド [m]
+static constexpr float TREAD = TREAD_WIDTH / 1000.0f;
+
+/**
+ * 左右のモーター・バッテリーを含む車体のシミュレーション
+ * @details
+ * モーターは1次遅れ (並進と旋回で時定数が違う) で、回っている向きと逆に摩擦がかかる。
+ * 巻線抵抗に流れる電流でバッテリー電圧が下がり、デューティ比が同じでもモーター電圧が下がる。
+ */
+struct Plant {
+  // タイヤの速度あたりの逆起電圧 [V/(m/s)]
+  float velocity_constant;
+  // 並進・旋回の時定数 [s]
+  float time_constant, angular_time_constant;
+  // 摩擦電圧 [V]
+  float friction;
+  // 開放電圧 [V]・内部抵抗 [ohm]・巻線抵抗 [ohm]
+  float open_voltage, internal_resistance, winding_resistance;
+
+  // 左右の速度 [m/s]
+  float right = 0.0f, left = 0.0f;
+  // バッテリー電圧 [V]
+  float battery = 0.0f;
+
+  // 摩擦を引いた電圧
+  [[nodiscard]] float effective(float voltage, float velocity) const {
+    if (velocity > 0.0f) return voltage - friction;
+    if (velocity < 0.0f) return voltage + friction;
+    // 止まっている間は摩擦を超えるまで動かない
+    return std::abs(voltage) <= friction ? 0.0f : voltage - std::copysign(friction, voltage);
+  }
+
+  // デューティ比 (-1~1) を与えて1周期進める
+  void update(float right_duty, float left_duty) {
+    // 電流からバッテリー電圧の降下を求める (前の周期の電圧で近似する)
+    auto right_voltage = right_duty * battery;
+    auto left_voltage = left_duty * battery;
+    auto right_current = (right_voltage - velocity_constant * right) / winding_resistance;
+    auto left_current = (left_voltage - velocity_constant * left) / winding_resistance;
+    auto current = std::abs(right_duty * right_current) + std::abs(left_duty * left_current);
+    battery = open_voltage - internal_resistance * current;
+
+    // 並進と旋回に分けて1次遅れで進める
+    auto right_effective = effective(right_voltage, right) / velocity_constant;
+    auto left_effective = effective(left_voltage, left) / velocity_constant;
+    auto velocity = (right + left) / 2.0f;
+    auto difference = (right - left) / 2.0f;
+    velocity += ((right_effective + left_effective) / 2.0f - velocity) * DT / time_constant;
+    difference += ((right_effective - left_effective) / 2.0f - difference) * DT / angular_time_constant;
+    right = velocity + difference;
+    left = velocity - difference;
+  }
+};
+
+// デューティ比に換算するときのバッテリー電圧
+enum class Reference {
+  // 開放電圧の固定値 (電圧降下を補わない)
+  Fixed,
+  // 瞬時値
+  Instant,
+  // 移動平均
+  Average,
+};
+
+// 追従誤差
+struct Tracking {
+  float rms, max, angular_rms, angular_max;
+};
+
+/**
+ * Motion::update()と同じ手順で指令を実行し、目標速度への追従誤差を求める
+ * @param feedforward フィードフォワードを使うか
+ * @param reference デューティ比に換算するときのバッテリー電圧
+ */
+static Tracking track(Plant plant, const std::vector<MotionParameter> &commands, bool feedforward, Reference reference,
+                      const Feedforward &model = Feedforward()) {
+  std::mt19937 random(1);
+  std::normal_distribution<float> noise(0.0f, 0.005f);
+  MotionGenerator generator;
+  Pid velocity_pid(VELOCITY_PID_GAIN[PARAMETER_PID_KP], VELOCITY_PID_GAIN[PARAMETER_PID_KI],
+                   VELOCITY_PID_GAIN[PARAMETER_PID_KD]);
+  Pid angular_velocity_pid(ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KP], ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KI],
+                           ANGULAR_VELOCITY_PID_GAIN[PARAMETER_PID_KD]);
+  data::MovingAverage<int, int, 512> battery;
+  plant.battery = plant.open_voltage;
+
+  double sum = 0.0, angular_sum = 0.0;
+  float max = 0.0f, angular_max = 0.0f;
+  int ticks = 0;
+  for (const auto &command : commands) {
+    generator.start(command);
+    do {
+      const auto &target = generator.target();
+      auto velocity = (plant.right + plant.left) / 2.0f;
+      auto angular_velocity = (plant.right - plant.left) / TREAD;
+      auto error = target.velocity - velocity;
+      auto angular_error = target.angular_velocity - angular_velocity;
+      sum += static_cast<double>(error * error);
+      angular_sum += static_cast<double>(angular_error * angular_error);
+      max = std::max(max, std::abs(error));
+      angular_max = std::max(angular_max, std::abs(angular_error));
+      ticks++;
+
+      Feedforward::Voltage voltage{0.0f, 0.0f};
+      if (feedforward) {
+        voltage = model.update(target.velocity, target.acceleration, target.angular_velocity,
+                               target.angular_acceleration);
+      }
+      auto v = velocity_pid.update(target.velocity, velocity + noise(random), DT);
+      auto w = angular_velocity_pid.update(target.angular_velocity, angular_velocity + noise(random) * 10.0f, DT);
+      auto right = std::clamp(voltage.right + v + w, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+      auto left = std::clamp(voltage.left + v - w, -VOLTAGE_MOTOR_LIMIT, VOLTAGE_MOTOR_LIMIT);
+      // Motor::speed()と同じくmV単位でデューティ比に換算する
+      auto measured = battery.update(static_cast<int>(plant.battery * 1000.0f));
+      auto battery_voltage = reference == Reference::Average   ? static_cast<float>(measured) / 1000.0f
+                             : reference == Reference::Instant ? plant.battery
+                                                               : plant.open_voltage;
+      plant.update(std::clamp(right / battery_voltage, -1.0f, 1.0f), std::clamp(left / battery_voltage, -1.0f, 1.0f));
+      generator.update(DT);
+    } while (!generator.finished());
+  }
+  return {static_cast<float>(std::sqrt(sum / ticks)), max, static_cast<float>(std::sqrt(angular_sum / ticks)),
+          angular_max};
+}
+
+static MotionParameter straight(float distance, float max_velocity, float acceleration, float end_velocity = 0.0f) {
+  MotionParameter param{};
+  param.pattern = MotionPattern::Straight;
+  param.direction = MotionDirection::Forward;
+  param.distance = distance;
+  param.max_velocity = max_velocity;
+  param.acceleration = acceleration;
+  param.jerk = JERK_DEFAULT * 2.0f;
+  param.end_velocity = end_velocity;
+  return param;
+}
+
+// モデルと同じ特性のモーター
+static Plant nominal() {
+  return {Feedforward::VELOCITY_CONSTANT, MOTOR_TIME_CONSTANT, MOTOR_ANGULAR_TIME_CONSTANT, MOTOR_FRICTION_VOLTAGE,
+          4.1f, 0.0f, 3.0f};
+}
+
+// モデルが正しければ、フィードフォワードだけで (PIDなしでも) 目標に沿って動く
+static void testInverse() {
+  Feedforward model;
+  auto plant = nominal();
+  auto generator = MotionGenerator();
+  generator.start(straight(0.9f, 2.0f, 8.0f));
+  float max = 0.0f;
+  do {
+    const auto &target = generator.target();
+    max = std::max(max, std::abs(target.velocity - (plant.right + plant.left) / 2.0f));
+    auto voltage = model.update(target.velocity, target.acceleration, target.angular_velocity,
+                                target.angular_acceleration);
+    plant.update(voltage.right / plant.open_voltage, voltage.left / plant.open_voltage);
+    generator.update(DT);
+  } while (!generator.finished());
+  printf("inverse: max error %.4f m/s\n", static_cast<double>(max));
+  // 離散化の誤差 (1周期分の加速) 程度
+  assert(max < 8.0f * DT * 2.0f);
+}
+
+// 高速の直進とスラロームで、PIDだけの場合より追従誤差が小さくなる
+static void testTracking() {
+  // 実機はモデルと少しずれ、バッテリー電圧も下がる
+  auto plant = nominal();
+  plant.velocity_constant *= 1.05f;
+  plant.time_constant *= 1.15f;
+  plant.angular_time_constant *= 0.85f;
+  plant.friction *= 1.3f;
+  plant.internal_resistance = 0.3f;
+
+  MotionParameter slalom{};
+  slalom.pattern = MotionPattern::Slalom;
+  slalom.direction = MotionDirection::Left;
+  slalom.slalom = slalom::find(slalom::TURN_LARGE_90, 0.5f);
+  assert(slalom.slalom != nullptr);
+  auto velocity = slalom.slalom->velocity;
+  std::vector<MotionParameter> commands = {
+      straight(1.8f, 3.0f, 8.0f, velocity), slalom, straight(0.09f, velocity, 8.0f, velocity), slalom,
+      straight(0.9f, 2.0f, 8.0f),
+  };
+  MotionParameter stop{};
+  stop.pattern = MotionPattern::Stop;
+  commands.insert(commands.end(), 100, stop);
+
+  // これまでの制御 (PIDだけ、瞬時値で換算) と比べる
+  auto pid = track(plant, commands, false, Reference::Instant);
+  auto combined = track(plant, commands, true, Reference::Average);
+  printf("pid only   : rms %.4f m/s, max %.4f m/s, rms %.3f rad/s, max %.3f rad/s\n", static_cast<double>(pid.rms),
+         static_cast<double>(pid.max), static_cast<double>(pid.angular_rms), static_cast<double>(pid.angular_max));
+  printf("feedforward: rms %.4f m/s, max %.4f m/s, rms %.3f rad/s, max %.3f rad/s\n",
+         static_cast<double>(combined.rms), static_cast<double>(combined.max),
+         static_cast<double>(combined.angular_rms), static_cast<double>(combined.angular_max));
+  assert(combined.rms < pid.rms * 0.5f);
+  assert(combined.max < pid.max * 0.5f);
+  assert(combined.angular_rms < pid.angular_rms * 0.7f);
+
+  // バッテリー電圧の降下を補わない場合より誤差が小さい
+  auto uncompensated = track(plant, commands, true, Reference::Fixed);
+  printf("no sag comp: rms %.4f m/s, max %.4f m/s\n", static_cast<double>(uncompensated.rms),
+         static_cast<double>(uncompensated.max));
+  assert(combined.rms <= uncompensated.rms);
+}
+
+int main() {
+  testInverse();
+  testTracking();
+
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,621 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "../../main/dri/encoder_counter.h"
+#include "../../main/dri/histogram.h"
+#include "../../main/fastmath.h"
+#include "../../main/fusion.h"
+#include "../../main/gyro_bias.h"
+#include "../../main/gyro_integrator.h"
+#include "../../main/parameters.h"
+#include "../../main/pose.h"
+#include "../../main/pose_correction.h"
+#include "../../main/velocity_observer.h"
+#include "../../main/wheel.h"
+
+/**
+ * ジャイロのバイアス推定
+ * 3秒走行・1.5秒停止を5分間繰り返す間にバイアスが線形にドリフトする。
+ * 停止毎に推定値が追従し、角度のずれが補正なしより十分小さいことを確認する。
+ */
+static void testGyroBias() {
+  std::mt19937 rng(28);
+  std::normal_distribution<float> gyro_noise(0.0f, 0.01f);
+  std::normal_distribution<float> accel_noise(0.0f, 2.0f);
+  std::normal_distribution<float> shake(0.0f, 50.0f);
+
+  constexpr float dt = 0.001f;
+  constexpr int steps = 300'000;
+  GyroBias estimator;
+  float error_raw = 0.0f, error_estimated = 0.0f;
+  for (int i = 0; i < steps; i++) {
+    const float t = static_cast<float>(i) * dt;
+    // 真のバイアスは5分で0.01rad/sドリフトする
+    const float bias = 0.005f + 0.01f * t / 300.0f;
+    const bool moving = std::fmod(t, 4.5f) < 3.0f;
+    const float rate = moving ? std::sin(t) : 0.0f;
+    const float velocity = moving ? 300.0f : 0.0f;
+    const float accel = 1000.0f + (moving ? shake(rng) : accel_noise(rng));
+
+    const float measured = rate + bias + gyro_noise(rng);
+    estimator.update(measured, velocity, velocity, accel);
+    error_raw += (measured - rate) * dt;
+    error_estimated += (measured - estimator.bias() - rate) * dt;
+  }
+  printf("gyro bias: raw %f rad, estimated %f rad\n", static_cast<double>(error_raw),
+         static_cast<double>(error_estimated));
+  assert(estimator.valid());
+  assert(std::fabs(error_estimated) < 0.08f);
+  assert(std::fabs(error_estimated) < std::fabs(error_raw) / 10.0f);
+}
+
+/**
+ * エンコーダーと加速度の融合
+ * 台形加速で直進し、加速中の一定区間だけ両輪が空転する。
+ * エンコーダーは量子化し、加速度にはバイアスとノイズを加える。
+ * 空転区間でスリップを検出し、融合後の距離誤差がエンコーダーのみより小さいことを確認する。
+ */
+static void testVelocityFusion() {
+  std::mt19937 rng(30);
+  std::normal_distribution<float> accel_noise(0.0f, 200.0f);
+  std::normal_distribution<float> gyro_noise(0.0f, 0.01f);
+
+  constexpr float dt = 0.001f;
+  constexpr int steps = 1000;
+  // エンコーダー1カウントあたりの距離 [mm]
+  constexpr float count_length = std::numbers::pi_v<float> * TIRE_DIAMETER / 1023.0f;
+  // 加速度 [mm/s^2]
+  constexpr float acceleration = 6000.0f;
+  // 加速度のバイアス [mm/s^2]
+  constexpr float accel_bias = 50.0f;
+
+  VelocityFusion<float> fusion({
+      .tread_width = TREAD_WIDTH,
+      .time_constant = VELOCITY_FUSION_TIME_CONSTANT,
+      .slip_time_constant = VELOCITY_FUSION_SLIP_TIME_CONSTANT,
+      .slip_filter_time_constant = SLIP_FILTER_TIME_CONSTANT,
+      .slip_velocity = SLIP_THRESHOLD_VELOCITY,
+      .slip_angular_velocity = SLIP_THRESHOLD_ANGULAR_VELOCITY,
+  });
+
+  float velocity = 0.0f, position = 0.0f;
+  float wheel_position = 0.0f, wheel_slip = 0.0f;
+  int previous_count = 0;
+  float wheel_velocity = 0.0f;
+  float length_encoder = 0.0f, length_fused = 0.0f;
+  int detected = 0, false_positive = 0;
+  for (int i = 0; i < steps; i++) {
+    const float t = static_cast<float>(i) * dt;
+    // 0.3秒加速、0.4秒等速、0.3秒減速
+    float a = 0.0f;
+    if (t < 0.3f) {
+      a = acceleration;
+    } else if (t >= 0.7f) {
+      a = -acceleration;
+    }
+    velocity += a * dt;
+    position += velocity * dt;
+
+    // 0.1秒から0.2秒の間は空転し、その後グリップを回復する
+    const bool slip = t >= 0.1f && t < 0.2f;
+    if (slip) {
+      wheel_slip += 4000.0f * dt;
+    } else {
+      wheel_slip = std::max(0.0f, wheel_slip - 8000.0f * dt);
+    }
+    wheel_position += (velocity + wheel_slip) * dt;
+
+    // エンコーダーの量子化 (Wheelと同じく前回値と平均する)
+    const int count = static_cast<int>(std::floor(wheel_position / count_length));
+    const float current = static_cast<float>(count - previous_count) * count_length / dt;
+    wheel_velocity = (current + wheel_velocity) / 2.0f;
+    previous_count = count;
+
+    const float fused =
+        fusion.update(wheel_velocity, wheel_velocity, a + accel_bias + accel_noise(rng), gyro_noise(rng), dt);
+    length_encoder += wheel_velocity * dt;
+    length_fused += fused * dt;
+
+    if (slip) {
+      detected += fusion.slipping() ? 1 : 0;
+    } else if (wheel_slip <= 0.0f) {
+      false_positive += fusion.slipping() ? 1 : 0;
+    }
+  }
+  const float error_encoder = std::fabs(length_encoder - position);
+  const float error_fused = std::fabs(length_fused - position);
+  printf("velocity fusion: encoder %f mm, fused %f mm, detected %d, false positive %d\n",
+         static_cast<double>(error_encoder), static_cast<double>(error_fused), detected, false_positive);
+  assert(detected > 50);
+  assert(false_positive < 10);
+  assert(error_fused < error_encoder / 2.0f);
+}
+
+/**
+ * 更新周期の揺らぎに対する積分
+ * 周期が700~1300usで揺らぎ、時々2.5~4msの遅延が入るタイムラインで、
+ * 量子化したエンコーダーとジャイロから距離・角度・位置を積分する。
+ * 1msを仮定した積分よりずれが十分小さく、一定範囲に収まることを確認する。
+ */
+static void testJitter() {
+  std::mt19937 rng(31);
+  std::uniform_int_distribution<uint32_t> jitter(700, 1300);
+  std::uniform_int_distribution<uint32_t> stall(2500, 4000);
+  std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+  constexpr uint16_t resolution = 1023;
+  constexpr double angle_per_count = 2.0 * std::numbers::pi / resolution;
+  constexpr double tire_radius = TIRE_DIAMETER / 2.0f;
+  constexpr double tread_half = TREAD_WIDTH / 2.0f;
+  constexpr double duration = 3.0;
+
+  // 真値 (1us刻みで積分する)
+  auto velocity = [](double t) { return 500.0 * (1.0 - std::cos(2.0 * std::numbers::pi * t)); };
+  auto angular_velocity = [](double t) { return 3.0 * std::sin(std::numbers::pi * t); };
+  // IMUから得られる車輪の角加速度 [rad/s^2]
+  auto wheel_acceleration = [&](double t, double sign) {
+    const double acceleration = 1000.0 * std::numbers::pi * std::sin(2.0 * std::numbers::pi * t);
+    const double angular_acceleration = 3.0 * std::numbers::pi * std::cos(std::numbers::pi * t);
+    return static_cast<float>((acceleration + sign * angular_acceleration * tread_half) / tire_radius);
+  };
+  double t = 0.0, length = 0.0, angle = 0.0, x = 0.0, y = 0.0;
+  double right = 0.0, left = 0.0;
+
+  // エンコーダーの生値 (右は反転して取り付けられている)
+  auto raw = [&](double position, bool invert) {
+    auto count = static_cast<int>(std::floor(position / tire_radius / angle_per_count));
+    auto value = static_cast<uint16_t>(((count % resolution) + resolution) % resolution);
+    return invert ? static_cast<uint16_t>(resolution - value) : value;
+  };
+
+  Wheel wheel_right(resolution, TIRE_DIAMETER, true), wheel_left(resolution, TIRE_DIAMETER, false);
+  wheel_right.update(raw(right, true), 1000);
+  wheel_left.update(raw(left, false), 1000);
+  Pose pose;
+  data::Histogram<uint32_t, 64> period(0, 100);
+  float naive_length = 0.0f, naive_angle = 0.0f;
+  int ticks = 0;
+  while (t < duration) {
+    const uint32_t delta_us = chance(rng) < 0.01f ? stall(rng) : jitter(rng);
+    for (uint32_t i = 0; i < delta_us; i++) {
+      const double v = velocity(t), w = angular_velocity(t);
+      length += v * 1e-6;
+      right += (v + w * tread_half) * 1e-6;
+      left += (v - w * tread_half) * 1e-6;
+      x += v * std::cos(angle) * 1e-6;
+      y += v * std::sin(angle) * 1e-6;
+      angle += w * 1e-6;
+      t += 1e-6;
+    }
+    period.update(delta_us);
+    ticks++;
+
+    wheel_right.update(raw(right, true), delta_us, wheel_acceleration(t, 1.0));
+    wheel_left.update(raw(left, false), delta_us, wheel_acceleration(t, -1.0));
+    const float v = (wheel_right.velocity() + wheel_left.velocity()) / 2.0f;
+    const auto w = static_cast<float>(angular_velocity(t));
+    pose.update(v, w, static_cast<float>(delta_us) / 1000'000.0f);
+    naive_length += v / 1000.0f;
+    naive_angle += w / 1000.0f;
+  }
+
+  const auto error_length = std::fabs(pose.length() - static_cast<float>(length));
+  const auto error_angle = std::fabs(pose.angle() - static_cast<float>(angle));
+  const auto error_position = std::hypot(pose.x() - static_cast<float>(x), pose.y() - static_cast<float>(y));
+  const auto naive_error_length = std::fabs(naive_length - static_cast<float>(length));
+  const auto naive_error_angle = std::fabs(naive_angle - static_cast<float>(angle));
+  printf("jitter: period mean %f us, p50 %u us, p99 %u us, max %u us\n", static_cast<double>(period.mean()),
+         period.percentile(0.5f), period.percentile(0.99f), period.max());
+  printf("jitter: length %f mm (naive %f mm), angle %f rad (naive %f rad), position %f mm\n",
+         static_cast<double>(error_length), static_cast<double>(naive_error_length), static_cast<double>(error_angle),
+         static_cast<double>(naive_error_angle), static_cast<double>(error_position));
+  assert(period.count() == static_cast<uint32_t>(ticks));
+  assert(period.min() >= 700 && period.max() <= 4000);
+  assert(period.percentile(0.5f) >= 900 && period.percentile(0.5f) <= 1100);
+  assert(error_length < 2.0f);
+  assert(error_angle < 0.01f);
+  assert(error_position < 2.0f);
+  assert(error_length < naive_error_length / 10.0f);
+  assert(error_angle < naive_error_angle / 10.0f);
+}
+
+/**
+ * 周期の分布の平均
+ * 999usと1003usを交互に2000万回 (1kHzで約5.5時間分) 積算し、平均が1001usからずれないことを確認する。
+ */
+static void testHistogramMean() {
+  data::Histogram<uint32_t, 64> period(0, 50);
+  for (int i = 0; i < 20'000'000; i++) {
+    period.update(i % 2 == 0 ? 999 : 1003);
+  }
+  printf("histogram: mean %f us after %u samples\n", static_cast<double>(period.mean()), period.count());
+  assert(std::fabs(period.mean() - 1001.0f) < 1e-3f);
+}
+
+/**
+ * 車輪速度のオブザーバ
+ * モーターの1次遅れモデルで車輪を動かし、1秒間20mm/sで低速走行した後500mm/sまで加速する。
+ * 角加速度の予測値にはノイズとバイアスを含むIMUの加速度を与える。
+ * 従来の差分と平均による推定より、低速時のばらつきが十分小さく、加速時の遅れも小さいことを確認する。
+ */
+static void testVelocityObserver() {
+  std::mt19937 rng(33);
+  std::normal_distribution<float> accel_noise(0.0f, 200.0f);
+
+  constexpr float dt = 0.001f;
+  constexpr int steps = 2000;
+  constexpr double angle_per_count = 2.0 * std::numbers::pi / 1023.0;
+  // 実機の時定数はモデルとずれている
+  constexpr double time_constant = MOTOR_TIME_CONSTANT * 1.2f;
+  // 加速度のバイアス [mm/s^2]
+  constexpr float accel_bias = 50.0f;
+  constexpr double tire_radius = TIRE_RADIUS;
+
+  VelocityObserver observer(static_cast<float>(angle_per_count), VELOCITY_OBSERVER_BANDWIDTH,
+                            VELOCITY_OBSERVER_DAMPING);
+  double angle = 0.0, angular_velocity = 20.0 / tire_radius;
+  int previous_count = 0;
+  float legacy = 0.0f;
+  double sum_observer = 0.0, sum_legacy = 0.0;
+  double lag_observer = 0.0, lag_legacy = 0.0;
+  for (int i = 0; i < steps; i++) {
+    const float t = static_cast<float>(i) * dt;
+    // 目標の車輪角速度 (1秒で20mm/sから500mm/sに切り替え)
+    const double steady = (t < 1.0f ? 20.0 : 500.0) / tire_radius;
+    double acceleration = 0.0;
+    for (int j = 0; j < 100; j++) {
+      acceleration = (steady - angular_velocity) / time_constant;
+      angular_velocity += acceleration * 1e-5;
+      angle += angular_velocity * 1e-5;
+    }
+    const int count = static_cast<int>(std::floor(angle / angle_per_count));
+
+    // IMUの加速度から車輪の角加速度を予測
+    const float imu = static_cast<float>(acceleration) * TIRE_RADIUS + accel_bias + accel_noise(rng);
+    const float estimated = observer.update(count - previous_count, imu / TIRE_RADIUS, dt) * TIRE_RADIUS;
+
+    // 従来の推定 (差分を前回値と平均する)
+    const float current = static_cast<float>((count - previous_count) * angle_per_count) / dt * TIRE_RADIUS;
+    legacy = (current + legacy) / 2.0f;
+    previous_count = count;
+
+    const auto truth = static_cast<float>(angular_velocity) * TIRE_RADIUS;
+    const auto error_observer = static_cast<double>(estimated - truth);
+    const auto error_legacy = static_cast<double>(legacy - truth);
+    if (t >= 0.2f && t < 1.0f) {
+      // 低速時のばらつき
+      sum_observer += error_observer * error_observer;
+      sum_legacy += error_legacy * error_legacy;
+    } else if (t >= 1.0f && t < 1.2f) {
+      // 加速時の遅れ
+      lag_observer += error_observer;
+      lag_legacy += error_legacy;
+    }
+  }
+  const auto rms_observer = std::sqrt(sum_observer / 800.0);
+  const auto rms_legacy = std::sqrt(sum_legacy / 800.0);
+  lag_observer /= 200.0;
+  lag_legacy /= 200.0;
+  printf("velocity observer: crawl rms %f mm/s (legacy %f mm/s), accel mean error %f mm/s (legacy %f mm/s)\n",
+         rms_observer, rms_legacy, lag_observer, lag_legacy);
+  assert(rms_observer < rms_legacy / 5.0);
+  assert(rms_observer < 5.0);
+  assert(std::fabs(lag_observer) < 10.0);
+}
+
+/**
+ * エンコーダーの積算
+ * 1周期で半周以上回る速度まで加速し、1kHzでは周回の判定を誤るが、
+ * 4kHzでは積算カウントが真値と一致することを確認する。
+ */
+static void testEncoderCounter() {
+  constexpr uint16_t resolution = 1023;
+  // 0.2秒で1msあたり800カウントまで加速する
+  auto position = [](double t) { return 800.0 * 1000.0 * t * t / (2.0 * 0.2); };
+  auto sample = [&](uint32_t frequency) {
+    EncoderCounter counter(resolution);
+    const auto samples = static_cast<int>(frequency / 5);
+    int32_t total = 0;
+    for (int i = 0; i <= samples; i++) {
+      const auto count = static_cast<int32_t>(position(static_cast<double>(i) / frequency));
+      total = counter.update(static_cast<uint16_t>(count % resolution));
+    }
+    return total;
+  };
+  const auto truth = static_cast<int32_t>(position(0.2));
+  const auto total_1k = sample(1'000);
+  const auto total_4k = sample(4'000);
+  printf("encoder counter: truth %d, 1kHz %d, 4kHz %d\n", static_cast<int>(truth), static_cast<int>(total_1k),
+         static_cast<int>(total_4k));
+  assert(total_1k != truth);
+  assert(total_4k == truth);
+}
+
+/**
+ * エンコーダーの読み出し間隔
+ * 4kHzで読み出したカウントを、位相が揺れる4kHzの制御周期で取り出し、1m/sで走る車輪の速度を推定する。
+ * 制御周期で割ると周期内の読み出し回数 (0〜2回) で速度が振れるが、
+ * 読み出した時刻の間隔で割れば振れないことを確認する。
+ */
+static void testEncoderInterval() {
+  constexpr uint16_t resolution = 1023;
+  constexpr uint32_t sample_period_us = 250;
+  constexpr double velocity = 1000.0;  // [mm/s]
+  const double circumference = static_cast<double>(TIRE_DIAMETER) * std::numbers::pi;
+  const double counts_per_us = velocity / circumference * resolution / 1000'000.0;
+  std::mt19937 rng(34);
+  std::uniform_int_distribution<int> jitter(-40, 40);
+  Wheel by_loop(resolution, TIRE_DIAMETER, false), by_sample(resolution, TIRE_DIAMETER, false);
+  uint32_t previous_loop = 0, previous_sample = 0;
+  float error_loop = 0.0f, error_sample = 0.0f;
+  for (int i = 1; i <= 4'000; i++) {
+    // 読み出しの直後に制御周期が来るように揺らす
+    const auto now = static_cast<uint32_t>(i * 250 + 5 + jitter(rng));
+    const auto sampled = now / sample_period_us * sample_period_us;
+    const auto total = static_cast<int32_t>(counts_per_us * sampled);
+    by_loop.update_total(total, now - previous_loop);
+    if (sampled != previous_sample) {
+      by_sample.update_total(total, sampled - previous_sample);
+      previous_sample = sampled;
+    }
+    previous_loop = now;
+    if (i > 400) {
+      error_loop = std::max(error_loop, std::fabs(by_loop.velocity() - static_cast<float>(velocity)));
+      error_sample = std::max(error_sample, std::fabs(by_sample.velocity() - static_cast<float>(velocity)));
+    }
+  }
+  printf("encoder interval: max error %f mm/s (control period %f mm/s)\n", static_cast<double>(error_sample),
+         static_cast<double>(error_loop));
+  assert(error_sample < 5.0f);
+  assert(error_loop > 4.0f * error_sample);
+}
+
+/**
+ * 三角関数の近似
+ * ±1000radの範囲でstd::sin/std::cosとの誤差を確認し、処理時間を比較する。
+ */
+static void testFastMath() {
+  constexpr int samples = 1'000'000;
+  float max_error = 0.0f, max_error_small = 0.0f;
+  for (int i = 0; i <= samples; i++) {
+    const float x = -1000.0f + 2000.0f * static_cast<float>(i) / static_cast<float>(samples);
+    const auto result = fastmath::sincos(x);
+    const auto sin = static_cast<float>(std::sin(static_cast<double>(x)));
+    const auto cos = static_cast<float>(std::cos(static_cast<double>(x)));
+    max_error = std::max({max_error, std::fabs(result.sin - sin), std::fabs(result.cos - cos)});
+
+    const float small = 0.1f * static_cast<float>(i) / static_cast<float>(samples);
+    const auto result_small = fastmath::sincos_small(small);
+    max_error_small = std::max({max_error_small, std::fabs(result_small.sin - std::sin(small)),
+                                std::fabs(result_small.cos - std::cos(small))});
+  }
+  printf("fastmath: max error %e, small angle %e\n", static_cast<double>(max_error),
+         static_cast<double>(max_error_small));
+  assert(max_error < 5e-7f);
+  assert(max_error_small < 2e-7f);
+
+  // 処理時間 (最適化で消えないようvolatileを経由する)
+  volatile float input = 0.0f;
+  volatile float sink = 0.0f;
+  auto measure = [&](auto &&function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < samples; i++) {
+      input = input + 1.0e-3f;
+      sink = sink + function(input);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / samples;
+  };
+  const auto libm = measure([](float x) { return std::sin(x) + std::cos(x); });
+  input = 0.0f;
+  const auto fast = measure([](float x) {
+    const auto result = fastmath::sincos(x);
+    return result.sin + result.cos;
+  });
+  printf("fastmath: std::sin + std::cos %f ns, fastmath::sincos %f ns\n", libm, fast);
+}
+
+/**
+ * 姿勢の積分
+ * 1kHzで10分間走行し、倍精度で同じ円弧近似を積分した結果と比較する。
+ * 保持したsin/cosを回転させても、位置のずれが1mm、角度のずれが1e-5以内に収まることを確認する。
+ * 毎回std::sin/std::cosを呼ぶ従来の積分と処理時間を比較する。
+ */
+static void testPoseLongRun() {
+  constexpr int steps = 600'000;
+  constexpr float dt = 0.001f;
+
+  // 直進・旋回・スラロームを混ぜた速度
+  std::vector<float> velocities(steps), angular_velocities(steps);
+  for (int i = 0; i < steps; i++) {
+    const float t = static_cast<float>(i) * dt;
+    velocities[i] = 300.0f + 200.0f * std::sin(0.7f * t);
+    angular_velocities[i] = 6.0f * std::sin(1.3f * t) * std::sin(0.11f * t) + 0.5f;
+  }
+
+  // 高速化した積分
+  Pose pose;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < steps; i++) {
+    pose.update(velocities[i], angular_velocities[i], dt);
+  }
+  const auto elapsed_fast = std::chrono::steady_clock::now() - start;
+
+  // 従来の積分
+  float legacy_x = 0.0f, legacy_y = 0.0f, legacy_angle = 0.0f;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < steps; i++) {
+    const float velocity = velocities[i], angular_velocity = angular_velocities[i];
+    const float angle = legacy_angle + angular_velocity * dt;
+    const float delta = (angle - legacy_angle) / 2.0f;
+    const float a = 2.0f * velocity / angular_velocity * std::sin(delta);
+    legacy_x += a * std::cos(angle + delta);
+    legacy_y += a * std::sin(angle + delta);
+    legacy_angle = angle;
+  }
+  const auto elapsed_legacy = std::chrono::steady_clock::now() - start;
+
+  // 倍精度での真値
+  double x = 0.0, y = 0.0, angle = 0.0;
+  double previous_velocity = 0.0, previous_angular_velocity = 0.0;
+  for (int i = 0; i < steps; i++) {
+    const auto velocity = static_cast<double>(velocities[i]);
+    const auto angular_velocity = static_cast<double>(angular_velocities[i]);
+    const double distance = (previous_velocity + velocity) / 2.0 * static_cast<double>(dt);
+    const double half = (previous_angular_velocity + angular_velocity) / 4.0 * static_cast<double>(dt);
+    const double chord = std::fabs(half) < 1.0e-12 ? distance : distance * std::sin(half) / half;
+    x += chord * std::cos(angle + half);
+    y += chord * std::sin(angle + half);
+    angle += 2.0 * half;
+    previous_velocity = velocity;
+    previous_angular_velocity = angular_velocity;
+  }
+
+  auto ns_per_step = [](auto elapsed) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / steps;
+  };
+  const auto error_position = std::hypot(static_cast<double>(pose.x()) - x, static_cast<double>(pose.y()) - y);
+  const auto error_angle = std::fabs(static_cast<double>(pose.angle()) - angle);
+  printf("pose: position error %f mm, angle error %e rad after %f rad\n", error_position, error_angle, angle);
+  printf("pose: legacy %f ns/step (position error %f mm, angle error %e rad), fast %f ns/step\n",
+         ns_per_step(elapsed_legacy),
+         std::hypot(static_cast<double>(legacy_x) - x, static_cast<double>(legacy_y) - y),
+         std::fabs(static_cast<double>(legacy_angle) - angle), ns_per_step(elapsed_fast));
+  assert(error_position < 1.0);
+  assert(error_angle < 1e-5);
+}
+
+/**
+ * 壁による姿勢補正
+ * 距離を3%短く見積もるオドメトリで、側壁の切れ目と前壁を見ながら7区画直進する。
+ * 区画と前後方向の位置のずれが1mm以内、傾きのずれが0.005rad以内に収まることを確認する。
+ */
+static void testPoseCorrection() {
+  constexpr float dt = 0.001f;
+  constexpr float velocity = 300.0f;
+  // オドメトリは距離を3%短く見積もる
+  constexpr float scale = 0.97f;
+  // 実際は左に少し傾いて直進している
+  constexpr float heading = 0.02f;
+  // 区画(0, 7)の北壁の表面
+  constexpr float front_wall = 7.0f * MAZE_SECTION_SIZE + MAZE_SECTION_SIZE / 2.0f - MAZE_WALL_THICKNESS / 2.0f;
+  constexpr int reference = 1000;
+  constexpr float center = (MAZE_SECTION_SIZE - MAZE_WALL_THICKNESS) / 2.0f;
+
+  // 区画ごとの側壁の有無
+  constexpr bool left_walls[] = {true, true, true, false, true, true, true, true};
+  constexpr bool right_walls[] = {true, true, true, true, true, false, true, true};
+  auto cell = [](float position) {
+    return std::clamp(static_cast<int>(std::round(position / MAZE_SECTION_SIZE)), 0, 7);
+  };
+  // 壁切れは柱より手前で検出される
+  auto exist = [&](const bool *walls, float position) {
+    return walls[cell(position - WALL_EDGE_FALLING_OFFSET)] || walls[cell(position - WALL_EDGE_RISING_OFFSET)];
+  };
+  // 反射光は距離の2乗に反比例する
+  auto front = [&](float distance) {
+    return static_cast<int>(static_cast<float>(reference) * (center / distance) * (center / distance));
+  };
+
+  PoseCorrection correction(reference, reference);
+  correction.reset({0, 0}, Map::DIRECTION_NORTH, 0.0f, 0.0f, 0.0f, 0.0f);
+  float position = 0.0f;
+  float error_before_front = 0.0f;
+  const float goal = 7.0f * MAZE_SECTION_SIZE;
+  while (position < goal) {
+    position += velocity * dt * std::cos(heading);
+    const float distance = front_wall - position;
+    const float left = (distance + WALL_FRONT_SENSOR_SPACING / 2.0f * std::sin(heading)) / std::cos(heading);
+    const float right = (distance - WALL_FRONT_SENSOR_SPACING / 2.0f * std::sin(heading)) / std::cos(heading);
+    const bool visible = distance < WALL_FRONT_CORRECTION_RANGE;
+    PoseCorrection::Observation observation{
+        .left = exist(left_walls, position),
+        .right = exist(right_walls, position),
+        .front_left = visible ? front(left) : 0,
+        .front_right = visible ? front(right) : 0,
+        .front = visible,
+    };
+    // オドメトリは開始時の向きをx軸、0 radとして積算する
+    const auto &pose = correction.update(scale * position, 0.0f, 0.0f, observation);
+    const float error = std::fabs(static_cast<float>(pose.coord.y) * MAZE_SECTION_SIZE + pose.offset - position);
+    if (!visible) {
+      error_before_front = error;
+    }
+  }
+  const auto &pose = correction.pose();
+  const float error = static_cast<float>(pose.coord.y) * MAZE_SECTION_SIZE + pose.offset - position;
+  printf("correction: %u corrections, error %f mm (%f mm before front wall, %f mm uncorrected), heading %f rad\n",
+         correction.corrections(), static_cast<double>(error), static_cast<double>(error_before_front),
+         static_cast<double>((1.0f - scale) * position), static_cast<double>(pose.heading));
+  assert(pose.coord.x == 0 && pose.coord.y == 7);
+  assert(pose.direction == Map::DIRECTION_NORTH);
+  assert(std::fabs(error) < 1.0f);
+  assert(error_before_front < 4.0f);
+  assert(std::fabs(pose.heading - heading) < 0.005f);
+}
+
+/**
+ * FIFOのサンプルの積分
+ * ODR 1.66kHzのサンプルを4kHzの制御周期で読み出し、サンプルが届かない周期を作る。
+ * 届かない周期で角度を変えなければ、積分した角度がサンプルの時刻から求めた角度と一致することを確認する。
+ * 届かない周期に制御周期分を足す従来の積分は、同じ時間を二重に数えてずれる。
+ */
+static void testGyroIntegrator() {
+  constexpr int64_t control_period_us = 250;
+  constexpr int64_t sample_period_us = 602;
+  constexpr float rate = 3.0f;
+  GyroIntegrator integrator;
+  std::array<ImuFifo::Sample, 4> batch{};
+  int64_t next_sample = 100;
+  int64_t first_sample = -1, last_sample = -1;
+  float angle = 0.0f, legacy_angle = 0.0f;
+  int empty_ticks = 0;
+  for (int64_t now = control_period_us; now <= 2'000'000; now += control_period_us) {
+    std::size_t size = 0;
+    while (next_sample <= now) {
+      batch[size++] = {next_sample, {0, 0, 0}, {0, 0, 0}};
+      if (first_sample < 0) first_sample = next_sample;
+      last_sample = next_sample;
+      next_sample += sample_period_us;
+    }
+    auto delta = integrator.update(std::span<const ImuFifo::Sample>(batch.data(), size),
+                                   [&](const ImuFifo::Sample &) { return rate; });
+    if (size == 0) {
+      empty_ticks++;
+      assert(std::fabs(delta) < 1e-9f);
+      legacy_angle += rate * static_cast<float>(control_period_us) / 1000'000.0f;
+    }
+    angle += delta;
+    legacy_angle += delta;
+  }
+  const auto expected = rate * static_cast<float>(last_sample - first_sample) / 1000'000.0f;
+  printf("gyro integrator: %d empty ticks, error %e rad (legacy %f rad) after %f rad\n", empty_ticks,
+         static_cast<double>(angle - expected), static_cast<double>(legacy_angle - expected),
+         static_cast<double>(expected));
+  assert(empty_ticks > 1000);
+  assert(std::fabs(angle - expected) < 1e-3f);
+  assert(std::fabs(legacy_angle - expected) > 1.0f);
+}
+
+int main() {
+  testGyroBias();
+  testVelocityFusion();
+  testJitter();
+  testHistogramMean();
+  testVelocityObserver();
+  testEncoderCounter();
+  testEncoderInterval();
+  testFastMath();
+  testPoseLongRun();
+  testPoseCorrection();
+  testGyroIntegrator();
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+
+#include "../../main/profiler.h"
+
+// 指定時間だけ待つ (スリープより誤差が小さい)
+static void spin(std::chrono::microseconds duration) {
+  auto end = std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+int main() {
+  static_assert(profiler::ENABLED, "test requires the profiler to be enabled");
+
+  // スコープの所要時間が記録される
+  {
+    for (int i = 0; i < 100; i++) {
+      profiler::Scope scope(profiler::STAGE_ODOMETRY);
+      spin(std::chrono::microseconds(i < 99 ? 50 : 300));
+    }
+    const auto &histogram = profiler::instance.histogram(profiler::STAGE_ODOMETRY);
+    const auto min = profiler::Profiler::to_us(static_cast<float>(histogram.min()));
+    const auto max = profiler::Profiler::to_us(static_cast<float>(histogram.max()));
+    const auto p50 = profiler::Profiler::to_us(static_cast<float>(histogram.percentile(0.5f)));
+    const auto mean = profiler::Profiler::to_us(histogram.mean());
+    printf("odometry: min %f, p50 %f, mean %f, max %f us\n", static_cast<double>(min), static_cast<double>(p50),
+           static_cast<double>(mean), static_cast<double>(max));
+    assert(histogram.count() == 100);
+    assert(min >= 50.0f);
+    // 50 usを含むビンの上限
+    assert(p50 >= 50.0f && p50 <= 50.0f + profiler::Profiler::HISTOGRAM_WIDTH_US * 2);
+    assert(max >= 300.0f);
+    assert(mean > min && mean < max);
+  }
+
+  // 計測していない区間は空のまま
+  assert(profiler::instance.histogram(profiler::STAGE_MOTION).count() == 0);
+
+  // 写しは要求した後の記録で取られる
+  {
+    auto request = profiler::instance.requestSnapshot();
+    assert(!profiler::instance.snapshotTaken(request));
+    assert(profiler::instance.snapshot(profiler::STAGE_ODOMETRY).count() == 0);
+    { profiler::Scope scope(profiler::STAGE_MOTION); }
+    assert(profiler::instance.snapshotTaken(request));
+    assert(profiler::instance.snapshot(profiler::STAGE_ODOMETRY).count() == 100);
+    assert(profiler::instance.snapshot(profiler::STAGE_MOTION).count() == 1);
+    // 次の要求までは写し直さない
+    { profiler::Scope scope(profiler::STAGE_MOTION); }
+    assert(profiler::instance.snapshot(profiler::STAGE_MOTION).count() == 1);
+  }
+
+  profiler::instance.print();
+
+  // 直近の所要カウント
+  assert(profiler::Profiler::to_us(static_cast<float>(profiler::instance.last(profiler::STAGE_ODOMETRY))) >= 300.0f);
+
+  // リセット
+  profiler::instance.reset();
+  assert(profiler::instance.histogram(profiler::STAGE_ODOMETRY).count() == 0);
+  assert(profiler::instance.last(profiler::STAGE_ODOMETRY) == 0);
+
+  printf("OK\n");
+  return 0;
+}
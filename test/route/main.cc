@@ -0,0 +1,318 @@
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <numbers>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "../../main/map.h"
+#include "../../main/parameters.h"
+#include "../../main/route.h"
+#include "../../main/slalom.h"
+#include "../../main/trajectory.h"
+
+// 迷路の大きさ
+static constexpr int SIZE = 16;
+// ゴール (中央の4区画の左下)
+static constexpr int GOAL = 7;
+
+static bool goal(int x, int y) { return GOAL <= x && x <= GOAL + 1 && GOAL <= y && y <= GOAL + 1; }
+
+static constexpr int DX[4] = {0, 1, 0, -1};
+static constexpr int DY[4] = {1, 0, -1, 0};
+
+static bool near(float a, float b, float tolerance) { return std::abs(a - b) <= tolerance; }
+
+// 壁を区画ごと・方位ごとに持つ迷路
+struct Maze {
+  std::array<std::array<std::array<bool, 4>, SIZE>, SIZE> walls;
+
+  void set(int x, int y, int dir, bool exist) {
+    walls[x][y][dir] = exist;
+    auto nx = x + DX[dir], ny = y + DY[dir];
+    if (0 <= nx && nx < SIZE && 0 <= ny && ny < SIZE) walls[nx][ny][(dir + 2) & 0x03] = exist;
+  }
+};
+
+/**
+ * 穴掘り法で迷路を作り、ループを作るために壁をいくつか抜く
+ * @details 大会の迷路データがないため、シードから決まる迷路で代わりに試す
+ */
+static Maze generate(uint32_t seed, int openings) {
+  std::mt19937 random(seed);
+  Maze maze{};
+  for (int x = 0; x < SIZE; x++) {
+    for (int y = 0; y < SIZE; y++) maze.walls[x][y] = {true, true, true, true};
+  }
+  std::vector<std::pair<int, int>> stack = {{0, 0}};
+  std::array<std::array<bool, SIZE>, SIZE> visited{};
+  visited[0][0] = true;
+  while (!stack.empty()) {
+    auto [x, y] = stack.back();
+    std::vector<int> candidates;
+    for (int dir = 0; dir < 4; dir++) {
+      auto nx = x + DX[dir], ny = y + DY[dir];
+      if (0 <= nx && nx < SIZE && 0 <= ny && ny < SIZE && !visited[nx][ny]) candidates.push_back(dir);
+    }
+    if (candidates.empty()) {
+      stack.pop_back();
+      continue;
+    }
+    auto dir = candidates[random() % candidates.size()];
+    maze.set(x, y, dir, false);
+    visited[x + DX[dir]][y + DY[dir]] = true;
+    stack.emplace_back(x + DX[dir], y + DY[dir]);
+  }
+  for (int i = 0; i < openings; i++) {
+    auto x = static_cast<int>(random() % (SIZE - 1)), y = static_cast<int>(random() % (SIZE - 1));
+    maze.set(x, y, static_cast<int>(random() % 2), false);
+  }
+  // ゴールの中は壁がない
+  maze.set(GOAL, GOAL, Map::DIRECTION_NORTH, false);
+  maze.set(GOAL, GOAL, Map::DIRECTION_EAST, false);
+  maze.set(GOAL + 1, GOAL + 1, Map::DIRECTION_SOUTH, false);
+  maze.set(GOAL + 1, GOAL + 1, Map::DIRECTION_WEST, false);
+  // スタートは北にしか出られない
+  maze.set(0, 0, Map::DIRECTION_NORTH, false);
+  maze.set(0, 0, Map::DIRECTION_EAST, true);
+  return maze;
+}
+
+// 幅優先探索でスタートから最初に着くゴールの区画までの方位の並びを求める
+static std::vector<Map::Direction> shortest(const Maze &maze) {
+  std::array<std::array<int, SIZE>, SIZE> from{};
+  for (auto &column : from) column.fill(-1);
+  std::queue<std::pair<int, int>> queue;
+  queue.emplace(0, 0);
+  from[0][0] = 4;
+  while (!queue.empty()) {
+    auto [x, y] = queue.front();
+    queue.pop();
+    for (int dir = 0; dir < 4; dir++) {
+      auto nx = x + DX[dir], ny = y + DY[dir];
+      if (maze.walls[x][y][dir] || from[nx][ny] >= 0) continue;
+      from[nx][ny] = dir;
+      queue.emplace(nx, ny);
+    }
+  }
+  int gx = -1, gy = -1;
+  for (int x = GOAL; x <= GOAL + 1; x++) {
+    for (int y = GOAL; y <= GOAL + 1; y++) {
+      // ゴールの外から入る区画
+      auto dir = from[x][y];
+      if (dir >= 0 && dir < 4 && !goal(x - DX[dir], y - DY[dir])) gx = x, gy = y;
+    }
+  }
+  assert(gx >= 0);
+  std::vector<Map::Direction> directions;
+  for (int x = gx, y = gy; x != 0 || y != 0;) {
+    auto dir = from[x][y];
+    assert(dir >= 0 && dir < 4);
+    directions.insert(directions.begin(), static_cast<Map::Direction>(dir));
+    x -= DX[dir];
+    y -= DY[dir];
+  }
+  return directions;
+}
+
+// 方位の並びを区画ごとの動作にする (スタートの区画は直進、ゴールは2区画直進して止まる)
+static std::vector<RouteAction> actions(const std::vector<Map::Direction> &directions) {
+  std::vector<RouteAction> result = {RouteAction::Straight};
+  for (std::size_t i = 1; i < directions.size(); i++) {
+    result.push_back(Route::relative(directions[i - 1], directions[i]));
+  }
+  result.push_back(RouteAction::Straight);
+  result.push_back(RouteAction::Straight);
+  return result;
+}
+
+// ターンの形 (開始・終了から、進行方向の直線が交わる点までの距離 [mm])
+struct Corner {
+  float entry, exit;
+};
+
+static Corner corner(slalom::Type type) {
+  constexpr float SECTION = MAZE_SECTION_SIZE;
+  constexpr float DIAGONAL = MAZE_SECTION_SIZE / 2.0f * std::numbers::sqrt2_v<float>;
+  switch (type) {
+    case slalom::TURN_90:
+      return {SECTION / 2.0f, SECTION / 2.0f};
+    case slalom::TURN_LARGE_90:
+      return {SECTION, SECTION};
+    case slalom::TURN_45_IN:
+    case slalom::TURN_135_IN:
+      return {SECTION, DIAGONAL};
+    case slalom::TURN_45_OUT:
+    case slalom::TURN_135_OUT:
+      return {DIAGONAL, SECTION};
+    case slalom::TURN_V90:
+      return {DIAGONAL, DIAGONAL};
+    default:
+      return {0.0f, 0.0f};
+  }
+}
+
+// 区間をたどった終了位置が、ゴールの2区画目の辺の中央になる
+static void testGeometry(const Route &route, const std::vector<Map::Direction> &directions) {
+  // スタートの区画の後ろの辺の中央から北向きに始める
+  float x = 0.0f, y = -MAZE_SECTION_SIZE / 2.0f;
+  // 向き (北を0、右回りに45度ずつ)
+  int heading = 0;
+  auto forward = [&](float length) {
+    auto angle = static_cast<float>(heading) * std::numbers::pi_v<float> / 4.0f;
+    x += length * std::sin(angle);
+    y += length * std::cos(angle);
+  };
+  for (const auto &segment : route.segments()) {
+    if (segment.kind == RouteSegment::KIND_STRAIGHT) {
+      assert(heading % 2 == 0);
+      forward(segment.length);
+      continue;
+    }
+    if (segment.kind == RouteSegment::KIND_DIAGONAL) {
+      assert(heading % 2 != 0);
+      forward(segment.length);
+      continue;
+    }
+    auto sign = segment.direction == MotionDirection::Right ? 1 : -1;
+    auto steps = static_cast<int>(std::lround(segment.table->angle / (std::numbers::pi_v<float> / 4.0f)));
+    if (segment.type == slalom::TURN_180) {
+      // 隣の列へ戻る
+      heading = (heading + 2 * sign + 8) % 8;
+      forward(MAZE_SECTION_SIZE);
+      heading = (heading + 2 * sign + 8) % 8;
+      continue;
+    }
+    auto [entry, exit] = corner(segment.type);
+    forward(entry);
+    heading = (heading + steps * sign + 8) % 8;
+    forward(exit);
+  }
+  int cx = 0, cy = 0;
+  for (auto dir : directions) cx += DX[dir], cy += DY[dir];
+  auto last = directions.back();
+  auto goal_x = (static_cast<float>(cx) + static_cast<float>(DX[last]) * 1.5f) * MAZE_SECTION_SIZE;
+  auto goal_y = (static_cast<float>(cy) + static_cast<float>(DY[last]) * 1.5f) * MAZE_SECTION_SIZE;
+  assert(heading == 2 * last);
+  assert(near(x, goal_x, 1e-2f) && near(y, goal_y, 1e-2f));
+}
+
+// 区間の境目の速度が連続し、直進は加速度の範囲で届き、スラロームはテーブルの速度で入る
+static void testPlan(const Route &route, float max_velocity) {
+  const auto &segments = route.segments();
+  assert(near(segments.front().entry_velocity, 0.0f, 1e-6f));
+  assert(near(segments.back().exit_velocity, 0.0f, 1e-6f));
+  float time = 0.0f;
+  for (std::size_t i = 0; i < segments.size(); i++) {
+    const auto &segment = segments[i];
+    if (i > 0) assert(near(segment.entry_velocity, segments[i - 1].exit_velocity, 1e-6f));
+    if (segment.kind == RouteSegment::KIND_SLALOM) {
+      assert(near(segment.entry_velocity, segment.table->velocity, 1e-3f));
+      assert(near(segment.exit_velocity, segment.table->velocity, 1e-3f));
+    } else {
+      assert(segment.max_velocity <= std::min(max_velocity, Route::top_velocity()) + 1e-6f);
+      assert(segment.entry_velocity <= segment.max_velocity + 1e-6f);
+      assert(segment.exit_velocity <= segment.max_velocity + 1e-6f);
+      auto needed = Trajectory::ramp_distance(segment.entry_velocity, segment.exit_velocity, route.acceleration(),
+                                              route.jerk());
+      assert(needed <= segment.length / 1000.0f + 1e-5f);
+      // 実際のプロファイルでも終端速度に届く
+      Trajectory trajectory;
+      trajectory.reset(segment.length / 1000.0f, segment.entry_velocity, segment.max_velocity, segment.exit_velocity,
+                       route.acceleration(), route.jerk());
+      assert(near(trajectory.end_velocity(), segment.exit_velocity, 1e-3f));
+    }
+    time += segment.time;
+  }
+  assert(near(time, route.time(), 1e-3f));
+}
+
+// 決まった動作の並びが期待した区間になる
+static void testCompile() {
+  using A = RouteAction;
+  Route route;
+  auto kinds = [&](std::initializer_list<slalom::Type> expected) {
+    std::vector<slalom::Type> types;
+    for (const auto &segment : route.segments()) {
+      if (segment.kind == RouteSegment::KIND_SLALOM) types.push_back(segment.type);
+    }
+    assert(types == std::vector<slalom::Type>(expected));
+  };
+  // 小回り (直前に直進がない)
+  assert(route.compile({A::Right, A::Straight}));
+  kinds({slalom::TURN_90});
+  // 大回り
+  assert(route.compile({A::Straight, A::Right, A::Straight}));
+  kinds({slalom::TURN_LARGE_90});
+  // 180度
+  assert(route.compile({A::Straight, A::Left, A::Left, A::Straight}));
+  kinds({slalom::TURN_180});
+  // 45度で入って45度で出る (最初のターンの前には直進を残す)
+  assert(route.compile({A::Straight, A::Right, A::Left, A::Straight}));
+  kinds({slalom::TURN_90, slalom::TURN_90});
+  assert(route.compile({A::Straight, A::Straight, A::Right, A::Left, A::Right, A::Left, A::Straight}));
+  kinds({slalom::TURN_45_IN, slalom::TURN_45_OUT});
+  assert(route.segments().size() == 4);
+  assert(near(route.segments()[2].length, 2.0f * MAZE_SECTION_SIZE / std::numbers::sqrt2_v<float>, 1e-3f));
+  // 135度で入って135度で出る
+  assert(route.compile({A::Straight, A::Right, A::Right, A::Left, A::Left, A::Straight}));
+  kinds({slalom::TURN_135_IN, slalom::TURN_135_OUT});
+  // V90
+  assert(route.compile({A::Straight, A::Straight, A::Right, A::Left, A::Right, A::Right, A::Left, A::Straight}));
+  kinds({slalom::TURN_45_IN, slalom::TURN_V90, slalom::TURN_45_OUT});
+}
+
+int main() {
+  testCompile();
+
+  // 生成した迷路で経路を作り、時間を予測する
+  constexpr float MAX_VELOCITIES[] = {1.0f, 2.0f, 3.0f};
+  constexpr float TURN_VELOCITY = 1.0f;
+  printf("top velocity %.2f m/s\n", static_cast<double>(Route::top_velocity()));
+  double total[std::size(MAX_VELOCITIES)] = {};
+  int count = 0;
+  for (uint32_t seed = 1; seed <= 50; seed++) {
+    auto maze = generate(seed, static_cast<int>(seed % 4) * 10);
+    auto directions = shortest(maze);
+    auto route_actions = actions(directions);
+    Route route;
+    assert(route.compile(route_actions));
+    for (std::size_t i = 0; i < std::size(MAX_VELOCITIES); i++) {
+      assert(route.plan(MAX_VELOCITIES[i], TURN_VELOCITY));
+      testGeometry(route, directions);
+      testPlan(route, MAX_VELOCITIES[i]);
+      total[i] += static_cast<double>(route.time());
+    }
+    if (seed <= 5) {
+      printf("maze %2u: %3zu cells, %3zu segments,", seed, directions.size(), route.segments().size());
+      for (std::size_t i = 0; i < std::size(MAX_VELOCITIES); i++) {
+        route.plan(MAX_VELOCITIES[i], TURN_VELOCITY);
+        printf(" %.1f m/s %.3f s", static_cast<double>(MAX_VELOCITIES[i]), static_cast<double>(route.time()));
+      }
+      printf("\n");
+    }
+    count++;
+  }
+  for (std::size_t i = 0; i < std::size(MAX_VELOCITIES); i++) {
+    printf("average at %.1f m/s: %.3f s\n", static_cast<double>(MAX_VELOCITIES[i]), total[i] / count);
+  }
+
+  // planの時間
+  {
+    auto maze = generate(1, 20);
+    Route route;
+    route.compile(actions(shortest(maze)));
+    constexpr int COUNTS = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < COUNTS; i++) route.plan(3.0f, TURN_VELOCITY);
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    printf("plan: %zu segments, %.1f us\n", route.segments().size(), elapsed / COUNTS);
+  }
+
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,231 @@
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../../main/parameters.h"
+#include "../../main/sysid.h"
+#include "../../tools/sysid/estimator.h"
+
+// 制御周期 [s]
+static constexpr float DT = 0.001f;
+// プラントの計算の細かい周期 [s]
+static constexpr double SUBSTEP = 1e-5;
+
+static bool near(double a, double b, double tolerance) { return std::abs(a - b) <= tolerance * std::abs(b); }
+
+// 並進・旋回の入力信号 (main.ccの列と同じ構成)
+static std::vector<sysid::Config> sequence(sysid::Axis axis, float amplitude) {
+  return {
+      {sysid::Signal::Step, axis, amplitude, 500, 1, 0.0f, 0.0f},
+      {sysid::Signal::Prbs, axis, amplitude, 800, 10, 0.0f, 0.0f},
+      {sysid::Signal::Chirp, axis, amplitude, 700, 1, 1.0f, 20.0f},
+  };
+}
+
+// クーロン摩擦を引いた入力 (止まっている間は摩擦電圧を超えるまで動かない)
+static double friction(double input, double output, double voltage) {
+  if (output > 0.0) return input - voltage;
+  if (output < 0.0) return input + voltage;
+  if (std::abs(input) <= voltage) return 0.0;
+  return input - std::copysign(voltage, input);
+}
+
+// 摩擦のある1次遅れのプラント T y' = K (u - Vf sgn(y)) - y
+struct FirstOrderPlant {
+  double gain, time_constant, friction_voltage;
+  double output = 0.0;
+
+  void update(double input, double dt) {
+    for (auto t = 0.0; t < dt - SUBSTEP / 2.0; t += SUBSTEP) {
+      auto next = output + (gain * friction(input, output, friction_voltage) - output) * SUBSTEP / time_constant;
+      // 0を横切ったら一度止める
+      output = next * output < 0.0 ? 0.0 : next;
+    }
+  }
+};
+
+// 2次遅れのプラント y'' = wn^2 (K u - y) - 2 zeta wn y'
+struct SecondOrderPlant {
+  double gain, natural_frequency, damping;
+  double output = 0.0, rate = 0.0;
+
+  void update(double input, double dt) {
+    auto wn = natural_frequency;
+    for (auto t = 0.0; t < dt - SUBSTEP / 2.0; t += SUBSTEP) {
+      rate += (wn * wn * (gain * input - output) - 2.0 * damping * wn * rate) * SUBSTEP;
+      output += rate * SUBSTEP;
+    }
+  }
+};
+
+// 記録をIdentification::print()と同じ形で作り、読み直す
+template <typename Plant>
+static std::vector<sysid::Series> record(const std::vector<sysid::Config> &configs, const Plant &initial,
+                                         double noise) {
+  sysid::Log<4096, 8> log;
+  sysid::Excitation excitation;
+  std::mt19937 engine(1);
+  std::normal_distribution<double> distribution(0.0, noise);
+  for (const auto &config : configs) {
+    auto plant = initial;
+    excitation.start(config, DT);
+    assert(log.begin(config));
+    while (!excitation.finished()) {
+      // 電圧をかける前に測る
+      auto measured = static_cast<float>(plant.output + distribution(engine));
+      auto voltage = excitation.update();
+      auto input = config.axis == sysid::Axis::Translation ? (voltage.right + voltage.left) / 2.0f
+                                                          : (voltage.right - voltage.left) / 2.0f;
+      if (config.axis == sysid::Axis::Translation) {
+        assert(log.push({voltage.right, voltage.left, measured, 0.0f}));
+      } else {
+        assert(log.push({voltage.right, voltage.left, 0.0f, measured}));
+      }
+      plant.update(static_cast<double>(input), static_cast<double>(DT));
+    }
+  }
+
+  auto file = std::tmpfile();
+  fprintf(file, "I (1234) console: ignored line\n# sysid %u\n", static_cast<unsigned>(1.0f / DT + 0.5f));
+  fprintf(file, "run,signal,axis,right,left,velocity,angular_velocity\n");
+  for (std::size_t r = 0; r < log.runs(); r++) {
+    const auto &run = log.run(r);
+    for (std::size_t i = run.begin; i < run.begin + run.size; i++) {
+      const auto &s = log.sample(i);
+      fprintf(file, "%u,%s,%s,%.4f,%.4f,%.5f,%.4f\n", static_cast<unsigned>(r), sysid::name(run.config.signal),
+              sysid::name(run.config.axis), static_cast<double>(s.right), static_cast<double>(s.left),
+              static_cast<double>(s.velocity), static_cast<double>(s.angular_velocity));
+    }
+  }
+  std::rewind(file);
+  std::vector<sysid::Series> series;
+  double frequency = 0.0;
+  assert(sysid::read(file, series, frequency) == configs.size());
+  assert(std::abs(frequency - 1000.0) < 0.5);
+  std::fclose(file);
+  return series;
+}
+
+static std::vector<const sysid::Series *> pointers(const std::vector<sysid::Series> &series) {
+  std::vector<const sysid::Series *> result;
+  for (const auto &s : series) result.push_back(&s);
+  return result;
+}
+
+// 入力信号の形
+static void testExcitation() {
+  sysid::Excitation excitation;
+
+  // ステップ: 前半だけ電圧をかける
+  excitation.start({sysid::Signal::Step, sysid::Axis::Translation, 0.3f, 100, 1, 0.0f, 0.0f}, DT);
+  for (int i = 0; i < 100; i++) {
+    auto v = excitation.update();
+    assert(std::abs(v.right - v.left) < 1e-6f);
+    assert(std::abs(v.right - (i < 50 ? 0.3f : 0.0f)) < 1e-6f);
+  }
+  assert(excitation.finished());
+  auto v = excitation.update();
+  assert(std::abs(v.right) < 1e-6f && std::abs(v.left) < 1e-6f);
+
+  // M系列: ±振幅でビットごとに変わり、1周期 (511ビット) で+が256回
+  excitation.start({sysid::Signal::Prbs, sysid::Axis::Rotation, 0.1f, 511 * 4, 4, 0.0f, 0.0f}, DT);
+  int positive = 0;
+  float previous = 0.0f;
+  for (int i = 0; i < 511 * 4; i++) {
+    v = excitation.update();
+    assert(std::abs(v.right + v.left) < 1e-6f);
+    assert(std::abs(std::abs(v.right) - 0.1f) < 1e-6f);
+    if (i % 4 != 0) assert(std::abs(v.right - previous) < 1e-6f);
+    if (i % 4 == 0 && v.right > 0.0f) positive++;
+    previous = v.right;
+  }
+  assert(positive == 256);
+
+  // チャープ: 振幅以内で0から始まり、後半ほど符号が頻繁に変わる
+  excitation.start({sysid::Signal::Chirp, sysid::Axis::Translation, 0.2f, 1000, 1, 1.0f, 20.0f}, DT);
+  int crossings[2] = {};
+  previous = 0.0f;
+  for (int i = 0; i < 1000; i++) {
+    v = excitation.update();
+    if (i == 0) assert(std::abs(v.right) < 1e-6f);
+    assert(std::abs(v.right) <= 0.2f + 1e-6f);
+    if (i > 0 && std::signbit(v.right) != std::signbit(previous)) crossings[i < 500 ? 0 : 1]++;
+    previous = v.right;
+  }
+  printf("chirp: %d / %d zero crossings\n", crossings[0], crossings[1]);
+  assert(crossings[1] > 2 * crossings[0]);
+}
+
+// 記録: 入り切らない信号は始めない
+static void testLog() {
+  sysid::Log<100, 2> log;
+  sysid::Config config{sysid::Signal::Step, sysid::Axis::Translation, 0.1f, 60, 1, 0.0f, 0.0f};
+  assert(!log.push({}));
+  assert(log.begin(config));
+  for (int i = 0; i < 60; i++) assert(log.push({}));
+  assert(!log.begin(config));
+  config.ticks = 40;
+  assert(log.begin(config));
+  assert(!log.begin(config));
+  assert(log.runs() == 2 && log.run(1).begin == 60);
+  for (int i = 0; i < 40; i++) assert(log.push({}));
+  assert(!log.push({}));
+  assert(log.size() == 100 && log.run(1).size == 40);
+  log.clear();
+  assert(log.size() == 0 && log.runs() == 0);
+}
+
+// 並進: 1次遅れのゲイン・時定数・摩擦電圧を戻せる
+static void testFirstOrder() {
+  constexpr double K = 2.5, T = 0.05, FRICTION = 0.04;
+  auto series = record(sequence(sysid::Axis::Translation, 0.3f), FirstOrderPlant{K, T, FRICTION}, 0.002);
+  sysid::FirstOrder model{};
+  assert(sysid::fit_first_order(pointers(series), DT, model));
+  printf("first order: K %.4f (%.4f), T %.4f (%.4f), friction %.4f (%.4f), fit %.1f %%\n", model.gain, K,
+         model.time_constant, T, model.friction, FRICTION, model.fit);
+  assert(near(model.gain, K, 0.05));
+  assert(near(model.time_constant, T, 0.05));
+  assert(near(model.friction, FRICTION, 0.25));
+  assert(model.fit > 90.0);
+
+  // 既定のゲインと同じ考え方 (積分時間 = 時定数) になる
+  auto gain = sysid::tune(model, static_cast<double>(SYSID_CLOSED_LOOP_TIME_CONSTANT));
+  assert(near(gain.kp / gain.ki, model.time_constant, 1e-9));
+  assert(near(gain.ki, 1.0 / (model.gain * static_cast<double>(SYSID_CLOSED_LOOP_TIME_CONSTANT)), 1e-9));
+}
+
+// 旋回: 振動的な2次遅れの固有角周波数・減衰比を戻せる
+static void testSecondOrder() {
+  constexpr double K = 150.0, WN = 60.0, ZETA = 0.5;
+  auto series = record(sequence(sysid::Axis::Rotation, 0.1f), SecondOrderPlant{K, WN, ZETA}, 0.05);
+  sysid::SecondOrder model{};
+  assert(sysid::fit_second_order(pointers(series), DT, model));
+  printf("second order: K %.2f (%.2f), wn %.2f (%.2f), zeta %.3f (%.3f), fit %.1f %%\n", model.gain, K,
+         model.natural_frequency, WN, model.damping, ZETA, model.fit);
+  assert(near(model.gain, K, 0.05));
+  assert(near(model.natural_frequency, WN, 0.05));
+  assert(near(model.damping, ZETA, 0.05));
+  assert(model.fit > 90.0);
+
+  // 1次遅れでは当てはまらない (解けないか、当てはまりが悪くなる)
+  sysid::FirstOrder first{};
+  auto solved = sysid::fit_first_order(pointers(series), DT, first);
+  printf("second order as first order: %s, fit %.1f %%\n", solved ? "solved" : "failed", solved ? first.fit : 0.0);
+  assert(!solved || first.fit < model.fit);
+
+  // PIDの微分は2次の項を打ち消す
+  auto gain = sysid::tune(model, 0.02);
+  assert(near(gain.kd / gain.ki, 1.0 / (model.natural_frequency * model.natural_frequency), 1e-9));
+  assert(near(gain.kp / gain.ki, 2.0 * model.damping / model.natural_frequency, 1e-9));
+}
+
+int main() {
+  testExcitation();
+  testLog();
+  testFirstOrder();
+  testSecondOrder();
+  printf("ok\n");
+  return 0;
+}
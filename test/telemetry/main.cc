@@ -0,0 +1,196 @@
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../../main/dri/cobs.h"
+#include "../../main/telemetry.h"
+#include "../../tools/telemetry/decoder.h"
+
+static TelemetryFrame makeFrame(uint32_t timestamp) {
+  TelemetryFrame frame{};
+  frame.timestamp = timestamp;
+  frame.velocity = 0.3f;
+  frame.angular_velocity = -1.5f;
+  frame.x = static_cast<float>(timestamp) / 1000.0f;
+  frame.wall[0] = 1000;
+  frame.wall[3] = -1;
+  frame.flags = TelemetryFrame::FLAG_WALL_RIGHT90 | TelemetryFrame::FLAG_WALL_LEFT90;
+  frame.motor_voltage_right = 1200;
+  frame.motor_voltage_left = -800;
+  frame.profile[profiler::STAGE_MOTION] = 123;
+  return frame;
+}
+
+// COBS: 0x00を含まず、復号すると元に戻る
+static void testCobs() {
+  std::mt19937 engine(1);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<std::size_t> sizes = {0, 1, 253, 254, 255, 508, 600};
+  for (int i = 0; i < 200; i++) sizes.push_back(static_cast<std::size_t>(engine() % 600));
+  for (const auto size : sizes) {
+    for (const int zeros : {0, 1, 2}) {
+      std::vector<uint8_t> src(size);
+      for (auto &value : src) value = static_cast<uint8_t>(zeros == 2 ? 0 : byte(engine));
+      if (zeros == 0) {
+        for (auto &value : src) value = value == 0 ? 1 : value;
+      }
+      std::vector<uint8_t> encoded(data::cobs_max_encoded_size(size));
+      auto length = data::cobs_encode(src.data(), size, encoded.data());
+      assert(length <= encoded.size());
+      for (std::size_t j = 0; j < length; j++) assert(encoded[j] != 0);
+      std::vector<uint8_t> decoded(length);
+      auto decoded_size = data::cobs_decode(encoded.data(), length, decoded.data());
+      assert(decoded_size == size);
+      assert(std::memcmp(decoded.data(), src.data(), size) == 0);
+    }
+  }
+  // 既知の符号
+  const uint8_t src[] = {0x11, 0x22, 0x00, 0x33};
+  uint8_t encoded[8];
+  assert(data::cobs_encode(src, sizeof(src), encoded) == 5);
+  const uint8_t expected[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+  assert(std::memcmp(encoded, expected, sizeof(expected)) == 0);
+  // CRC-16/CCITT-FALSE のチェック値
+  const char *check = "123456789";
+  assert(data::crc16(reinterpret_cast<const uint8_t *>(check), 9) == 0x29B1);
+}
+
+// 復号器: 雑音・壊れたフレーム・取りこぼしを扱える
+static void testDecoder() {
+  std::vector<uint8_t> stream = {'h', 'e', 'l', 'l', 'o', '\n', 0x00};
+  uint8_t buffer[telemetry::MAX_ENCODED_SIZE];
+  for (uint32_t i = 0; i < 10; i++) {
+    auto frame = makeFrame(i * 1000);
+    frame.version = TelemetryFrame::VERSION;
+    // 5番目は欠落させる
+    frame.sequence = i < 5 ? i : i + 1;
+    auto size = telemetry::encode(frame, buffer);
+    assert(size <= telemetry::MAX_ENCODED_SIZE);
+    // 3番目は1ビット壊す
+    if (i == 3) buffer[10] ^= 0x04;
+    stream.insert(stream.end(), buffer, buffer + size);
+  }
+
+  telemetry::Decoder decoder;
+  TelemetryFrame frame{};
+  uint32_t decoded = 0;
+  for (const auto byte : stream) {
+    if (decoder.update(byte, frame)) {
+      decoded++;
+      assert(frame.velocity > 0.29f && frame.velocity < 0.31f);
+      assert(frame.motor_voltage_left == -800);
+      assert(frame.profile[profiler::STAGE_MOTION] == 123);
+    }
+  }
+  printf("decoder: %u frames, %u errors, %u lost\n", decoder.frames(), decoder.errors(), decoder.lost());
+  assert(decoded == 9);
+  assert(decoder.errors() == 2);
+  // 壊れた1つと欠落した1つ
+  assert(decoder.lost() == 2);
+}
+
+// 制御ループから送信タスクへの受け渡し
+static void testChannel() {
+  telemetry::Channel channel;
+  assert(!channel.enabled());
+  channel.enable();
+  for (uint32_t i = 0; i < telemetry::Channel::QUEUE_SIZE + 3; i++) {
+    auto frame = makeFrame(i);
+    channel.publish(frame);
+  }
+  assert(channel.dropped() == 3);
+  TelemetryFrame frame{};
+  for (uint32_t i = 0; i < telemetry::Channel::QUEUE_SIZE; i++) {
+    assert(channel.receive(frame));
+    assert(frame.sequence == i && frame.version == TelemetryFrame::VERSION);
+  }
+  assert(!channel.receive(frame));
+}
+
+// ptyを実機のUARTの代わりにして、送信側と受信ツールをつなぐ
+static void testPty() {
+  constexpr uint32_t FRAMES = 2000;
+  auto master = posix_openpt(O_RDWR | O_NOCTTY);
+  assert(master >= 0);
+  assert(grantpt(master) == 0 && unlockpt(master) == 0);
+  auto slave = open(ptsname(master), O_RDONLY | O_NOCTTY);
+  assert(slave >= 0);
+  assert(telemetry::configure(slave, 2'000'000));
+
+  std::thread sender([&] {
+    telemetry::Channel channel;
+    channel.enable();
+    uint8_t buffer[telemetry::MAX_ENCODED_SIZE];
+    // 切り替え前のテキスト出力が混ざる
+    const char banner[] = "telemetry: 1000 frames/s\n";
+    assert(write(master, banner, sizeof(banner) - 1) > 0);
+    // テキストを区切ってから流し始める
+    const uint8_t delimiter = 0;
+    assert(write(master, &delimiter, 1) == 1);
+    for (uint32_t i = 0; i < FRAMES; i++) {
+      auto frame = makeFrame(i * 1000);
+      channel.publish(frame);
+      TelemetryFrame sent{};
+      assert(channel.receive(sent));
+      auto size = telemetry::encode(sent, buffer);
+      std::size_t written = 0;
+      while (written < size) {
+        auto result = write(master, buffer + written, size - written);
+        assert(result > 0);
+        written += static_cast<std::size_t>(result);
+      }
+    }
+  });
+
+  auto out = tmpfile();
+  assert(out != nullptr);
+  telemetry::Decoder decoder;
+  telemetry::print_csv_header(out);
+  while (decoder.frames() < FRAMES && telemetry::pump(slave, decoder, out)) {
+  }
+  sender.join();
+  close(slave);
+  close(master);
+
+  // CSVを読み返す
+  rewind(out);
+  char line[512];
+  uint32_t lines = 0;
+  unsigned sequence = 0, timestamp = 0;
+  double profile_motion = 0.0;
+  while (fgets(line, sizeof(line), out) != nullptr) {
+    if (lines == 0) {
+      assert(std::strstr(line, ",prof_motion\n") != nullptr);
+    }
+    if (lines == FRAMES) {
+      assert(std::sscanf(line, "%u,%u,", &sequence, &timestamp) == 2);
+      // 最後の列は計測区間の最後 (motion) の所要時間 [us]
+      profile_motion = std::atof(std::strrchr(line, ',') + 1);
+    }
+    lines++;
+  }
+  fclose(out);
+  printf("pty: %u frames, %u errors, %u lost, %u lines\n", decoder.frames(), decoder.errors(), decoder.lost(),
+         lines);
+  assert(decoder.frames() == FRAMES);
+  // 先頭のテキスト
+  assert(decoder.errors() == 1);
+  assert(decoder.lost() == 0);
+  // ヘッダー + フレーム
+  assert(lines == FRAMES + 1);
+  assert(sequence == FRAMES - 1 && timestamp == (FRAMES - 1) * 1000);
+  assert(profile_motion > 12.29 && profile_motion < 12.31);
+}
+
+int main() {
+  testCobs();
+  testDecoder();
+  testChannel();
+  testPty();
+  printf("OK\n");
+  return 0;
+}
@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "../../main/parameters.h"
+#include "../../main/pid.h"
+#include "../../main/wall_control.h"
+
+// 制御周期 [s]
+static constexpr float DT = 1.0f / static_cast<float>(CONTROL_FREQUENCY);
+// 区画中心での壁センサの値
+static constexpr int REFERENCE = 1000;
+// 区画中心から側壁の表面までの距離 [mm]
+static constexpr float SIDE_WALL = (MAZE_SECTION_SIZE - MAZE_WALL_THICKNESS) / 2.0f;
+// 45度センサの取り付け位置 (車体中心から前方・左右) [mm]
+static constexpr float SENSOR_FORWARD = 20.0f;
+static constexpr float SENSOR_SIDE = 15.0f;
+// 区画中心での45度センサから側壁までの距離 [mm]
+static constexpr float SENSOR_NOMINAL = (SIDE_WALL - SENSOR_SIDE) * std::numbers::sqrt2_v<float>;
+// 角速度の応答の時定数 [s]
+static constexpr float TIME_CONSTANT = 0.02f;
+// 試験用の横壁制御ゲイン [(rad/s)/カウント]
+static constexpr PidGain<float> GAIN{0.003f, 0.0f, 0.0001f};
+
+/**
+ * @brief 北向きの一直線の通路 (区画ごとの側壁の有無、柱は常にある)
+ * @details 車体中心の位置はx (右が正)・y (前が正) [mm]、向きはyからの角度 [rad] (左回りが正)
+ */
+struct Corridor {
+  std::vector<bool> left, right;
+
+  // 壁の表面のy [mm] に壁か柱があるか
+  bool wall(const std::vector<bool> &walls, float y) const {
+    if (std::abs(std::remainder(y - MAZE_SECTION_SIZE / 2.0f, MAZE_SECTION_SIZE)) < MAZE_WALL_THICKNESS / 2.0f) {
+      return true;
+    }
+    auto cell = static_cast<int>(std::round(y / MAZE_SECTION_SIZE));
+    return cell >= 0 && cell < static_cast<int>(walls.size()) && walls[static_cast<std::size_t>(cell)];
+  }
+};
+
+struct Robot {
+  float x, y, heading, angular_velocity;
+};
+
+// 壁有無をヒステリシス付きで判定する45度センサ
+struct SideSensor {
+  bool left;
+  bool exist = false;
+
+  // 反射光は距離の2乗に反比例する
+  int raw(const Corridor &corridor, const Robot &robot) const {
+    auto sign = left ? -1.0f : 1.0f;
+    auto h = robot.heading;
+    auto px = robot.x - SENSOR_FORWARD * std::sin(h) + sign * SENSOR_SIDE * std::cos(h);
+    auto py = robot.y + SENSOR_FORWARD * std::cos(h) + sign * SENSOR_SIDE * std::sin(h);
+    auto direction = h - sign * std::numbers::pi_v<float> / 4.0f;
+    auto dx = -std::sin(direction);
+    auto dy = std::cos(direction);
+    auto t = (sign * SIDE_WALL - px) / dx;
+    if (t <= 0.0f || !corridor.wall(left ? corridor.left : corridor.right, py + t * dy)) return 0;
+    return static_cast<int>(static_cast<float>(REFERENCE) * (SENSOR_NOMINAL / t) * (SENSOR_NOMINAL / t));
+  }
+
+  // 偏差 (Sensor::updateWallと同じく壁がなければ0)
+  int update(int value) {
+    exist = value > (exist ? REFERENCE / 3 - 50 : REFERENCE / 3 + 50);
+    return exist ? value - REFERENCE : 0;
+  }
+};
+
+struct Drive {
+  // 横ずれの最大値 [mm]
+  float max_lateral;
+  // 最後の横ずれ [mm]
+  float final_lateral;
+  // 補正量の最大値 [rad/s]
+  float max_correction;
+  // 補正した周期の数
+  int active;
+};
+
+/**
+ * @brief 通路を一定速度で直進する
+ * @param drift 角速度のずれ [rad/s] (車輪径の左右差など)
+ */
+static Drive drive(const Corridor &corridor, SideWallControl &control, float velocity, float x, float heading,
+                   float drift, float noise) {
+  std::mt19937 engine(50);
+  std::normal_distribution<float> distribution(0.0f, noise);
+  Robot robot{x, 0.0f, heading, 0.0f};
+  SideSensor left{true}, right{false};
+  Drive result{0.0f, 0.0f, 0.0f, 0};
+  control.reset();
+  auto goal = static_cast<float>(corridor.left.size() - 1) * MAZE_SECTION_SIZE;
+  while (robot.y < goal) {
+    auto read = [&](const SideSensor &sensor) {
+      return std::max(sensor.raw(corridor, robot) + static_cast<int>(distribution(engine)), 0);
+    };
+    SideWallControl::Observation observation{};
+    observation.left = left.update(read(left));
+    observation.right = right.update(read(right));
+    observation.left_exist = left.exist;
+    observation.right_exist = right.exist;
+    auto correction = control.update(observation, velocity, DT);
+    result.max_correction = std::max(result.max_correction, std::abs(correction));
+    if (control.active()) result.active++;
+
+    // 目標の角速度は0に補正を足したもの
+    robot.angular_velocity += (correction + drift - robot.angular_velocity) * DT / TIME_CONSTANT;
+    robot.heading += robot.angular_velocity * DT;
+    robot.x += -std::sin(robot.heading) * velocity * 1000.0f * DT;
+    robot.y += std::cos(robot.heading) * velocity * 1000.0f * DT;
+    result.max_lateral = std::max(result.max_lateral, std::abs(robot.x));
+  }
+  result.final_lateral = robot.x;
+  return result;
+}
+
+// 区画中心からずれて傾いて始め、角速度がずれていても壁に当たらず中心に戻る
+static void testDrift() {
+  Corridor corridor{
+      {true, true, false, true, true, true, false, false, true, true, true, true, false, true, true, true},
+      {true, true, true, true, false, true, true, true, true, false, false, true, true, true, false, true},
+  };
+  SideWallControl off({0.0f, 0.0f, 0.0f}, true);
+  auto open = drive(corridor, off, 0.6f, 5.0f, 0.02f, 0.03f, 3.0f);
+  SideWallControl control(GAIN, true);
+  auto closed = drive(corridor, control, 0.6f, 5.0f, 0.02f, 0.03f, 3.0f);
+  printf("drift: lateral max %.2f mm, final %.2f mm (without %.2f mm, %.2f mm), correction %.3f rad/s\n",
+         static_cast<double>(closed.max_lateral), static_cast<double>(closed.final_lateral),
+         static_cast<double>(open.max_lateral), static_cast<double>(open.final_lateral),
+         static_cast<double>(closed.max_correction));
+  // 車体の幅を考えると、補正がなければ壁に当たる
+  assert(open.max_lateral > 20.0f);
+  assert(closed.max_lateral < 6.0f);
+  assert(std::abs(closed.final_lateral) < 1.5f);
+  assert(closed.max_correction <= WALL_ADJUST_SIDE_LIMIT);
+}
+
+// 片側ずつ壁が抜けて柱だけになっても、柱で曲がらない
+static void testPosts() {
+  Corridor corridor{
+      {true, false, true, false, true, false, true, false, true, false, true},
+      {true, true, false, true, false, true, false, true, false, true, true},
+  };
+  SideWallControl control(GAIN, true);
+  auto result = drive(corridor, control, 0.6f, 2.0f, 0.0f, 0.0f, 0.0f);
+  printf("posts: lateral max %.3f mm, final %.3f mm, active %d ticks\n", static_cast<double>(result.max_lateral),
+         static_cast<double>(result.final_lateral), result.active);
+  // 始めのずれより外に振られず、中心に戻る
+  assert(result.max_lateral < 2.05f);
+  assert(std::abs(result.final_lateral) < 0.5f);
+  // 片側だけの区画でも補正を続ける
+  assert(result.active > 1000);
+}
+
+// 壁がない・遅い・未調整の場合は何もしない
+static void testInactive() {
+  Corridor corridor{std::vector<bool>(6, false), std::vector<bool>(6, false)};
+  SideWallControl control(GAIN, true);
+  auto none = drive(corridor, control, 0.6f, 5.0f, 0.0f, 0.0f, 0.0f);
+  assert(none.active == 0);
+
+  SideWallControl::Observation observation{200, -200, true, true};
+  for (int i = 0; i < 100; i++) {
+    assert(std::abs(control.update(observation, WALL_ADJUST_MIN_VELOCITY / 2.0f, DT)) < 1e-9f);
+    assert(std::abs(control.update(observation, -0.3f, DT)) < 1e-9f);
+  }
+  SideWallControl uncalibrated(GAIN, false);
+  for (int i = 0; i < 100; i++) {
+    assert(std::abs(uncalibrated.update(observation, 0.6f, DT)) < 1e-9f);
+  }
+  assert(!uncalibrated.active());
+
+  // 壁が見え始めてからしばらくは使わない
+  SideWallControl edge(GAIN, true);
+  edge.update({0, 0, false, false}, 0.6f, DT);
+  int ticks = 0;
+  while (!edge.active()) {
+    edge.update({0, 100, false, true}, 0.6f, DT);
+    ticks++;
+  }
+  auto expected = WALL_ADJUST_MASK_LENGTH / (0.6f * 1000.0f * DT);
+  assert(std::abs(static_cast<float>(ticks) - expected) <= 2.0f);
+  // 右に寄っていれば左に回す
+  assert(edge.error() > 0.0f);
+  assert(edge.update({0, 100, false, true}, 0.6f, DT) > 0.0f);
+  printf("inactive: ok (%d ticks after edge)\n", ticks);
+}
+
+// ターン後にずれて止まった状態から、前壁に向きと距離を合わせる
+static void testFrontAlign(float offset, float heading) {
+  // 区画中心での車体中心から前壁までの距離 [mm]
+  constexpr float CENTER = (MAZE_SECTION_SIZE - MAZE_WALL_THICKNESS) / 2.0f;
+  auto front = [](float d) { return static_cast<int>(static_cast<float>(REFERENCE) * (CENTER / d) * (CENTER / d)); };
+
+  FrontWallAlignment alignment(REFERENCE, REFERENCE);
+  // 区画中心からの前後方向の位置 [mm] (前壁に近いほど正)
+  float position = offset;
+  float velocity = 0.0f, angular_velocity = 0.0f;
+  int ticks = 0;
+  while (!alignment.finished() && ticks < static_cast<int>(WALL_ALIGN_TIMEOUT / DT)) {
+    auto d = CENTER - position;
+    auto left = (d + WALL_FRONT_SENSOR_SPACING / 2.0f * std::sin(heading)) / std::cos(heading);
+    auto right = (d - WALL_FRONT_SENSOR_SPACING / 2.0f * std::sin(heading)) / std::cos(heading);
+    auto command = alignment.update(front(left), front(right), true);
+    velocity += (command.velocity - velocity) * DT / TIME_CONSTANT;
+    angular_velocity += (command.angular_velocity - angular_velocity) * DT / TIME_CONSTANT;
+    position += velocity * 1000.0f * DT * std::cos(heading);
+    heading += angular_velocity * DT;
+    ticks++;
+  }
+  printf("front align: %d ticks, distance %.3f mm, heading %.4f rad\n", ticks, static_cast<double>(position),
+         static_cast<double>(heading));
+  assert(alignment.finished());
+  assert(std::abs(position) < 1.5f);
+  assert(std::abs(heading) < 0.015f);
+}
+
+// 前壁がない・未調整の場合はすぐに終わる
+static void testFrontMissing() {
+  FrontWallAlignment alignment(REFERENCE, REFERENCE);
+  auto command = alignment.update(0, 0, false);
+  assert(alignment.finished());
+  assert(std::abs(command.velocity) < 1e-9f && std::abs(command.angular_velocity) < 1e-9f);
+  FrontWallAlignment uncalibrated(0, 0);
+  uncalibrated.update(REFERENCE, REFERENCE, true);
+  assert(uncalibrated.finished());
+  alignment.reset();
+  assert(!alignment.finished());
+}
+
+int main() {
+  testDrift();
+  testPosts();
+  testInactive();
+  // 前壁から離れて左に回っている
+  testFrontAlign(-6.0f, 0.08f);
+  // 前壁に近く右に回っている
+  testFrontAlign(4.0f, -0.05f);
+  testFrontMissing();
+  printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <optional>
+#include <vector>
+
+namespace slalom {
+// ターンの形 (右ターン、車体の向きは+yから時計回り)
+struct Shape {
+  // 名前 (テーブルの識別子に使う)
+  const char *name;
+  // 角度 [rad]
+  double angle;
+  // 開始位置から、開始時と終了時の進行方向の直線が交わる点までの距離 [m] (180度の場合は0)
+  double entry;
+  // 交わる点から終了位置までの距離 [m] (180度の場合は0)
+  double exit;
+  // 180度の場合の左右の幅 [m]
+  double width;
+};
+
+// 速度ごとのターン
+struct Turn {
+  // 速度 [m/s]
+  double velocity;
+  // 最大曲率 [1/m]
+  double curvature;
+  // クロソイドの長さ [m]
+  double clothoid;
+  // 円弧の長さ [m]
+  double arc;
+  // ターン前後の直線 [m]
+  double before, after;
+  // 制御周期ごとの角速度 [rad/s]
+  std::vector<double> angular_velocity;
+};
+
+// 曲率の変化: 0からcurvatureまでclothoid、curvatureのままarc、curvatureから0までclothoid
+class Curve {
+ public:
+  Curve(double curvature, double clothoid, double arc) : curvature_(curvature), clothoid_(clothoid), arc_(arc) {}
+
+  [[nodiscard]] double length() const { return 2.0 * clothoid_ + arc_; }
+  [[nodiscard]] double clothoid() const { return clothoid_; }
+  [[nodiscard]] double arc() const { return arc_; }
+
+  // 始点からの距離sまでに曲がった角度
+  [[nodiscard]] double heading(double s) const {
+    if (s <= 0.0) return 0.0;
+    if (clothoid_ > 0.0 && s < clothoid_) return curvature_ * s * s / (2.0 * clothoid_);
+    auto angle = curvature_ * clothoid_ / 2.0;
+    s -= clothoid_;
+    if (s < arc_) return angle + curvature_ * s;
+    angle += curvature_ * arc_;
+    s -= arc_;
+    if (s >= clothoid_) return angle + curvature_ * clothoid_ / 2.0;
+    return angle + curvature_ * s - curvature_ * s * s / (2.0 * clothoid_);
+  }
+
+  // 終点の位置 (数値積分)
+  void end(double &x, double &y) const {
+    constexpr int STEPS = 20'000;
+    auto ds = length() / STEPS;
+    x = 0.0;
+    y = 0.0;
+    for (int i = 0; i < STEPS; i++) {
+      auto phi = heading((i + 0.5) * ds);
+      x += std::sin(phi) * ds;
+      y += std::cos(phi) * ds;
+    }
+  }
+
+ private:
+  double curvature_, clothoid_, arc_;
+};
+
+/**
+ * @brief 速度ごとのターンを作る
+ * @param wheel_acceleration タイヤの接線加速度の上限 [m/s^2] (角加速度の上限はこれとトレッドから決まる)
+ * @param tread トレッド [m]
+ * @param frequency 制御周波数 [Hz]
+ * @return 角加速度の上限ではターンの大きさに収まらない場合はnullopt
+ */
+inline std::optional<Turn> design(const Shape &shape, double velocity, double wheel_acceleration, double tread,
+                                  double frequency) {
+  // 角加速度 v^2 dκ/ds の上限
+  auto angular_acceleration = 2.0 * wheel_acceleration / tread;
+  auto v2 = velocity * velocity;
+  auto make = [&](double curvature) {
+    // クロソイドで曲率を上げきる長さ
+    auto clothoid = v2 * curvature / angular_acceleration;
+    auto arc = shape.angle / curvature - clothoid;
+    if (arc < 0.0) {
+      // 円弧がなくなる場合はクロソイドだけで曲がる
+      clothoid = shape.angle / curvature;
+      arc = 0.0;
+    }
+    return Curve(curvature, clothoid, arc);
+  };
+  // ターンの大きさ (曲率が大きいほど小さい)
+  auto size = [&](double curvature) {
+    double x, y;
+    make(curvature).end(x, y);
+    if (shape.width > 0.0) return x;
+    return y - x * std::cos(shape.angle) / std::sin(shape.angle);
+  };
+  auto target = shape.width > 0.0 ? shape.width : std::min(shape.entry, shape.exit);
+
+  // 角加速度の上限で取れる最大の曲率 (円弧なし)
+  auto max_curvature = std::sqrt(shape.angle * angular_acceleration) / velocity;
+  if (size(max_curvature) > target) return std::nullopt;
+  auto low = 1e-3, high = max_curvature;
+  for (int i = 0; i < 60; i++) {
+    auto mid = (low + high) / 2.0;
+    if (size(mid) > target) {
+      low = mid;
+    } else {
+      high = mid;
+    }
+  }
+  auto curvature = high;
+  auto curve = make(curvature);
+
+  Turn turn{};
+  turn.velocity = velocity;
+  turn.curvature = curvature;
+  turn.clothoid = curve.clothoid();
+  turn.arc = curve.arc();
+  if (shape.width > 0.0) {
+    turn.before = 0.0;
+    turn.after = 0.0;
+  } else {
+    turn.before = shape.entry - target;
+    turn.after = shape.exit - target;
+  }
+
+  // 制御周期ごとの平均の角速度 (合計が角度に一致する)
+  auto dt = 1.0 / frequency;
+  auto ticks = static_cast<std::size_t>(std::ceil(curve.length() / (velocity * dt) - 1e-9));
+  for (std::size_t i = 0; i < ticks; i++) {
+    auto s0 = velocity * dt * static_cast<double>(i);
+    auto s1 = std::min(velocity * dt * static_cast<double>(i + 1), curve.length());
+    turn.angular_velocity.push_back((curve.heading(s1) - curve.heading(s0)) / dt);
+  }
+  // 最後の周期ではみ出す分を後の直線から引く
+  auto overrun = velocity * dt * static_cast<double>(ticks) - curve.length();
+  turn.after = std::max(turn.after - overrun, 0.0);
+  return turn;
+}
+}  // namespace slalom
@@ -0,0 +1,121 @@
+// スラロームのテーブル生成ツール
+// 使い方: slalom-generator [output.h]
+// parameters.hの速度・加速度の上限とトレッドから、制御周期ごとの角速度のテーブルを作る
+
+#include <cstdio>
+#include <iterator>
+#include <numbers>
+
+#include "../../main/parameters.h"
+#include "generator.h"
+
+// 区画の大きさ [m]
+static constexpr double SECTION = static_cast<double>(MAZE_SECTION_SIZE) / 1000.0;
+// 斜めの半区画 [m]
+static constexpr double DIAGONAL = SECTION / 2.0 * std::numbers::sqrt2;
+
+// ターンの形 (区画の辺の中央から、区画の辺の中央へ)
+static constexpr slalom::Shape SHAPES[] = {
+    // 小回り90度 (探索)
+    {"TURN_90", std::numbers::pi / 2.0, SECTION / 2.0, SECTION / 2.0, 0.0},
+    // 大回り90度
+    {"TURN_LARGE_90", std::numbers::pi / 2.0, SECTION, SECTION, 0.0},
+    // 大回り180度
+    {"TURN_180", std::numbers::pi, 0.0, 0.0, SECTION},
+    // 直進から斜めへ45度
+    {"TURN_45_IN", std::numbers::pi / 4.0, SECTION, DIAGONAL, 0.0},
+    // 斜めから直進へ45度
+    {"TURN_45_OUT", std::numbers::pi / 4.0, DIAGONAL, SECTION, 0.0},
+    // 直進から斜めへ135度
+    {"TURN_135_IN", std::numbers::pi * 3.0 / 4.0, SECTION, DIAGONAL, 0.0},
+    // 斜めから直進へ135度
+    {"TURN_135_OUT", std::numbers::pi * 3.0 / 4.0, DIAGONAL, SECTION, 0.0},
+    // 斜めから斜めへ90度
+    {"TURN_V90", std::numbers::pi / 2.0, DIAGONAL, DIAGONAL, 0.0},
+};
+
+// floatのリテラルとして出力する (整数値でも小数点を付ける)
+static const char *literal(double value, int digits = 9) {
+  static char buffers[8][32];
+  static std::size_t index = 0;
+  auto &buffer = buffers[index++ % std::size(buffers)];
+  auto size = snprintf(buffer, sizeof(buffer), "%.*g", digits, value);
+  auto has_point = false;
+  for (auto i = 0; i < size; i++) {
+    if (buffer[i] == '.' || buffer[i] == 'e') has_point = true;
+  }
+  snprintf(buffer + size, sizeof(buffer) - static_cast<std::size_t>(size), "%s", has_point ? "f" : ".0f");
+  return buffer;
+}
+
+int main(int argc, char **argv) {
+  auto out = argc > 1 ? fopen(argv[1], "w") : stdout;
+  if (out == nullptr) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  fprintf(out, "#pragma once\n\n");
+  fprintf(out, "// tools/slalomで生成 (手で編集しないこと)\n");
+  fprintf(out, "// 制御周波数 %u Hz, トレッド %g mm, 遠心加速度 %g m/s^2, 接線加速度 %g m/s^2\n\n",
+          static_cast<unsigned>(CONTROL_FREQUENCY), static_cast<double>(TREAD_WIDTH),
+          static_cast<double>(SLALOM_LATERAL_ACCELERATION_LIMIT), static_cast<double>(SLALOM_WHEEL_ACCELERATION_LIMIT));
+  fprintf(out, "namespace slalom {\n");
+  fprintf(out, "// 生成した時の制御周波数 [Hz]\n");
+  fprintf(out, "inline constexpr uint32_t GENERATED_FREQUENCY = %u;\n\n", static_cast<unsigned>(CONTROL_FREQUENCY));
+  fprintf(out, "// ターンの種類\n");
+  fprintf(out, "enum Type : uint8_t {\n");
+  for (const auto &shape : SHAPES) {
+    fprintf(out, "  %s,\n", shape.name);
+  }
+  fprintf(out, "  NUM_TYPES,\n};\n\n");
+  fprintf(out, "// 速度の数\n");
+  fprintf(out, "inline constexpr std::size_t NUM_VELOCITIES = %zu;\n\n", std::size(SLALOM_VELOCITIES));
+
+  // 速度ごとに角速度のテーブルを出力し、まとめた表を後で出力する
+  char tables[std::size(SHAPES)][std::size(SLALOM_VELOCITIES)][256];
+  for (std::size_t i = 0; i < std::size(SHAPES); i++) {
+    const auto &shape = SHAPES[i];
+    for (std::size_t j = 0; j < std::size(SLALOM_VELOCITIES); j++) {
+      auto velocity = static_cast<double>(SLALOM_VELOCITIES[j]);
+      auto name = static_cast<unsigned>(velocity * 1000.0 + 0.5);
+      auto tread = static_cast<double>(TREAD_WIDTH) / 1000.0;
+      auto turn = slalom::design(shape, velocity, SLALOM_WHEEL_ACCELERATION_LIMIT, tread, CONTROL_FREQUENCY);
+      auto lateral = turn ? velocity * velocity * turn->curvature : 0.0;
+      if (!turn || lateral > static_cast<double>(SLALOM_LATERAL_ACCELERATION_LIMIT)) {
+        fprintf(stderr, "%s at %g m/s: skipped (%s)\n", shape.name, velocity,
+                turn ? "lateral acceleration" : "angular acceleration");
+        snprintf(tables[i][j], sizeof(tables[i][j]), "{%s, 0.0f, 0.0f, %s, 0, nullptr}", literal(velocity, 6),
+                 literal(shape.angle));
+        continue;
+      }
+      fprintf(stderr, "%s at %g m/s: radius %.1f mm, clothoid %.1f mm, arc %.1f mm, lateral %.2f m/s^2\n",
+              shape.name, velocity, 1000.0 / turn->curvature, turn->clothoid * 1000.0, turn->arc * 1000.0, lateral);
+      fprintf(out, "// 半径 %.1f mm, クロソイド %.1f mm, 円弧 %.1f mm, 遠心加速度 %.2f m/s^2\n",
+              1000.0 / turn->curvature, turn->clothoid * 1000.0, turn->arc * 1000.0, lateral);
+      fprintf(out, "inline constexpr float %s_%u[] = {", shape.name, name);
+      for (std::size_t k = 0; k < turn->angular_velocity.size(); k++) {
+        fprintf(out, "%s%s,", k % 8 == 0 ? "\n    " : " ", literal(turn->angular_velocity[k]));
+      }
+      fprintf(out, "\n};\n\n");
+      snprintf(tables[i][j], sizeof(tables[i][j]), "{%s, %s, %s, %s, std::size(%s_%u), %s_%u}", literal(velocity, 6),
+               literal(turn->before * 1000.0), literal(turn->after * 1000.0), literal(shape.angle), shape.name, name,
+               shape.name, name);
+    }
+  }
+
+  fprintf(out, "// ターンの種類と速度ごとのテーブル\n");
+  fprintf(out, "inline constexpr Table TABLES[NUM_TYPES][NUM_VELOCITIES] = {\n");
+  for (std::size_t i = 0; i < std::size(SHAPES); i++) {
+    fprintf(out, "    // %s\n    {\n", SHAPES[i].name);
+    for (std::size_t j = 0; j < std::size(SLALOM_VELOCITIES); j++) {
+      fprintf(out, "        %s,\n", tables[i][j]);
+    }
+    fprintf(out, "    },\n");
+  }
+  fprintf(out, "};\n");
+  fprintf(out, "}  // namespace slalom\n");
+
+  if (out != stdout) fclose(out);
+  return 0;
+}
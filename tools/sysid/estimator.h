@@ -0,0 +1,334 @@
+#pragma once
+
+// C++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Project
+#include "../../main/sysid.h"
+
+namespace sysid {
+// 1つの信号の記録 (入力は軸の電圧、出力は軸の速度)
+struct Series {
+  Signal signal;
+  Axis axis;
+  // 入力 [V] (並進は左右の平均、旋回は左右の差の半分)
+  std::vector<double> input;
+  // 出力 [m/s] または [rad/s]
+  std::vector<double> output;
+};
+
+// 1次遅れ K / (T s + 1) (入力から摩擦電圧を引く)
+struct FirstOrder {
+  // ゲイン [(m/s)/V] または [(rad/s)/V]
+  double gain;
+  // 時定数 [s]
+  double time_constant;
+  // 摩擦電圧 [V]
+  double friction;
+  // 当てはまり [%] (100で完全に一致)
+  double fit;
+};
+
+// 2次遅れ K ωn^2 / (s^2 + 2 ζ ωn s + ωn^2) (入力から摩擦電圧を引く)
+struct SecondOrder {
+  // ゲイン
+  double gain;
+  // 固有角周波数 [rad/s]
+  double natural_frequency;
+  // 減衰比
+  double damping;
+  // 摩擦電圧 [V]
+  double friction;
+  // 当てはまり [%]
+  double fit;
+};
+
+// PIDゲイン
+struct Gain {
+  double kp, ki, kd;
+};
+
+/**
+ * @brief Identification::print()の出力を読む
+ * @details ログなどの関係ない行は読み飛ばす
+ * @param frequency 制御周波数 [Hz] (見つからなければ変えない)
+ * @return 読めた信号の数
+ */
+inline std::size_t read(FILE *in, std::vector<Series> &series, double &frequency) {
+  char line[256];
+  long current = -1;
+  while (fgets(line, sizeof(line), in) != nullptr) {
+    unsigned value;
+    if (std::sscanf(line, "# sysid %u", &value) == 1) {
+      frequency = value;
+      continue;
+    }
+    unsigned run;
+    char signal[16], axis[16];
+    double right, left, velocity, angular_velocity;
+    if (std::sscanf(line, "%u,%15[a-z],%15[a-z],%lf,%lf,%lf,%lf", &run, signal, axis, &right, &left, &velocity,
+                    &angular_velocity) != 7) {
+      continue;
+    }
+    if (static_cast<long>(run) != current) {
+      current = run;
+      Series s{};
+      s.signal = std::strcmp(signal, name(Signal::Step)) == 0   ? Signal::Step
+                 : std::strcmp(signal, name(Signal::Prbs)) == 0 ? Signal::Prbs
+                                                                : Signal::Chirp;
+      s.axis = std::strcmp(axis, name(Axis::Translation)) == 0 ? Axis::Translation : Axis::Rotation;
+      series.push_back(s);
+    }
+    auto &s = series.back();
+    if (s.axis == Axis::Translation) {
+      s.input.push_back((right + left) / 2.0);
+      s.output.push_back(velocity);
+    } else {
+      s.input.push_back((right - left) / 2.0);
+      s.output.push_back(angular_velocity);
+    }
+  }
+  return series.size();
+}
+
+/**
+ * @brief 最小二乗法 (正規方程式をガウスの消去法で解く)
+ * @details 操作変数を渡すと操作変数法になる (回帰ベクトルの雑音と相関しない変数で偏りを除く)
+ * @tparam M パラメータの数
+ */
+template <std::size_t M>
+class LeastSquares {
+ public:
+  explicit LeastSquares() : matrix_(), vector_() {}
+
+  void add(const std::array<double, M> &regressor, double output) { add(regressor, output, regressor); }
+  void add(const std::array<double, M> &regressor, double output, const std::array<double, M> &instrument) {
+    for (std::size_t i = 0; i < M; i++) {
+      for (std::size_t j = 0; j < M; j++) matrix_[i][j] += instrument[i] * regressor[j];
+      vector_[i] += instrument[i] * output;
+    }
+  }
+
+  // 解けない (入力が足りない) 場合はfalse
+  bool solve(std::array<double, M> &parameter) const {
+    auto a = matrix_;
+    auto b = vector_;
+    for (std::size_t k = 0; k < M; k++) {
+      auto pivot = k;
+      for (std::size_t i = k + 1; i < M; i++) {
+        if (std::abs(a[i][k]) > std::abs(a[pivot][k])) pivot = i;
+      }
+      if (std::abs(a[pivot][k]) < 1e-12) return false;
+      std::swap(a[k], a[pivot]);
+      std::swap(b[k], b[pivot]);
+      for (std::size_t i = k + 1; i < M; i++) {
+        auto ratio = a[i][k] / a[k][k];
+        for (std::size_t j = k; j < M; j++) a[i][j] -= ratio * a[k][j];
+        b[i] -= ratio * b[k];
+      }
+    }
+    for (std::size_t k = M; k-- > 0;) {
+      auto sum = b[k];
+      for (std::size_t j = k + 1; j < M; j++) sum -= a[k][j] * parameter[j];
+      parameter[k] = sum / a[k][k];
+    }
+    return true;
+  }
+
+ private:
+  std::array<std::array<double, M>, M> matrix_;
+  std::array<double, M> vector_;
+};
+
+// 静止摩擦の向き (止まっている間は0)
+inline double direction(double output, double threshold) {
+  return std::abs(output) < threshold ? 0.0 : std::copysign(1.0, output);
+}
+
+// 止まっているとみなす速度 (出力の最大値に対する割合)
+inline constexpr double STATIONARY_RATIO = 0.02;
+// 操作変数法の繰り返し回数
+inline constexpr int INSTRUMENT_ITERATIONS = 5;
+
+inline double stationary(const std::vector<const Series *> &series) {
+  double peak = 0.0;
+  for (const auto *s : series) {
+    for (auto y : s->output) peak = std::max(peak, std::abs(y));
+  }
+  return peak * STATIONARY_RATIO;
+}
+
+/**
+ * @brief N次のARXモデル
+ * @details
+ * y[k+1] = Σ a_i y[k+1-i] + Σ b_i u[k+1-i] + c sgn(y[k]) (i = 1..N)
+ * パラメータは {a_1..a_N, b_1..b_N, c} の順に並べる。
+ * 記録ではu[k]をかける直前にy[k]を測っているので、uからyまでに1周期の遅れはない。
+ */
+template <std::size_t N>
+struct Arx {
+  static constexpr std::size_t SIZE = 2 * N + 1;
+  using Parameter = std::array<double, SIZE>;
+
+  static Parameter regressor(const std::vector<double> &y, const std::vector<double> &u, std::size_t k,
+                             double threshold) {
+    Parameter r{};
+    for (std::size_t i = 0; i < N; i++) {
+      r[i] = y[k - i];
+      r[N + i] = u[k - i];
+    }
+    r[2 * N] = direction(y[k], threshold);
+    return r;
+  }
+
+  // 入力だけから出力を計算する (最初のN個は記録の値)
+  static std::vector<double> simulate(const Series &s, const Parameter &p, double threshold) {
+    auto y = s.output;
+    for (std::size_t k = N - 1; k + 1 < y.size(); k++) {
+      auto r = regressor(y, s.input, k, threshold);
+      double next = 0.0;
+      for (std::size_t i = 0; i < SIZE; i++) next += p[i] * r[i];
+      y[k + 1] = next;
+    }
+    return y;
+  }
+
+  /**
+   * @brief 最小二乗法で解いた後、そのモデルの出力を操作変数にして解き直す
+   * @details
+   * 測定雑音が回帰ベクトルに入ると最小二乗法の解は偏る (制御周期が時定数より十分短いと特に大きい)。
+   * モデルの出力は雑音と相関しないので、操作変数にすると偏りが消える。
+   */
+  static bool estimate(const std::vector<const Series *> &series, double threshold, Parameter &p) {
+    LeastSquares<SIZE> ls;
+    for (const auto *s : series) {
+      for (std::size_t k = N - 1; k + 1 < s->output.size(); k++) {
+        ls.add(regressor(s->output, s->input, k, threshold), s->output[k + 1]);
+      }
+    }
+    if (!ls.solve(p)) return false;
+    for (int iteration = 0; iteration < INSTRUMENT_ITERATIONS; iteration++) {
+      LeastSquares<SIZE> iv;
+      for (const auto *s : series) {
+        auto instrument = simulate(*s, p, threshold);
+        for (auto y : instrument) {
+          // 不安定なモデルは操作変数にできない
+          if (!std::isfinite(y)) return true;
+        }
+        for (std::size_t k = N - 1; k + 1 < s->output.size(); k++) {
+          iv.add(regressor(s->output, s->input, k, threshold), s->output[k + 1],
+                 regressor(instrument, s->input, k, threshold));
+        }
+      }
+      Parameter candidate{};
+      if (!iv.solve(candidate)) break;
+      p = candidate;
+    }
+    return true;
+  }
+
+  /**
+   * @brief 当てはまり [%]
+   * @details 100 (1 - |y - ŷ| / |y - mean(y)|)、ŷは入力だけから計算した出力
+   */
+  static double fitness(const std::vector<const Series *> &series, const Parameter &p, double threshold) {
+    double sum = 0.0, count = 0.0;
+    for (const auto *s : series) {
+      for (auto y : s->output) {
+        sum += y;
+        count += 1.0;
+      }
+    }
+    auto mean = count > 0.0 ? sum / count : 0.0;
+    double error = 0.0, variance = 0.0;
+    for (const auto *s : series) {
+      auto estimate = simulate(*s, p, threshold);
+      for (std::size_t k = 0; k < estimate.size(); k++) {
+        error += (s->output[k] - estimate[k]) * (s->output[k] - estimate[k]);
+        variance += (s->output[k] - mean) * (s->output[k] - mean);
+      }
+    }
+    return variance > 0.0 ? 100.0 * (1.0 - std::sqrt(error / variance)) : 0.0;
+  }
+};
+
+/**
+ * @brief 1次遅れを当てはめる
+ * @details a = exp(-dt / T), b = K (1 - a), c = -K Vf (1 - a) から連続時間のパラメータに戻す
+ */
+inline bool fit_first_order(const std::vector<const Series *> &series, double dt, FirstOrder &model) {
+  auto threshold = stationary(series);
+  Arx<1>::Parameter p{};
+  if (!Arx<1>::estimate(series, threshold, p)) return false;
+  auto [a, b, c] = p;
+  if (a <= 0.0 || a >= 1.0 || std::abs(b) < 1e-12) return false;
+  model.gain = b / (1.0 - a);
+  model.time_constant = -dt / std::log(a);
+  model.friction = -c / b;
+  model.fit = Arx<1>::fitness(series, p, threshold);
+  return true;
+}
+
+/**
+ * @brief 2次遅れを当てはめる
+ * @details
+ * 離散時間の極 z から s = ln(z) / dt で連続時間の極に戻す。実数の極でも2つの時定数の和と積から
+ * 固有角周波数と減衰比を求める (減衰比が1以上になる)。
+ */
+inline bool fit_second_order(const std::vector<const Series *> &series, double dt, SecondOrder &model) {
+  auto threshold = stationary(series);
+  Arx<2>::Parameter p{};
+  if (!Arx<2>::estimate(series, threshold, p)) return false;
+  auto [a1, a2, b1, b2, c] = p;
+  auto b = b1 + b2;
+  if (std::abs(1.0 - a1 - a2) < 1e-12 || std::abs(b) < 1e-12) return false;
+
+  // z^2 - a1 z - a2 = 0
+  auto root = std::sqrt(std::complex<double>(a1 * a1 + 4.0 * a2, 0.0));
+  std::complex<double> z1 = (a1 + root) / 2.0, z2 = (a1 - root) / 2.0;
+  if (std::abs(z1) >= 1.0 || std::abs(z2) >= 1.0) return false;
+  if (std::abs(z1.imag()) < 1e-12 && (z1.real() <= 0.0 || z2.real() <= 0.0)) return false;
+  auto s1 = std::log(z1) / dt, s2 = std::log(z2) / dt;
+  // (s - s1)(s - s2) = s^2 - (s1 + s2) s + s1 s2
+  auto product = (s1 * s2).real();
+  auto sum = -(s1 + s2).real();
+  if (product <= 0.0 || sum <= 0.0) return false;
+  model.gain = b / (1.0 - a1 - a2);
+  model.natural_frequency = std::sqrt(product);
+  model.damping = sum / (2.0 * model.natural_frequency);
+  model.friction = -c / b;
+  model.fit = Arx<2>::fitness(series, p, threshold);
+  return true;
+}
+
+
+/**
+ * @brief 1次遅れに対するPIゲイン (IMC / λチューニング)
+ * @details 零点で極を打ち消し、閉ループを時定数λの1次遅れにする: kp = T / (K λ), ki = 1 / (K λ)
+ */
+inline Gain tune(const FirstOrder &model, double closed_loop_time_constant) {
+  auto k = 1.0 / (model.gain * closed_loop_time_constant);
+  return {model.time_constant * k, k, 0.0};
+}
+
+/**
+ * @brief 2次遅れに対するPIDゲイン (IMC / λチューニング)
+ * @details
+ * 分母 (T1 s + 1)(T2 s + 1) を打ち消す: T1 + T2 = 2ζ/ωn, T1 T2 = 1/ωn^2 なので
+ * kp = 2ζ / (ωn K λ), ki = 1 / (K λ), kd = 1 / (ωn^2 K λ)
+ */
+inline Gain tune(const SecondOrder &model, double closed_loop_time_constant) {
+  auto k = 1.0 / (model.gain * closed_loop_time_constant);
+  auto wn = model.natural_frequency;
+  return {2.0 * model.damping / wn * k, k, k / (wn * wn)};
+}
+}  // namespace sysid
@@ -0,0 +1,95 @@
+// システム同定の解析ツール
+// 使い方: sysid-estimator [log.csv]
+// コンソールの"sysid"で取り出した記録から、並進・旋回の1次・2次遅れを当てはめ、
+// parameters.hに書くモーターの時定数・摩擦電圧とPIDゲインを出力する
+
+#include <cstdio>
+#include <vector>
+
+#include "../../main/feedforward.h"
+#include "../../main/parameters.h"
+#include "estimator.h"
+
+static const char *label(sysid::Axis axis) {
+  return axis == sysid::Axis::Translation ? "translation [(m/s)/V]" : "rotation [(rad/s)/V]";
+}
+
+int main(int argc, char **argv) {
+  auto in = argc > 1 ? fopen(argv[1], "r") : stdin;
+  if (in == nullptr) {
+    perror(argv[1]);
+    return 1;
+  }
+  std::vector<sysid::Series> series;
+  auto frequency = static_cast<double>(CONTROL_FREQUENCY);
+  sysid::read(in, series, frequency);
+  if (in != stdin) fclose(in);
+  auto dt = 1.0 / frequency;
+  auto lambda = static_cast<double>(SYSID_CLOSED_LOOP_TIME_CONSTANT);
+
+  // 軸ごとにすべての信号をまとめて当てはめる
+  sysid::FirstOrder first[2]{};
+  sysid::SecondOrder second[2]{};
+  bool found[2]{};
+  for (auto axis : {sysid::Axis::Translation, sysid::Axis::Rotation}) {
+    auto index = static_cast<std::size_t>(axis);
+    std::vector<const sysid::Series *> selected;
+    std::size_t samples = 0;
+    for (const auto &s : series) {
+      if (s.axis != axis) continue;
+      selected.push_back(&s);
+      samples += s.output.size();
+    }
+    if (selected.empty()) continue;
+    fprintf(stderr, "%s: %zu runs, %zu samples at %g Hz\n", label(axis), selected.size(), samples, frequency);
+    if (!sysid::fit_first_order(selected, dt, first[index])) {
+      fprintf(stderr, "  first order: failed\n");
+      continue;
+    }
+    found[index] = true;
+    const auto &f = first[index];
+    fprintf(stderr, "  first order : K %.4g, T %.4g s, friction %.4g V, fit %.1f %%\n", f.gain, f.time_constant,
+            f.friction, f.fit);
+    if (sysid::fit_second_order(selected, dt, second[index])) {
+      const auto &s = second[index];
+      fprintf(stderr, "  second order: K %.4g, wn %.4g rad/s, zeta %.3g, friction %.4g V, fit %.1f %%\n", s.gain,
+              s.natural_frequency, s.damping, s.friction, s.fit);
+    } else {
+      fprintf(stderr, "  second order: failed\n");
+      second[index].gain = 0.0;
+    }
+  }
+  if (!found[0] && !found[1]) {
+    fprintf(stderr, "no usable runs\n");
+    return 1;
+  }
+
+  // 理論値との比較 (逆起電圧定数とトレッドから)
+  auto expected = 1.0 / static_cast<double>(Feedforward::VELOCITY_CONSTANT);
+  printf("// tools/sysidで推定 (閉ループの時定数 %g s)\n", lambda);
+  if (found[0]) {
+    const auto &f = first[0];
+    auto gain = sysid::tune(f, lambda);
+    printf("// 並進: K %.4g (m/s)/V (逆起電圧定数から %.4g)\n", f.gain, expected);
+    printf("constexpr float MOTOR_TIME_CONSTANT = %.4gf;\n", f.time_constant);
+    printf("constexpr float MOTOR_FRICTION_VOLTAGE = %.4gf;\n", f.friction);
+    printf("constexpr float VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {%.4gf, %.4gf, 0.0f};\n", gain.kp, gain.ki);
+    if (second[0].gain > 0.0) {
+      auto pid = sysid::tune(second[0], lambda);
+      printf("// 2次遅れから: {%.4gf, %.4gf, %.4gf}\n", pid.kp, pid.ki, pid.kd);
+    }
+  }
+  if (found[1]) {
+    const auto &f = first[1];
+    auto gain = sysid::tune(f, lambda);
+    printf("// 旋回: K %.4g (rad/s)/V (逆起電圧定数とトレッドから %.4g)\n", f.gain,
+           expected * 2000.0 / static_cast<double>(TREAD_WIDTH));
+    printf("constexpr float MOTOR_ANGULAR_TIME_CONSTANT = %.4gf;\n", f.time_constant);
+    printf("constexpr float ANGULAR_VELOCITY_PID_GAIN[NUM_PARAMETER_PID] = {%.4gf, %.4gf, 0.0f};\n", gain.kp, gain.ki);
+    if (second[1].gain > 0.0) {
+      auto pid = sysid::tune(second[1], lambda);
+      printf("// 2次遅れから: {%.4gf, %.4gf, %.4gf}\n", pid.kp, pid.ki, pid.kd);
+    }
+  }
+  return 0;
+}
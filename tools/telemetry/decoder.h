@@ -0,0 +1,68 @@
+#pragma once
+
+// C++
+#include <cstdint>
+#include <cstdio>
+
+// POSIX
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Project
+#include "../../main/telemetry.h"
+
+namespace telemetry {
+/**
+ * @brief シリアルポートを生のバイト列を受け取る設定にする
+ * @param fd シリアルポート (ptyも可)
+ * @param baud_rate ボーレート [bps] (ptyでは無視される)
+ * @return 成功した場合はtrue
+ */
+inline bool configure(int fd, uint32_t baud_rate) {
+  termios tty{};
+  if (tcgetattr(fd, &tty) != 0) return false;
+  cfmakeraw(&tty);
+  tty.c_cc[VMIN] = 1;
+  tty.c_cc[VTIME] = 0;
+  speed_t speed = B115200;
+  switch (baud_rate) {
+    case 115200:
+      speed = B115200;
+      break;
+    case 921600:
+      speed = B921600;
+      break;
+#ifdef B2000000
+    case 2000000:
+      speed = B2000000;
+      break;
+#endif
+    default:
+      break;
+  }
+  cfsetispeed(&tty, speed);
+  cfsetospeed(&tty, speed);
+  return tcsetattr(fd, TCSANOW, &tty) == 0;
+}
+
+/**
+ * @brief 受信したバイト列を復号してCSVに書き出す
+ * @param fd 入力
+ * @param decoder 復号器 (呼び出しをまたいで状態を保つ)
+ * @param out CSVの出力先
+ * @return 読み出せなくなった (EOF・エラー) 場合はfalse
+ */
+inline bool pump(int fd, Decoder &decoder, FILE *out) {
+  uint8_t buffer[4096];
+  auto size = read(fd, buffer, sizeof(buffer));
+  if (size <= 0) return false;
+  TelemetryFrame frame{};
+  for (ssize_t i = 0; i < size; i++) {
+    if (decoder.update(buffer[i], frame)) {
+      print_csv(out, frame);
+    }
+  }
+  return true;
+}
+}  // namespace telemetry
@@ -0,0 +1,42 @@
+// テレメトリ受信ツール
+// 使い方: telemetry-decoder <device> [output.csv] [baud_rate]
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+
+#include "decoder.h"
+
+static volatile std::sig_atomic_t running = 1;
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <device> [output.csv] [baud_rate]\n", argv[0]);
+    return 1;
+  }
+  auto fd = open(argv[1], O_RDONLY | O_NOCTTY);
+  if (fd < 0) {
+    perror(argv[1]);
+    return 1;
+  }
+  auto baud_rate = argc > 3 ? static_cast<uint32_t>(std::strtoul(argv[3], nullptr, 10)) : 2'000'000;
+  if (!telemetry::configure(fd, baud_rate)) {
+    fprintf(stderr, "%s: not a serial port, reading as a file\n", argv[1]);
+  }
+  auto out = argc > 2 ? fopen(argv[2], "w") : stdout;
+  if (out == nullptr) {
+    perror(argv[2]);
+    return 1;
+  }
+
+  std::signal(SIGINT, [](int) { running = 0; });
+  telemetry::Decoder decoder;
+  telemetry::print_csv_header(out);
+  while (running && telemetry::pump(fd, decoder, out)) {
+  }
+
+  fprintf(stderr, "%u frames, %u errors, %u lost\n", decoder.frames(), decoder.errors(), decoder.lost());
+  if (out != stdout) fclose(out);
+  close(fd);
+  return 0;
+}